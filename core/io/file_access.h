@@ -110,6 +110,9 @@ public:
 	virtual real_t get_real() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+	// Returns the next p_length bytes without copying them and moves past them, or nullptr (leaving
+	// the position unchanged) if the file can't provide views. Views are valid while the file is open.
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, const uint8_t *p_mapped_data) {
 	PathMD5 pmd5(p_path.md5_buffer());
 
 	bool exists = files.has(pmd5);
@@ -61,6 +62,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.mapped_data = p_mapped_data;
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
@@ -126,6 +128,30 @@ PackedData::~PackedData() {
 
 //////////////////////////////////////////////////////////////////
 
+const uint8_t *PackedSourcePCK::_map_pack(const String &p_path) {
+	for (int i = 0; i < mappings.size(); i++) {
+		// Already mapped, e.g. when loading the same pack again to replace files.
+		if (mappings[i].path == p_path) {
+			return mappings[i].data;
+		}
+	}
+
+	String os_path = ProjectSettings::get_singleton() ? ProjectSettings::get_singleton()->globalize_path(p_path) : p_path;
+	if (os_path.begins_with("res://") || os_path.begins_with("user://")) {
+		return nullptr; // Not a file on disk, e.g. a pack stored inside another pack.
+	}
+
+	Mapping mapping;
+	if (OS::get_singleton()->map_file(os_path, mapping.data, mapping.size) != OK) {
+		return nullptr; // Files will be read from the pack through FileAccess instead.
+	}
+	mapping.path = p_path;
+	mappings.push_back(mapping);
+
+	print_verbose(vformat("Memory mapped pack: %s (%d bytes).", p_path, mapping.size));
+	return mapping.data;
+}
+
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	if (f.is_null()) {
@@ -215,6 +241,9 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 	int file_count = f->get_32();
 
+	uint64_t pack_size = f->get_length();
+	const uint8_t *pack_data = _map_pack(p_path);
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -247,7 +276,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		const uint8_t *mapped_data = nullptr;
+		if (pack_data && ofs + p_offset + size <= pack_size) {
+			mapped_data = pack_data + ofs + p_offset;
+		}
+
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), mapped_data);
 	}
 
 	return true;
@@ -257,6 +291,12 @@ Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::Pack
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (int i = 0; i < mappings.size(); i++) {
+		OS::get_singleton()->unmap_file(mappings[i].data, mappings[i].size);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -265,7 +305,9 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -273,7 +315,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -281,7 +323,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -302,18 +346,22 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -326,21 +374,38 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += p_length;
-
 	if (to_read <= 0) {
+		pos += p_length;
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += p_length;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (!data || eof || pos + p_length > pf.size) {
+		return nullptr;
+	}
+
+	const uint8_t *view = data + pos;
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -367,8 +432,17 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (pf.mapped_data && !pf.encrypted) {
+		data = pf.mapped_data;
+		off = 0;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -390,8 +464,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
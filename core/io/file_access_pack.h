@@ -66,6 +66,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		const uint8_t *mapped_data = nullptr; // Contents in the memory mapped pack, if it could be mapped.
 	};
 
 private:
@@ -109,7 +110,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, const uint8_t *p_mapped_data = nullptr); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -135,9 +136,23 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs are mapped in memory when the platform supports it, so their files
+	// can be read without system calls. Mappings live as long as the source.
+	struct Mapping {
+		String path;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+
+	Vector<Mapping> mappings;
+
+	const uint8_t *_map_pack(const String &p_path);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -147,6 +162,8 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	// Either the file is read from the memory mapped pack, or through f.
+	const uint8_t *data = nullptr;
 	Ref<FileAccess> f;
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
@@ -166,6 +183,8 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	// Only available when the pack is memory mapped. Views stay valid after the file is closed.
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const;
 
 	virtual void set_big_endian(bool p_big_endian);
 
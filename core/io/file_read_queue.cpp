@@ -0,0 +1,323 @@
+/*************************************************************************/
+/*  file_read_queue.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "file_read_queue.h"
+
+#include "core/io/file_access.h"
+
+FileReadQueue *FileReadQueue::singleton = nullptr;
+
+FileReadQueue::RequestID FileReadQueue::_request(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_keep_data, Priority p_priority, CompletionCallback p_callback, void *p_userdata) {
+	ERR_FAIL_INDEX_V(p_priority, PRIORITY_MAX, INVALID_REQUEST_ID);
+	if (thread_count == 0) {
+		return INVALID_REQUEST_ID;
+	}
+
+	Request *request = memnew(Request);
+	request->path = p_path;
+	request->offset = p_offset;
+	request->length = p_length;
+	request->keep_data = p_keep_data;
+	request->priority = p_priority;
+	request->callback = p_callback;
+	request->callback_userdata = p_userdata;
+
+	mutex.lock();
+	request->id = ++last_id;
+	request->pending_element = pending[p_priority].push_back(request);
+	requests.insert(request->id, request);
+	mutex.unlock();
+
+	request_semaphore.post();
+
+	return request->id;
+}
+
+FileReadQueue::RequestID FileReadQueue::request_read(const String &p_path, uint64_t p_offset, int64_t p_length, Priority p_priority, CompletionCallback p_callback, void *p_userdata) {
+	return _request(p_path, p_offset, p_length, true, p_priority, p_callback, p_userdata);
+}
+
+FileReadQueue::RequestID FileReadQueue::request_prefetch(const String &p_path, Priority p_priority) {
+	return _request(p_path, 0, -1, false, p_priority, nullptr, nullptr);
+}
+
+FileReadQueue::Status FileReadQueue::get_status(RequestID p_id) const {
+	MutexLock lock(mutex);
+	HashMap<RequestID, Request *>::ConstIterator E = requests.find(p_id);
+	if (!E) {
+		return STATUS_INVALID;
+	}
+	return E->value->status;
+}
+
+void FileReadQueue::set_priority(RequestID p_id, Priority p_priority) {
+	ERR_FAIL_INDEX(p_priority, PRIORITY_MAX);
+
+	MutexLock lock(mutex);
+	HashMap<RequestID, Request *>::Iterator E = requests.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	Request *request = E->value;
+	if (request->status == STATUS_PENDING && request->priority != p_priority) {
+		pending[request->priority].erase(request->pending_element);
+		request->pending_element = pending[p_priority].push_back(request);
+	}
+	request->priority = p_priority;
+}
+
+Error FileReadQueue::wait(RequestID p_id, Vector<uint8_t> *r_data) {
+	mutex.lock();
+	HashMap<RequestID, Request *>::Iterator E = requests.find(p_id);
+	if (!E) {
+		mutex.unlock();
+		ERR_FAIL_V(ERR_INVALID_PARAMETER);
+	}
+
+	Request *request = E->value;
+	if (request->status == STATUS_PENDING && request->priority != PRIORITY_HIGH) {
+		// Someone is blocked on it now, so it goes first.
+		pending[request->priority].erase(request->pending_element);
+		request->pending_element = pending[PRIORITY_HIGH].push_front(request);
+		request->priority = PRIORITY_HIGH;
+	}
+	mutex.unlock();
+
+	// Only the owner can release the request, so it's safe to use unlocked.
+	request->done.wait();
+
+	mutex.lock();
+	requests.erase(p_id);
+	mutex.unlock();
+
+	Error err = request->error;
+	if (r_data) {
+		*r_data = request->data;
+	}
+	memdelete(request);
+
+	return err;
+}
+
+void FileReadQueue::cancel(RequestID p_id) {
+	MutexLock lock(mutex);
+	HashMap<RequestID, Request *>::Iterator E = requests.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	Request *request = E->value;
+	requests.remove(E);
+
+	if (request->status == STATUS_READING) {
+		// The reading thread deletes it once it notices.
+		request->canceled.set();
+		return;
+	}
+
+	if (request->status == STATUS_PENDING) {
+		pending[request->priority].erase(request->pending_element);
+	}
+	memdelete(request);
+}
+
+void FileReadQueue::set_paused(bool p_paused) {
+	mutex.lock();
+	paused = p_paused;
+	int pending_count = 0;
+	if (!paused) {
+		for (int i = 0; i < PRIORITY_MAX; i++) {
+			pending_count += pending[i].size();
+		}
+	}
+	mutex.unlock();
+
+	// Threads woken while paused left their requests queued, wake them up again.
+	for (int i = 0; i < pending_count; i++) {
+		request_semaphore.post();
+	}
+}
+
+bool FileReadQueue::is_paused() const {
+	MutexLock lock(mutex);
+	return paused;
+}
+
+void FileReadQueue::_read(Request *p_request) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_request->path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		p_request->error = err != OK ? err : ERR_FILE_CANT_OPEN;
+		return;
+	}
+
+	uint64_t file_length = f->get_length();
+	if (p_request->offset > file_length) {
+		p_request->error = ERR_FILE_EOF;
+		return;
+	}
+
+	uint64_t length = file_length - p_request->offset;
+	if (p_request->length >= 0 && (uint64_t)p_request->length < length) {
+		length = p_request->length;
+	}
+
+	f->seek(p_request->offset);
+
+	uint8_t *dst = nullptr;
+	if (p_request->keep_data) {
+		if (p_request->data.resize(length) != OK) {
+			p_request->error = ERR_OUT_OF_MEMORY;
+			return;
+		}
+		dst = p_request->data.ptrw();
+	} else {
+		p_request->data.resize(MIN(length, (uint64_t)READ_CHUNK_SIZE));
+	}
+
+	uint64_t read = 0;
+	while (read < length) {
+		if (p_request->canceled.is_set()) {
+			return;
+		}
+
+		uint64_t chunk = MIN(length - read, (uint64_t)READ_CHUNK_SIZE);
+		uint64_t chunk_read = f->get_buffer(dst ? dst + read : p_request->data.ptrw(), chunk);
+		if (chunk_read != chunk) {
+			p_request->error = ERR_FILE_CANT_READ;
+			return;
+		}
+		read += chunk;
+	}
+
+	if (!p_request->keep_data) {
+		p_request->data.clear();
+	}
+}
+
+void FileReadQueue::_thread_function(void *p_user) {
+	FileReadQueue *queue = (FileReadQueue *)p_user;
+
+	while (true) {
+		queue->request_semaphore.wait();
+
+		queue->mutex.lock();
+		if (queue->exit_threads) {
+			queue->mutex.unlock();
+			break;
+		}
+
+		Request *request = nullptr;
+		for (int i = PRIORITY_MAX - 1; i >= 0 && !request && !queue->paused; i--) {
+			if (!queue->pending[i].is_empty()) {
+				request = queue->pending[i].front()->get();
+				queue->pending[i].pop_front();
+			}
+		}
+		if (request) {
+			request->pending_element = nullptr;
+			request->status = STATUS_READING;
+		}
+		queue->mutex.unlock();
+
+		if (!request) {
+			continue; // Canceled before any thread got to it, or paused.
+		}
+
+		queue->_read(request);
+
+		if (request->callback && !request->canceled.is_set()) {
+			// Still reading as far as cancel() is concerned, so the request stays alive.
+			request->callback(request->callback_userdata, request->id, request->error);
+		}
+
+		queue->mutex.lock();
+		if (request->canceled.is_set()) {
+			memdelete(request);
+		} else {
+			request->status = request->error == OK ? STATUS_DONE : STATUS_ERROR;
+			request->done.post();
+		}
+		queue->mutex.unlock();
+	}
+}
+
+void FileReadQueue::init(int p_thread_count) {
+	ERR_FAIL_COND(thread_count > 0);
+
+	thread_count = MAX(p_thread_count, 0);
+	if (thread_count == 0) {
+		return; // Requests are refused, everyone reads synchronously.
+	}
+
+	threads = memnew_arr(Thread, thread_count);
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(&FileReadQueue::_thread_function, this);
+	}
+}
+
+void FileReadQueue::finish() {
+	if (thread_count == 0) {
+		return;
+	}
+
+	mutex.lock();
+	exit_threads = true;
+	mutex.unlock();
+
+	for (int i = 0; i < thread_count; i++) {
+		request_semaphore.post();
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	memdelete_arr(threads);
+	threads = nullptr;
+	thread_count = 0;
+
+	// Nobody is going to claim them anymore.
+	for (KeyValue<RequestID, Request *> &E : requests) {
+		memdelete(E.value);
+	}
+	requests.clear();
+	for (int i = 0; i < PRIORITY_MAX; i++) {
+		pending[i].clear();
+	}
+}
+
+FileReadQueue::FileReadQueue() {
+	if (!singleton) {
+		singleton = this;
+	}
+}
+
+FileReadQueue::~FileReadQueue() {
+	finish();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
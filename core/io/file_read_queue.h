@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  file_read_queue.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef FILE_READ_QUEUE_H
+#define FILE_READ_QUEUE_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/vector.h"
+
+// Reads files on dedicated threads, so whoever needs the data can keep working
+// (e.g. decoding the previous file) in the meantime. Requests are served by
+// priority, then in the order they were made, and can be canceled. Each one
+// belongs to its requester, who has to either wait() for it or cancel() it.
+class FileReadQueue {
+public:
+	enum Priority {
+		PRIORITY_LOW,
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,
+		PRIORITY_MAX
+	};
+
+	enum Status {
+		STATUS_INVALID,
+		STATUS_PENDING,
+		STATUS_READING,
+		STATUS_DONE,
+		STATUS_ERROR,
+	};
+
+	typedef uint64_t RequestID;
+	// Called on the reading thread once a request is read, unless it was canceled.
+	typedef void (*CompletionCallback)(void *p_userdata, RequestID p_id, Error p_error);
+
+	enum {
+		INVALID_REQUEST_ID = 0,
+		READ_CHUNK_SIZE = 1024 * 1024, // Cancellation is checked between chunks.
+	};
+
+private:
+	struct Request {
+		RequestID id = INVALID_REQUEST_ID;
+		String path;
+		uint64_t offset = 0;
+		int64_t length = -1;
+		bool keep_data = true;
+		CompletionCallback callback = nullptr;
+		void *callback_userdata = nullptr;
+
+		Priority priority = PRIORITY_NORMAL;
+		Status status = STATUS_PENDING;
+		List<Request *>::Element *pending_element = nullptr;
+		SafeFlag canceled; // While reading, the request is deleted once done.
+
+		Vector<uint8_t> data;
+		Error error = OK;
+		Semaphore done;
+	};
+
+	static FileReadQueue *singleton;
+
+	Mutex mutex;
+	Semaphore request_semaphore;
+	List<Request *> pending[PRIORITY_MAX];
+	HashMap<RequestID, Request *> requests;
+	RequestID last_id = INVALID_REQUEST_ID;
+
+	Thread *threads = nullptr;
+	int thread_count = 0;
+	bool exit_threads = false;
+	bool paused = false;
+
+	RequestID _request(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_keep_data, Priority p_priority, CompletionCallback p_callback, void *p_userdata);
+	void _read(Request *p_request);
+	static void _thread_function(void *p_user);
+
+public:
+	static FileReadQueue *get_singleton() { return singleton; }
+
+	// A length of -1 reads until the end of the file.
+	RequestID request_read(const String &p_path, uint64_t p_offset = 0, int64_t p_length = -1, Priority p_priority = PRIORITY_NORMAL, CompletionCallback p_callback = nullptr, void *p_userdata = nullptr);
+	// Reads the whole file without keeping the data, only so it's in memory when opened later.
+	RequestID request_prefetch(const String &p_path, Priority p_priority = PRIORITY_LOW);
+
+	Status get_status(RequestID p_id) const;
+	void set_priority(RequestID p_id, Priority p_priority);
+
+	// Both release the request, its ID is invalid afterwards.
+	Error wait(RequestID p_id, Vector<uint8_t> *r_data = nullptr);
+	void cancel(RequestID p_id);
+
+	// While paused, requests stay pending. Reads already started still finish.
+	void set_paused(bool p_paused);
+	bool is_paused() const;
+
+	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
+
+	void init(int p_thread_count);
+	void finish();
+
+	FileReadQueue();
+	~FileReadQueue();
+};
+
+#endif // FILE_READ_QUEUE_H
@@ -33,9 +33,11 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -105,11 +107,22 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+// Copies from a view of the file when it provides one, which saves going
+// through the reads (and system calls) of get_buffer() for large arrays.
+static void read_buffer(uint8_t *dst, Ref<FileAccess> &f, uint64_t length) {
+	const uint8_t *view = f->get_buffer_view(length);
+	if (view) {
+		memcpy(dst, view, length);
+	} else {
+		f->get_buffer(dst, length);
+	}
+}
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if (sizeof(real_t) == 8) {
 			// Ideal case with double-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(double));
+			read_buffer((uint8_t *)dst, f, count * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *dst = (uint64_t *)dst;
@@ -120,8 +133,15 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 #endif
 		} else if (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
+			const uint8_t *view = f->is_big_endian() ? nullptr : f->get_buffer_view(count * sizeof(double));
+			if (view) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_double(view + i * sizeof(double));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_double();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -129,7 +149,7 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	} else {
 		if (sizeof(real_t) == 4) {
 			// Ideal case with float-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(float));
+			read_buffer((uint8_t *)dst, f, count * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *dst = (uint32_t *)dst;
@@ -139,8 +159,15 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
+			const uint8_t *view = f->is_big_endian() ? nullptr : f->get_buffer_view(count * sizeof(float));
+			if (view) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_float(view + i * sizeof(float));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_float();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -447,16 +474,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						if (external_resources[erindex].cache.is_null()) {
 							//cache not here yet, wait for it?
 							if (use_sub_threads) {
-								Error err;
-								external_resources.write[erindex].cache = ResourceLoader::load_threaded_get(external_resources[erindex].path, &err);
-
-								if (err != OK || external_resources[erindex].cache.is_null()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
+								Error err = _resolve_external_resource(erindex);
+								if (err != OK) {
+									return err;
 								}
 							}
 						}
@@ -512,7 +532,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
+			read_buffer(w, f, len);
 			_advance_padding(len);
 
 			r_v = array;
@@ -524,7 +544,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			read_buffer((uint8_t *)w, f, len * sizeof(int32_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -543,7 +563,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			read_buffer((uint8_t *)w, f, len * sizeof(int64_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -562,7 +582,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			read_buffer((uint8_t *)w, f, len * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -581,7 +601,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			read_buffer((uint8_t *)w, f, len * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -640,7 +660,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			read_buffer((uint8_t *)w, f, len * sizeof(float) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -669,6 +689,227 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+Error ResourceLoaderBinary::_resolve_external_resource(int p_index) {
+	Error err;
+	external_resources.write[p_index].cache = ResourceLoader::load_threaded_get(external_resources[p_index].path, &err);
+
+	if (err != OK || external_resources[p_index].cache.is_null()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, external_resources[p_index].path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[p_index].path + ".");
+		}
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::_create_internal_resource(int p_index, IntResourceLoad &r_load) {
+	bool main = p_index == (internal_resources.size() - 1);
+
+	//maybe it is loaded already
+	String path;
+	String id;
+
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				r_load.cached = true;
+				return OK;
+			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
+
+	uint64_t offset = internal_resources[p_index].offset;
+
+	f->seek(offset);
+
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(path);
+		if (cached->get_class() == t) {
+			cached->reset_state();
+			res = cached;
+		}
+	}
+
+	MissingResource *missing_resource = nullptr;
+
+	if (res.is_null()) {
+		//did not replace
+
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				missing_resource = memnew(MissingResource);
+				missing_resource->set_original_class(t);
+				missing_resource->set_recording_properties(true);
+				obj = missing_resource;
+			} else {
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
+			}
+		}
+
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			error = ERR_FILE_CORRUPT;
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+		}
+
+		res = Ref<Resource>(r);
+		if (!path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
+		}
+		r->set_scene_unique_id(id);
+	}
+
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
+
+	r_load.resource = res;
+	r_load.missing_resource = missing_resource;
+	r_load.properties_offset = f->get_position();
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::_decode_properties(IntResourceLoad &r_load) {
+	int pc = f->get_32();
+
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+
+		Variant value;
+
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
+
+		r_load.properties.push_back(Pair<StringName, Variant>(name, value));
+	}
+
+	return OK;
+}
+
+void ResourceLoaderBinary::_decode_properties_task(uint32_t p_index, IntResourceLoad **p_loads) {
+	IntResourceLoad &load = *p_loads[p_index];
+
+	const uint8_t *data = load.properties_view ? load.properties_view : load.properties_data.ptr();
+	uint64_t length = load.properties_view ? load.size : load.properties_data.size();
+
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(data, length);
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
+
+	// Has everything parse_variant() reads, but its own file and buffers. Dependencies
+	// were resolved beforehand, so it doesn't need to wait for any.
+	ResourceLoaderBinary decoder;
+	decoder.f = fa;
+	decoder.ver_format = ver_format;
+	decoder.local_path = local_path;
+	decoder.res_path = res_path;
+	decoder.string_map = string_map;
+	decoder.using_named_scene_ids = using_named_scene_ids;
+	decoder.external_resources = external_resources;
+	decoder.internal_resources = internal_resources;
+	decoder.internal_index_cache = internal_index_cache;
+	decoder.remaps = remaps;
+	decoder.cache_mode = cache_mode;
+
+	load.decode_error = decoder._decode_properties(load);
+	load.properties_data.clear();
+
+	_advance_progress(load.size);
+}
+
+void ResourceLoaderBinary::_apply_properties(IntResourceLoad &r_load) {
+	Ref<Resource> &res = r_load.resource;
+
+	//set properties
+
+	Dictionary missing_resource_properties;
+
+	for (int j = 0; j < r_load.properties.size(); j++) {
+		const StringName &name = r_load.properties[j].first;
+		const Variant &value = r_load.properties[j].second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && r_load.missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
+			}
+		}
+
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
+
+	r_load.properties.clear();
+
+	if (r_load.missing_resource) {
+		r_load.missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
+}
+
+void ResourceLoaderBinary::_advance_progress(uint64_t p_bytes) {
+	// Called from worker threads too, progress is only approximate while they run.
+	uint64_t loaded = loaded_bytes.add(p_bytes);
+	if (progress && total_bytes > 0) {
+		*progress = MIN(loaded / double(total_bytes), 1.0);
+	}
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
@@ -713,154 +954,120 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
-
-		//maybe it is loaded already
-		String path;
-		String id;
-
-		if (!main) {
-			path = internal_resources[i].path;
-
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
-
-				internal_resources.write[i].path = path; // Update path.
-			}
+	// Internal resources are stored one after the other, their sizes are used
+	// to report progress and to pick which ones are worth decoding in parallel.
+	Vector<IntResourceLoad> loads;
+	loads.resize(internal_resources.size());
+	IntResourceLoad *loads_ptr = loads.ptrw();
+	{
+		Vector<uint64_t> offsets;
+		offsets.resize(internal_resources.size());
+		for (int i = 0; i < internal_resources.size(); i++) {
+			offsets.write[i] = internal_resources[i].offset;
+		}
+		offsets.sort();
+
+		uint64_t file_length = f->get_length();
+		for (int i = 0; i < internal_resources.size(); i++) {
+			uint64_t offset = internal_resources[i].offset;
+			int next = offsets.bsearch(offset, false);
+			uint64_t end = next < offsets.size() ? offsets[next] : file_length;
+			loads_ptr[i].size = end > offset ? end - offset : 0;
+			total_bytes += loads_ptr[i].size;
+		}
+	}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+	int parallel_count = 0;
+	if (use_sub_threads) {
+		for (int i = 0; i < loads.size(); i++) {
+			if (loads_ptr[i].size >= PARALLEL_DECODE_MIN_SIZE) {
+				parallel_count++;
 			}
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
-
-		f->seek(offset);
-
-		String t = get_unicode_string();
-
-		Ref<Resource> res;
-
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
-			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
+	bool parallel = parallel_count > 1;
+	if (parallel) {
+		// All resources have to exist before any is decoded, as they can reference
+		// the ones before them. Properties are still set in file order afterwards.
+		for (int i = 0; i < loads.size(); i++) {
+			Error err = _create_internal_resource(i, loads_ptr[i]);
+			if (err != OK) {
+				return err;
 			}
 		}
 
-		MissingResource *missing_resource = nullptr;
-
-		if (res.is_null()) {
-			//did not replace
-
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
+		for (int i = 0; i < external_resources.size(); i++) {
+			if (external_resources[i].cache.is_null()) {
+				Error err = _resolve_external_resource(i);
+				if (err != OK) {
+					return err;
 				}
 			}
+		}
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
-				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+		LocalVector<IntResourceLoad *> decode_loads;
+		for (int i = 0; i < loads.size(); i++) {
+			IntResourceLoad &load = loads_ptr[i];
+			if (load.cached || load.size < PARALLEL_DECODE_MIN_SIZE) {
+				continue;
 			}
 
-			res = Ref<Resource>(r);
-			if (!path.is_empty() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
+			// Reading is done here, only decoding happens on worker threads.
+			uint64_t length = internal_resources[i].offset + load.size - load.properties_offset;
+			f->seek(load.properties_offset);
+			load.properties_view = f->get_buffer_view(length);
+			if (!load.properties_view) {
+				load.properties_data.resize(length);
+				f->get_buffer(load.properties_data.ptrw(), length);
 			}
-			r->set_scene_unique_id(id);
+			load.decoded = true;
+			decode_loads.push_back(&load);
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		if (decode_loads.size()) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_decode_properties_task, decode_loads.ptr(), decode_loads.size(), -1, false, SNAME("ResourceLoaderBinaryDecode"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		}
+	}
 
-		int pc = f->get_32();
-
-		//set properties
-
-		Dictionary missing_resource_properties;
-
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+		IntResourceLoad &load = loads_ptr[i];
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
+		if (!parallel) {
+			Error err = _create_internal_resource(i, load);
+			if (err != OK) {
+				return err;
 			}
+		}
 
-			Variant value;
+		if (load.cached) {
+			_advance_progress(load.size);
+			continue;
+		}
 
-			error = parse_variant(value);
-			if (error) {
+		if (load.decoded) {
+			if (load.decode_error != OK) {
+				error = load.decode_error;
 				return error;
 			}
-
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
-
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
-
-			if (set_valid) {
-				res->set(name, value);
+		} else {
+			f->seek(load.properties_offset);
+			Error err = _decode_properties(load);
+			if (err != OK) {
+				return err;
 			}
+			_advance_progress(load.size);
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
-		}
-
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-		}
-
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
-
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
-		}
+		_apply_properties(load);
 
-		resource_cache.push_back(res);
+		resource_cache.push_back(load.resource);
 
 		if (main) {
 			f.unref();
-			resource = res;
+			resource = load.resource;
 			resource->set_as_translation_remapped(translation_remapped);
 			error = OK;
 			return OK;
@@ -34,6 +34,10 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -77,6 +81,28 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// Internal resources this size or bigger are decoded on the WorkerThreadPool
+	// when loading with sub-threads.
+	static const uint64_t PARALLEL_DECODE_MIN_SIZE = 64 * 1024;
+
+	struct IntResourceLoad {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		bool cached = false; // Nothing to load, it was in the cache already.
+		uint64_t size = 0; // Of its data in the file, used to report progress.
+		uint64_t properties_offset = 0;
+
+		// Properties decoded on a worker thread, from a view of the file or a copy.
+		bool decoded = false;
+		Error decode_error = OK;
+		const uint8_t *properties_view = nullptr;
+		Vector<uint8_t> properties_data;
+		Vector<Pair<StringName, Variant>> properties;
+	};
+
+	uint64_t total_bytes = 0;
+	SafeNumeric<uint64_t> loaded_bytes;
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
@@ -89,6 +115,13 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	Error _resolve_external_resource(int p_index);
+	Error _create_internal_resource(int p_index, IntResourceLoad &r_load);
+	Error _decode_properties(IntResourceLoad &r_load);
+	void _decode_properties_task(uint32_t p_index, IntResourceLoad **p_loads);
+	void _apply_properties(IntResourceLoad &r_load);
+	void _advance_progress(uint64_t p_bytes);
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
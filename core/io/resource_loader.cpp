@@ -202,6 +202,8 @@ void ResourceFormatLoader::_bind_methods() {
 ///////////////////////////////////
 
 Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_RESOURCES);
+
 	bool found = false;
 
 	// Try all loaders and pick the first match for the type hint
@@ -229,13 +231,38 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 	ERR_FAIL_V_MSG(Ref<Resource>(), "No loader found for resource: " + p_path + ".");
 }
 
+static String _get_prefetch_path(const String &p_path) {
+	// Imported resources are loaded from their internal file.
+	String path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(p_path);
+	return path.is_empty() ? p_path : path;
+}
+
 void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
 
 	if (load_task.semaphore) {
 		//this is an actual thread, so wait for Ok from semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
+		if (!thread_load_semaphore->try_wait()) {
+			// Other resources are being loaded, so read this one ahead in the meantime.
+			FileReadQueue *read_queue = FileReadQueue::get_singleton();
+			if (read_queue && read_queue->get_thread_count() > 0) {
+				FileReadQueue::RequestID prefetch_id = read_queue->request_prefetch(_get_prefetch_path(load_task.remapped_path), load_task.prefetch_priority);
+				thread_load_mutex->lock();
+				load_task.prefetch_id = prefetch_id;
+				thread_load_mutex->unlock();
+			}
+
+			thread_load_semaphore->wait(); //wait until its ok to start loading
+
+			// Whatever wasn't read ahead yet is read by the loader itself now.
+			thread_load_mutex->lock();
+			if (load_task.prefetch_id != FileReadQueue::INVALID_REQUEST_ID) {
+				read_queue->cancel(load_task.prefetch_id);
+				load_task.prefetch_id = FileReadQueue::INVALID_REQUEST_ID;
+			}
+			thread_load_mutex->unlock();
+		}
 	}
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
@@ -364,6 +391,8 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 
 		if (!p_source_resource.is_empty()) {
 			thread_load_tasks[p_source_resource].sub_tasks.insert(local_path);
+			// The resource loading it can't finish without it.
+			load_task.prefetch_priority = FileReadQueue::PRIORITY_NORMAL;
 		}
 
 		thread_load_tasks[local_path] = load_task;
@@ -474,6 +503,10 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 
 			thread_suspended_count++;
 
+			if (load_task.prefetch_id != FileReadQueue::INVALID_REQUEST_ID) {
+				FileReadQueue::get_singleton()->set_priority(load_task.prefetch_id, FileReadQueue::PRIORITY_HIGH);
+			}
+
 			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 		}
 
@@ -578,6 +611,10 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 		}
 
 		print_verbose("Loading resource: " + path);
+#ifdef DEBUG_ENABLED
+		// Counts allocations from every thread, so it's only an estimate when loading in parallel.
+		uint64_t allocations = Memory::get_mem_allocation_count();
+#endif
 		float p;
 		Ref<Resource> res = _load(path, local_path, p_type_hint, p_cache_mode, r_error, false, &p);
 
@@ -586,6 +623,10 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 			return Ref<Resource>();
 		}
 
+#ifdef DEBUG_ENABLED
+		print_verbose(vformat("Loaded resource: %s (%d allocations).", path, Memory::get_mem_allocation_count() - allocations));
+#endif
+
 		if (xl_remapped) {
 			res->set_as_translation_remapped(true);
 		}
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/io/file_read_queue.h"
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/script_language.h"
@@ -148,6 +149,9 @@ private:
 		int requests = 0;
 		int poll_requests = 0;
 		HashSet<String> sub_tasks;
+		// Read ahead while waiting for a free loading thread.
+		FileReadQueue::Priority prefetch_priority = FileReadQueue::PRIORITY_LOW;
+		FileReadQueue::RequestID prefetch_id = FileReadQueue::INVALID_REQUEST_ID;
 	};
 
 	static void _thread_load_function(void *p_userdata);
@@ -0,0 +1,852 @@
+/*************************************************************************/
+/*  a_star_compact.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_compact.h"
+
+#include "core/templates/sort_array.h"
+
+// State of the searches running on a thread. It is shared by all the graphs and grids,
+// so the queries don't need to lock anything besides reading the graph.
+struct AStarScratch {
+	struct OpenPoint {
+		real_t f_score = 0;
+		real_t g_score = 0;
+		uint32_t index = 0;
+	};
+
+	struct SortOpenPoints {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the point A is worse than point B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+			}
+		}
+	};
+
+	static constexpr uint32_t NO_POINT = UINT32_MAX;
+
+	LocalVector<real_t> g_scores;
+	LocalVector<uint32_t> prev_points;
+	LocalVector<uint32_t> open_passes;
+	LocalVector<uint32_t> closed_passes;
+	LocalVector<OpenPoint> open_list;
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+	uint32_t pass = 0;
+
+	void begin(uint32_t p_point_count) {
+		if (open_passes.size() < p_point_count) {
+			g_scores.resize(p_point_count);
+			prev_points.resize(p_point_count);
+			uint32_t old_size = open_passes.size();
+			open_passes.resize(p_point_count);
+			closed_passes.resize(p_point_count);
+			for (uint32_t i = old_size; i < p_point_count; i++) {
+				open_passes[i] = 0;
+				closed_passes[i] = 0;
+			}
+		}
+
+		pass++;
+		if (pass == 0) {
+			// The pass counter wrapped around, forget the older passes for real.
+			memset(open_passes.ptr(), 0, open_passes.size() * sizeof(uint32_t));
+			memset(closed_passes.ptr(), 0, closed_passes.size() * sizeof(uint32_t));
+			pass = 1;
+		}
+		open_list.clear();
+	}
+
+	_FORCE_INLINE_ bool is_open(uint32_t p_index) const { return open_passes[p_index] == pass; }
+	_FORCE_INLINE_ bool is_closed(uint32_t p_index) const { return closed_passes[p_index] == pass; }
+	_FORCE_INLINE_ void close(uint32_t p_index) { closed_passes[p_index] = pass; }
+
+	void open(uint32_t p_index, uint32_t p_prev, real_t p_g_score, real_t p_f_score) {
+		open_passes[p_index] = pass;
+		prev_points[p_index] = p_prev;
+		g_scores[p_index] = p_g_score;
+
+		OpenPoint point;
+		point.index = p_index;
+		point.g_score = p_g_score;
+		point.f_score = p_f_score;
+		open_list.push_back(point);
+		sorter.push_heap(0, open_list.size() - 1, 0, point, open_list.ptr());
+	}
+
+	// Points opened again with a better score stay in the open list, the outdated entries are closed by then.
+	bool pop(OpenPoint &r_point) {
+		while (!open_list.is_empty()) {
+			r_point = open_list[0];
+			sorter.pop_heap(0, open_list.size(), open_list.ptr());
+			open_list.resize(open_list.size() - 1);
+			if (!is_closed(r_point.index)) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+static thread_local AStarScratch astar_scratch;
+
+/////////////////////////////////////////////////////////////
+
+bool AStarCompact3D::_get_index(int64_t p_id, uint32_t &r_index) const {
+	HashMap<int64_t, uint32_t>::ConstIterator E = id_to_index.find(p_id);
+	if (!E) {
+		return false;
+	}
+	r_index = E->value;
+	return true;
+}
+
+void AStarCompact3D::create_from(Ref<AStar3D> p_astar) {
+	ERR_FAIL_COND(p_astar.is_null());
+
+	Array point_ids = p_astar->get_point_ids();
+	Vector<int64_t> sorted_ids;
+	sorted_ids.resize(point_ids.size());
+	for (int i = 0; i < point_ids.size(); i++) {
+		sorted_ids.write[i] = point_ids[i];
+	}
+	// Sorted, so the same graph always gets the same indices and the paths are deterministic.
+	sorted_ids.sort();
+
+	RWLockWrite write_lock(lock);
+
+	const uint32_t point_count = sorted_ids.size();
+	ids.resize(point_count);
+	positions.resize(point_count);
+	weight_scales.resize(point_count);
+	enabled.resize(point_count);
+	neighbour_offsets.resize(point_count + 1);
+	neighbours.clear();
+	id_to_index.clear();
+	id_to_index.reserve(point_count);
+
+	for (uint32_t i = 0; i < point_count; i++) {
+		const int64_t id = sorted_ids[i];
+		ids[i] = id;
+		positions[i] = p_astar->get_point_position(id);
+		weight_scales[i] = p_astar->get_point_weight_scale(id);
+		enabled[i] = !p_astar->is_point_disabled(id);
+		id_to_index.insert(id, i);
+	}
+
+	LocalVector<uint32_t> point_neighbours;
+	for (uint32_t i = 0; i < point_count; i++) {
+		neighbour_offsets[i] = neighbours.size();
+
+		Vector<int64_t> connections = p_astar->get_point_connections(ids[i]);
+		point_neighbours.clear();
+		for (int j = 0; j < connections.size(); j++) {
+			point_neighbours.push_back(id_to_index[connections[j]]);
+		}
+		point_neighbours.sort();
+
+		for (uint32_t j = 0; j < point_neighbours.size(); j++) {
+			neighbours.push_back(point_neighbours[j]);
+		}
+	}
+	neighbour_offsets[point_count] = neighbours.size();
+}
+
+void AStarCompact3D::clear() {
+	RWLockWrite write_lock(lock);
+
+	ids.clear();
+	positions.clear();
+	weight_scales.clear();
+	enabled.clear();
+	neighbour_offsets.clear();
+	neighbours.clear();
+	id_to_index.clear();
+}
+
+int64_t AStarCompact3D::get_point_count() const {
+	RWLockRead read_lock(lock);
+	return ids.size();
+}
+
+bool AStarCompact3D::has_point(int64_t p_id) const {
+	RWLockRead read_lock(lock);
+	return id_to_index.has(p_id);
+}
+
+Vector3 AStarCompact3D::get_point_position(int64_t p_id) const {
+	RWLockRead read_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_id, index), Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
+	return positions[index];
+}
+
+Vector<int64_t> AStarCompact3D::get_point_connections(int64_t p_id) const {
+	RWLockRead read_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_id, index), Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
+
+	Vector<int64_t> point_list;
+	for (uint32_t i = neighbour_offsets[index]; i < neighbour_offsets[index + 1]; i++) {
+		point_list.push_back(ids[neighbours[i]]);
+	}
+	return point_list;
+}
+
+void AStarCompact3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
+	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
+	RWLockWrite write_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_MSG(!_get_index(p_id, index), vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
+	weight_scales[index] = p_weight_scale;
+}
+
+real_t AStarCompact3D::get_point_weight_scale(int64_t p_id) const {
+	RWLockRead read_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_id, index), 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
+	return weight_scales[index];
+}
+
+void AStarCompact3D::set_point_disabled(int64_t p_id, bool p_disabled) {
+	RWLockWrite write_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_MSG(!_get_index(p_id, index), vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
+	enabled[index] = !p_disabled;
+}
+
+bool AStarCompact3D::is_point_disabled(int64_t p_id) const {
+	RWLockRead read_lock(lock);
+
+	uint32_t index;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_id, index), false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
+	return !enabled[index];
+}
+
+int64_t AStarCompact3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
+	RWLockRead read_lock(lock);
+
+	int64_t closest_id = -1;
+	real_t closest_dist = 1e20;
+
+	// The points are sorted by id, so the first of several closest points has the lowest id.
+	for (uint32_t i = 0; i < positions.size(); i++) {
+		if (!p_include_disabled && !enabled[i]) {
+			continue; // Disabled points should not be considered.
+		}
+
+		real_t d = p_point.distance_squared_to(positions[i]);
+		if (d < closest_dist) {
+			closest_dist = d;
+			closest_id = ids[i];
+		}
+	}
+
+	return closest_id;
+}
+
+bool AStarCompact3D::_solve(uint32_t p_begin, uint32_t p_end) const {
+	if (!enabled[p_end]) {
+		return false;
+	}
+
+	AStarScratch &scratch = astar_scratch;
+	scratch.begin(ids.size());
+
+	const Vector3 end_position = positions[p_end];
+	scratch.open(p_begin, AStarScratch::NO_POINT, 0, positions[p_begin].distance_to(end_position));
+
+	AStarScratch::OpenPoint p;
+	while (scratch.pop(p)) {
+		if (p.index == p_end) {
+			return true;
+		}
+
+		scratch.close(p.index);
+
+		const Vector3 position = positions[p.index];
+		for (uint32_t i = neighbour_offsets[p.index]; i < neighbour_offsets[p.index + 1]; i++) {
+			const uint32_t e = neighbours[i];
+
+			if (!enabled[e] || scratch.is_closed(e)) {
+				continue;
+			}
+
+			real_t tentative_g_score = p.g_score + position.distance_to(positions[e]) * weight_scales[e];
+			if (scratch.is_open(e) && tentative_g_score >= scratch.g_scores[e]) { // The new path is worse than the previous.
+				continue;
+			}
+
+			scratch.open(e, p.index, tentative_g_score, tentative_g_score + positions[e].distance_to(end_position));
+		}
+	}
+
+	return false;
+}
+
+bool AStarCompact3D::_get_index_path(int64_t p_from_id, int64_t p_to_id, LocalVector<uint32_t> &r_path) const {
+	uint32_t from;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_from_id, from), false, vformat("Can't get path. Point with id: %d doesn't exist.", p_from_id));
+	uint32_t to;
+	ERR_FAIL_COND_V_MSG(!_get_index(p_to_id, to), false, vformat("Can't get path. Point with id: %d doesn't exist.", p_to_id));
+
+	if (from == to) {
+		r_path.push_back(from);
+		return true;
+	}
+
+	if (!_solve(from, to)) {
+		return false;
+	}
+
+	const AStarScratch &scratch = astar_scratch;
+	for (uint32_t p = to; p != AStarScratch::NO_POINT; p = scratch.prev_points[p]) {
+		r_path.push_back(p);
+	}
+	r_path.invert();
+	return true;
+}
+
+Vector<Vector3> AStarCompact3D::get_point_path(int64_t p_from_id, int64_t p_to_id) const {
+	RWLockRead read_lock(lock);
+
+	LocalVector<uint32_t> index_path;
+	if (!_get_index_path(p_from_id, p_to_id, index_path)) {
+		return Vector<Vector3>();
+	}
+
+	Vector<Vector3> path;
+	path.resize(index_path.size());
+	Vector3 *w = path.ptrw();
+	for (uint32_t i = 0; i < index_path.size(); i++) {
+		w[i] = positions[index_path[i]];
+	}
+	return path;
+}
+
+Vector<int64_t> AStarCompact3D::get_id_path(int64_t p_from_id, int64_t p_to_id) const {
+	RWLockRead read_lock(lock);
+
+	LocalVector<uint32_t> index_path;
+	if (!_get_index_path(p_from_id, p_to_id, index_path)) {
+		return Vector<int64_t>();
+	}
+
+	Vector<int64_t> path;
+	path.resize(index_path.size());
+	int64_t *w = path.ptrw();
+	for (uint32_t i = 0; i < index_path.size(); i++) {
+		w[i] = ids[index_path[i]];
+	}
+	return path;
+}
+
+void AStarCompact3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("create_from", "astar"), &AStarCompact3D::create_from);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarCompact3D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_count"), &AStarCompact3D::get_point_count);
+	ClassDB::bind_method(D_METHOD("has_point", "id"), &AStarCompact3D::has_point);
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarCompact3D::get_point_position);
+	ClassDB::bind_method(D_METHOD("get_point_connections", "id"), &AStarCompact3D::get_point_connections);
+
+	ClassDB::bind_method(D_METHOD("set_point_weight_scale", "id", "weight_scale"), &AStarCompact3D::set_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_weight_scale", "id"), &AStarCompact3D::get_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("set_point_disabled", "id", "disabled"), &AStarCompact3D::set_point_disabled, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_disabled", "id"), &AStarCompact3D::is_point_disabled);
+
+	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStarCompact3D::get_closest_point, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarCompact3D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarCompact3D::get_id_path);
+}
+
+/////////////////////////////////////////////////////////////
+
+void AStarGrid2D::set_size(const Vector2i &p_size) {
+	ERR_FAIL_COND_MSG(p_size.x < 0 || p_size.y < 0, vformat("Can't set the grid size to a negative size: %s.", p_size));
+	ERR_FAIL_COND_MSG((int64_t)p_size.x * p_size.y >= AStarScratch::NO_POINT, vformat("Can't set the grid size to more than %d points.", AStarScratch::NO_POINT - 1));
+	RWLockWrite write_lock(lock);
+
+	size = p_size;
+	const uint32_t point_count = size.x * size.y;
+	solid.resize(point_count);
+	weight_scales.resize(point_count);
+	for (uint32_t i = 0; i < point_count; i++) {
+		solid[i] = false;
+		weight_scales[i] = 1.0;
+	}
+}
+
+Vector2i AStarGrid2D::get_size() const {
+	RWLockRead read_lock(lock);
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	RWLockWrite write_lock(lock);
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	RWLockRead read_lock(lock);
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+	RWLockWrite write_lock(lock);
+	cell_size = p_cell_size;
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+	RWLockRead read_lock(lock);
+	return cell_size;
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	RWLockWrite write_lock(lock);
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	RWLockRead read_lock(lock);
+	return jumping_enabled;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+	ERR_FAIL_INDEX(p_heuristic, HEURISTIC_MAX);
+	RWLockWrite write_lock(lock);
+	default_heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+	RWLockRead read_lock(lock);
+	return default_heuristic;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX(p_diagonal_mode, DIAGONAL_MODE_MAX);
+	RWLockWrite write_lock(lock);
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	RWLockRead read_lock(lock);
+	return diagonal_mode;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+	RWLockRead read_lock(lock);
+	return _is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+	RWLockWrite write_lock(lock);
+	ERR_FAIL_COND_MSG(!_is_in_bounds(p_id.x, p_id.y), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	solid[p_id.y * size.x + p_id.x] = p_solid;
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+	RWLockRead read_lock(lock);
+	ERR_FAIL_COND_V_MSG(!_is_in_bounds(p_id.x, p_id.y), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	return solid[p_id.y * size.x + p_id.x];
+}
+
+void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
+	RWLockWrite write_lock(lock);
+	ERR_FAIL_COND_MSG(!_is_in_bounds(p_id.x, p_id.y), vformat("Can't set point's weight scale. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
+	weight_scales[p_id.y * size.x + p_id.x] = p_weight_scale;
+}
+
+real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
+	RWLockRead read_lock(lock);
+	ERR_FAIL_COND_V_MSG(!_is_in_bounds(p_id.x, p_id.y), 0, vformat("Can't get point's weight scale. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	return weight_scales[p_id.y * size.x + p_id.x];
+}
+
+Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
+	RWLockRead read_lock(lock);
+	return offset + Vector2(p_id) * cell_size;
+}
+
+void AStarGrid2D::clear() {
+	RWLockWrite write_lock(lock);
+
+	size = Vector2i();
+	solid.clear();
+	weight_scales.clear();
+}
+
+real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from, const Vector2i &p_to) const {
+	const real_t dx = Math::abs(p_to.x - p_from.x);
+	const real_t dy = Math::abs(p_to.y - p_from.y);
+
+	switch (default_heuristic) {
+		case HEURISTIC_MANHATTAN:
+			return dx + dy;
+		case HEURISTIC_OCTILE: {
+			const real_t f = Math_SQRT2 - 1;
+			return (dx < dy) ? f * dx + dy : f * dy + dx;
+		}
+		case HEURISTIC_CHEBYSHEV:
+			return MAX(dx, dy);
+		default:
+			return Math::sqrt(dx * dx + dy * dy);
+	}
+}
+
+int AStarGrid2D::_get_directions(const Vector2i &p_point, const Vector2i &p_parent, bool p_has_parent, Vector2i *r_directions) const {
+	const int64_t x = p_point.x;
+	const int64_t y = p_point.y;
+	int count = 0;
+
+	if (!p_has_parent || !jumping_enabled) {
+		// All the moves allowed from this point.
+		static const Vector2i directions[8] = {
+			Vector2i(1, 0), Vector2i(-1, 0), Vector2i(0, 1), Vector2i(0, -1),
+			Vector2i(1, 1), Vector2i(-1, 1), Vector2i(1, -1), Vector2i(-1, -1)
+		};
+
+		const int direction_count = diagonal_mode == DIAGONAL_MODE_NEVER ? 4 : 8;
+		for (int i = 0; i < direction_count; i++) {
+			const Vector2i &d = directions[i];
+			if (!_is_walkable(x + d.x, y + d.y)) {
+				continue;
+			}
+			if (d.x != 0 && d.y != 0 && !_can_move_diagonally(x, y, d.x, d.y)) {
+				continue;
+			}
+			r_directions[count++] = d;
+		}
+		return count;
+	}
+
+	// Jump point search: only the natural and forced neighbours in the direction of travel are kept.
+	// The moves returned here are validated by _jump().
+	const int64_t dx = SIGN(x - p_parent.x);
+	const int64_t dy = SIGN(y - p_parent.y);
+
+	if (diagonal_mode == DIAGONAL_MODE_NEVER) {
+		if (dx != 0) {
+			r_directions[count++] = Vector2i(0, -1);
+			r_directions[count++] = Vector2i(0, 1);
+			r_directions[count++] = Vector2i(dx, 0);
+		} else {
+			r_directions[count++] = Vector2i(-1, 0);
+			r_directions[count++] = Vector2i(1, 0);
+			r_directions[count++] = Vector2i(0, dy);
+		}
+	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+		if (dx != 0 && dy != 0) {
+			r_directions[count++] = Vector2i(0, dy);
+			r_directions[count++] = Vector2i(dx, 0);
+			r_directions[count++] = Vector2i(dx, dy);
+		} else if (dx != 0) {
+			r_directions[count++] = Vector2i(dx, 0);
+			r_directions[count++] = Vector2i(dx, 1);
+			r_directions[count++] = Vector2i(dx, -1);
+			r_directions[count++] = Vector2i(0, 1);
+			r_directions[count++] = Vector2i(0, -1);
+		} else {
+			r_directions[count++] = Vector2i(0, dy);
+			r_directions[count++] = Vector2i(1, dy);
+			r_directions[count++] = Vector2i(-1, dy);
+			r_directions[count++] = Vector2i(1, 0);
+			r_directions[count++] = Vector2i(-1, 0);
+		}
+	} else {
+		if (dx != 0 && dy != 0) {
+			r_directions[count++] = Vector2i(0, dy);
+			r_directions[count++] = Vector2i(dx, 0);
+			r_directions[count++] = Vector2i(dx, dy);
+			if (!_is_walkable(x - dx, y)) {
+				r_directions[count++] = Vector2i(-dx, dy);
+			}
+			if (!_is_walkable(x, y - dy)) {
+				r_directions[count++] = Vector2i(dx, -dy);
+			}
+		} else if (dx != 0) {
+			r_directions[count++] = Vector2i(dx, 0);
+			if (!_is_walkable(x, y + 1)) {
+				r_directions[count++] = Vector2i(dx, 1);
+			}
+			if (!_is_walkable(x, y - 1)) {
+				r_directions[count++] = Vector2i(dx, -1);
+			}
+		} else {
+			r_directions[count++] = Vector2i(0, dy);
+			if (!_is_walkable(x + 1, y)) {
+				r_directions[count++] = Vector2i(1, dy);
+			}
+			if (!_is_walkable(x - 1, y)) {
+				r_directions[count++] = Vector2i(-1, dy);
+			}
+		}
+	}
+
+	return count;
+}
+
+bool AStarGrid2D::_jump(const Vector2i &p_from, const Vector2i &p_direction, const Vector2i &p_end, Vector2i &r_jump_point) const {
+	int64_t x = p_from.x;
+	int64_t y = p_from.y;
+	const int64_t dx = p_direction.x;
+	const int64_t dy = p_direction.y;
+	const bool diagonal = dx != 0 && dy != 0;
+
+	// Walk in a straight line until reaching a point with forced neighbours, the end, or an obstacle.
+	// The orthogonal jumps checked on the way don't jump diagonally, so this is nested at most once.
+	while (true) {
+		if (diagonal && !_can_move_diagonally(x, y, dx, dy)) {
+			return false;
+		}
+
+		x += dx;
+		y += dy;
+
+		if (!_is_walkable(x, y)) {
+			return false;
+		}
+
+		r_jump_point = Vector2i(x, y);
+		if (r_jump_point == p_end) {
+			return true;
+		}
+
+		Vector2i unused;
+		if (diagonal_mode == DIAGONAL_MODE_NEVER || diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+			if (dx != 0 && dy == 0) {
+				if ((_is_walkable(x, y - 1) && !_is_walkable(x - dx, y - 1)) || (_is_walkable(x, y + 1) && !_is_walkable(x - dx, y + 1))) {
+					return true;
+				}
+			} else if (dy != 0 && dx == 0) {
+				if ((_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - dy)) || (_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - dy))) {
+					return true;
+				}
+				if (diagonal_mode == DIAGONAL_MODE_NEVER && (_jump(r_jump_point, Vector2i(1, 0), p_end, unused) || _jump(r_jump_point, Vector2i(-1, 0), p_end, unused))) {
+					// Without diagonal moves, the horizontal jump points are found while moving vertically.
+					return true;
+				}
+			}
+		} else {
+			if (diagonal) {
+				if ((_is_walkable(x - dx, y + dy) && !_is_walkable(x - dx, y)) || (_is_walkable(x + dx, y - dy) && !_is_walkable(x, y - dy))) {
+					return true;
+				}
+			} else if (dx != 0) {
+				if ((_is_walkable(x + dx, y + 1) && !_is_walkable(x, y + 1)) || (_is_walkable(x + dx, y - 1) && !_is_walkable(x, y - 1))) {
+					return true;
+				}
+			} else {
+				if ((_is_walkable(x + 1, y + dy) && !_is_walkable(x + 1, y)) || (_is_walkable(x - 1, y + dy) && !_is_walkable(x - 1, y))) {
+					return true;
+				}
+			}
+		}
+
+		if (diagonal && (_jump(r_jump_point, Vector2i(dx, 0), p_end, unused) || _jump(r_jump_point, Vector2i(0, dy), p_end, unused))) {
+			return true;
+		}
+	}
+}
+
+bool AStarGrid2D::_solve(const Vector2i &p_begin, const Vector2i &p_end) const {
+	if (!_is_walkable(p_end.x, p_end.y)) {
+		return false;
+	}
+
+	AStarScratch &scratch = astar_scratch;
+	scratch.begin(size.x * size.y);
+
+	const uint32_t begin_index = p_begin.y * size.x + p_begin.x;
+	const uint32_t end_index = p_end.y * size.x + p_end.x;
+	scratch.open(begin_index, AStarScratch::NO_POINT, 0, _estimate_cost(p_begin, p_end));
+
+	Vector2i directions[8];
+	AStarScratch::OpenPoint p;
+	while (scratch.pop(p)) {
+		if (p.index == end_index) {
+			return true;
+		}
+
+		scratch.close(p.index);
+
+		const Vector2i point = Vector2i(p.index % size.x, p.index / size.x);
+		const uint32_t prev_index = scratch.prev_points[p.index];
+		const bool has_parent = prev_index != AStarScratch::NO_POINT;
+		const Vector2i parent = has_parent ? Vector2i(prev_index % size.x, prev_index / size.x) : point;
+
+		const int direction_count = _get_directions(point, parent, has_parent, directions);
+		for (int i = 0; i < direction_count; i++) {
+			Vector2i next;
+			real_t cost;
+			if (jumping_enabled) {
+				if (!_jump(point, directions[i], p_end, next)) {
+					continue;
+				}
+				cost = Vector2(point).distance_to(Vector2(next));
+			} else {
+				next = point + directions[i];
+				cost = Vector2(directions[i]).length() * weight_scales[next.y * size.x + next.x];
+			}
+
+			const uint32_t e = next.y * size.x + next.x;
+			if (scratch.is_closed(e)) {
+				continue;
+			}
+
+			real_t tentative_g_score = p.g_score + cost;
+			if (scratch.is_open(e) && tentative_g_score >= scratch.g_scores[e]) { // The new path is worse than the previous.
+				continue;
+			}
+
+			scratch.open(e, p.index, tentative_g_score, tentative_g_score + _estimate_cost(next, p_end));
+		}
+	}
+
+	return false;
+}
+
+bool AStarGrid2D::_get_cell_path(const Vector2i &p_from, const Vector2i &p_to, LocalVector<Vector2i> &r_path) const {
+	ERR_FAIL_COND_V_MSG(!_is_in_bounds(p_from.x, p_from.y), false, vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_from.x, size.x, p_from.y, size.y));
+	ERR_FAIL_COND_V_MSG(!_is_in_bounds(p_to.x, p_to.y), false, vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_to.x, size.x, p_to.y, size.y));
+
+	if (p_from == p_to) {
+		r_path.push_back(p_from);
+		return true;
+	}
+
+	if (!_solve(p_from, p_to)) {
+		return false;
+	}
+
+	// Walk back the jump points, filling the straight lines between them.
+	const AStarScratch &scratch = astar_scratch;
+	uint32_t index = p_to.y * size.x + p_to.x;
+	Vector2i point = p_to;
+	r_path.push_back(point);
+	while (scratch.prev_points[index] != AStarScratch::NO_POINT) {
+		index = scratch.prev_points[index];
+		const Vector2i prev = Vector2i(index % size.x, index / size.x);
+		const Vector2i step = Vector2i(SIGN(prev.x - point.x), SIGN(prev.y - point.y));
+		while (point != prev) {
+			point += step;
+			r_path.push_back(point);
+		}
+	}
+	r_path.invert();
+	return true;
+}
+
+Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from, const Vector2i &p_to) const {
+	RWLockRead read_lock(lock);
+
+	LocalVector<Vector2i> cell_path;
+	if (!_get_cell_path(p_from, p_to, cell_path)) {
+		return Vector<Vector2>();
+	}
+
+	Vector<Vector2> path;
+	path.resize(cell_path.size());
+	Vector2 *w = path.ptrw();
+	for (uint32_t i = 0; i < cell_path.size(); i++) {
+		w[i] = offset + Vector2(cell_path[i]) * cell_size;
+	}
+	return path;
+}
+
+TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from, const Vector2i &p_to) const {
+	RWLockRead read_lock(lock);
+
+	TypedArray<Vector2i> path;
+	LocalVector<Vector2i> cell_path;
+	if (!_get_cell_path(p_from, p_to, cell_path)) {
+		return path;
+	}
+
+	path.resize(cell_path.size());
+	for (uint32_t i = 0; i < cell_path.size(); i++) {
+		path[i] = cell_path[i];
+	}
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("set_point_weight_scale", "id", "weight_scale"), &AStarGrid2D::set_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_weight_scale", "id"), &AStarGrid2D::get_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
@@ -0,0 +1,196 @@
+/*************************************************************************/
+/*  a_star_compact.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_COMPACT_H
+#define A_STAR_COMPACT_H
+
+#include "core/math/a_star.h"
+#include "core/os/rw_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+/**
+	A* pathfinding over compact, contiguous representations.
+
+	Unlike AStar3D and AStar2D, the points are stored in flat arrays indexed by
+	32-bit indices, and the state of a search lives in per-thread scratch
+	buffers, so several threads can query the same graph or grid at once.
+	The costs are fixed (no scripted overrides) for the same reason.
+*/
+
+class AStarCompact3D : public RefCounted {
+	GDCLASS(AStarCompact3D, RefCounted);
+
+	LocalVector<int64_t> ids;
+	LocalVector<Vector3> positions;
+	LocalVector<real_t> weight_scales;
+	LocalVector<uint8_t> enabled;
+
+	// Compressed sparse rows: the neighbours of the point i are neighbours[neighbour_offsets[i]] to neighbours[neighbour_offsets[i + 1] - 1].
+	LocalVector<uint32_t> neighbour_offsets;
+	LocalVector<uint32_t> neighbours;
+
+	HashMap<int64_t, uint32_t> id_to_index;
+
+	mutable RWLock lock;
+
+	bool _get_index(int64_t p_id, uint32_t &r_index) const;
+	bool _solve(uint32_t p_begin, uint32_t p_end) const;
+	bool _get_index_path(int64_t p_from_id, int64_t p_to_id, LocalVector<uint32_t> &r_path) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void create_from(Ref<AStar3D> p_astar);
+	void clear();
+
+	int64_t get_point_count() const;
+	bool has_point(int64_t p_id) const;
+	Vector3 get_point_position(int64_t p_id) const;
+	Vector<int64_t> get_point_connections(int64_t p_id) const;
+
+	void set_point_weight_scale(int64_t p_id, real_t p_weight_scale);
+	real_t get_point_weight_scale(int64_t p_id) const;
+	void set_point_disabled(int64_t p_id, bool p_disabled = true);
+	bool is_point_disabled(int64_t p_id) const;
+
+	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
+
+	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id) const;
+	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id) const;
+
+	AStarCompact3D() {}
+};
+
+class AStarGrid2D : public RefCounted {
+	GDCLASS(AStarGrid2D, RefCounted);
+
+public:
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX,
+	};
+
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+private:
+	Vector2i size;
+	Vector2 offset;
+	Vector2 cell_size = Vector2(1, 1);
+
+	bool jumping_enabled = false;
+	Heuristic default_heuristic = HEURISTIC_EUCLIDEAN;
+	DiagonalMode diagonal_mode = DIAGONAL_MODE_ALWAYS;
+
+	LocalVector<uint8_t> solid;
+	LocalVector<real_t> weight_scales;
+
+	mutable RWLock lock;
+
+	_FORCE_INLINE_ bool _is_in_bounds(int64_t p_x, int64_t p_y) const {
+		return p_x >= 0 && p_x < size.x && p_y >= 0 && p_y < size.y;
+	}
+
+	_FORCE_INLINE_ bool _is_walkable(int64_t p_x, int64_t p_y) const {
+		return _is_in_bounds(p_x, p_y) && !solid[p_y * size.x + p_x];
+	}
+
+	_FORCE_INLINE_ bool _can_move_diagonally(int64_t p_x, int64_t p_y, int64_t p_dx, int64_t p_dy) const {
+		switch (diagonal_mode) {
+			case DIAGONAL_MODE_ALWAYS:
+				return true;
+			case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+				return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+			case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES:
+				return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+			default:
+				return false;
+		}
+	}
+
+	real_t _estimate_cost(const Vector2i &p_from, const Vector2i &p_to) const;
+	int _get_directions(const Vector2i &p_point, const Vector2i &p_parent, bool p_has_parent, Vector2i *r_directions) const;
+	bool _jump(const Vector2i &p_from, const Vector2i &p_direction, const Vector2i &p_end, Vector2i &r_jump_point) const;
+	bool _solve(const Vector2i &p_begin, const Vector2i &p_end) const;
+	bool _get_cell_path(const Vector2i &p_from, const Vector2i &p_to, LocalVector<Vector2i> &r_path) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Vector2i &p_size);
+	Vector2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+
+	void set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale);
+	real_t get_point_weight_scale(const Vector2i &p_id) const;
+
+	Vector2 get_point_position(const Vector2i &p_id) const;
+	void clear();
+
+	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to) const;
+	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to) const;
+
+	AStarGrid2D() {}
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic);
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+
+#endif // A_STAR_COMPACT_H
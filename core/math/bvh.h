@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -71,6 +72,14 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// When enabled, the broadphase culls of the items that moved since the last update
+	// are spread over the WorkerThreadPool. The pair / unpair callbacks are still sent
+	// from the calling thread, in the same order as when pairing serially.
+	void params_set_threaded_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_threaded_pairing = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -435,7 +444,11 @@ private:
 			return;
 		}
 
-		BOUNDS bb;
+		if (USE_PAIRS && _threaded_pairing && changed_items.size() >= THREADED_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_threaded(p_full_check);
+			_reset();
+			return;
+		}
 
 		typename BVHTREE_CLASS::CullParams params;
 
@@ -458,30 +471,87 @@ private:
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
-			uint32_t changed_item_ref_id = h.id();
-
 			params.abb = abb;
 
 			params.result_count_overall = 0; // might not be needed
 			tree.cull_aabb(params, false);
 
-			for (unsigned int i = 0; i < tree._cull_hits.size(); i++) {
-				uint32_t ref_id = tree._cull_hits[i];
+			_collide_hits(h, params.hits->ptr(), params.hits->size());
+		}
+		_reset();
+	}
 
-				// don't collide against ourself
-				if (ref_id == changed_item_ref_id) {
-					continue;
-				}
+	// The culls only read the tree, so they are done for batches of changed items on worker
+	// threads, each batch writing to its own hit list. Leavers and new pairs change the
+	// pairing state and send callbacks, so they are then processed here, in order.
+	void _check_for_collisions_threaded(bool p_full_check) {
+		uint32_t num_batches = (changed_items.size() + THREADED_PAIRING_BATCH_SIZE - 1) / THREADED_PAIRING_BATCH_SIZE;
+		if (_pairing_batches.size() < num_batches) {
+			_pairing_batches.resize(num_batches);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_pairing_batch, nullptr, num_batches, -1, true, "BVHPairingCull");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (unsigned int n = 0; n < changed_items.size(); n++) {
+			const BVHHandle &h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, p_full_check);
+
+			const PairingBatch &batch = _pairing_batches[n / THREADED_PAIRING_BATCH_SIZE];
+			uint32_t item = n % THREADED_PAIRING_BATCH_SIZE;
+			uint32_t from = item ? batch.item_ends[item - 1] : 0;
+
+			_collide_hits(h, batch.hits.ptr() + from, batch.item_ends[item] - from);
+		}
+	}
+
+	void _cull_pairing_batch(uint32_t p_batch, void *p_userdata) {
+		PairingBatch &batch = _pairing_batches[p_batch];
+		batch.hits.clear();
+		batch.item_ends.clear();
 
-				// checkmasks is already done in the cull routine.
-				BVHHandle h_collidee;
-				h_collidee.set_id(ref_id);
+		uint32_t from = p_batch * THREADED_PAIRING_BATCH_SIZE;
+		uint32_t to = MIN(from + THREADED_PAIRING_BATCH_SIZE, changed_items.size());
 
-				// find NEW enterers, and send callbacks for them only
-				_collide(h, h_collidee);
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		for (uint32_t n = from; n < to; n++) {
+			const BVHHandle &h = changed_items[n];
+
+			params.abb.from(tree._pairs[h.id()].expanded_aabb);
+			tree.item_fill_cullparams(h, params);
+
+			tree.cull_aabb_to_hits(params, batch.hits);
+			batch.item_ends.push_back(batch.hits.size());
+		}
+	}
+
+	void _collide_hits(BVHHandle p_handle, const uint32_t *p_hits, uint32_t p_num_hits) {
+		uint32_t changed_item_ref_id = p_handle.id();
+
+		for (uint32_t i = 0; i < p_num_hits; i++) {
+			uint32_t ref_id = p_hits[i];
+
+			// don't collide against ourself
+			if (ref_id == changed_item_ref_id) {
+				continue;
 			}
+
+			// checkmasks is already done in the cull routine.
+			BVHHandle h_collidee;
+			h_collidee.set_id(ref_id);
+
+			// find NEW enterers, and send callbacks for them only
+			_collide(p_handle, h_collidee);
 		}
-		_reset();
 	}
 
 public:
@@ -777,6 +847,21 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// below this many changed items, pairing on the calling thread is cheaper
+	// than scheduling worker tasks
+	static const uint32_t THREADED_PAIRING_MIN_ITEMS = 256;
+	static const uint32_t THREADED_PAIRING_BATCH_SIZE = 64;
+
+	struct PairingBatch {
+		LocalVector<uint32_t, uint32_t, true> hits;
+		// end of the hits of each changed item of the batch
+		LocalVector<uint32_t, uint32_t, true> item_ends;
+	};
+
+	// kept between updates to reuse the allocations
+	LocalVector<PairingBatch> _pairing_batches;
+	bool _threaded_pairing = false;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -283,6 +283,7 @@ private:
 	void node_free_node_and_leaf(uint32_t p_node_id) {
 		TNode &node = _nodes[p_node_id];
 		if (node.is_leaf()) {
+			node_clear_dirty(p_node_id);
 			int leaf_id = node.get_leaf_id();
 			_leaves.free(leaf_id);
 		}
@@ -290,6 +291,32 @@ private:
 		_nodes.free(p_node_id);
 	}
 
+	// defer the refit of a leaf until the next update, see refit_dirty_leaves()
+	void node_mark_dirty(uint32_t p_node_id) {
+		TLeaf &leaf = _node_get_leaf(_nodes[p_node_id]);
+		if (!leaf.is_dirty()) {
+			leaf.set_dirty_index(_dirty_leaf_nodes.size());
+			_dirty_leaf_nodes.push_back(p_node_id);
+		}
+	}
+
+	// must be called before the leaf of a dirty node is freed
+	void node_clear_dirty(uint32_t p_node_id) {
+		TLeaf &leaf = _node_get_leaf(_nodes[p_node_id]);
+		if (leaf.is_dirty()) {
+			uint32_t index = leaf.get_dirty_index();
+			BVH_ASSERT(_dirty_leaf_nodes[index] == p_node_id);
+			leaf.set_dirty_index(BVHCommon::INVALID);
+
+			// the last node in the list takes the freed slot
+			uint32_t last_node_id = _dirty_leaf_nodes[_dirty_leaf_nodes.size() - 1];
+			_dirty_leaf_nodes.remove_at_unordered(index);
+			if (last_node_id != p_node_id) {
+				_node_get_leaf(_nodes[last_node_id]).set_dirty_index(index);
+			}
+		}
+	}
+
 	void change_root_node(uint32_t p_new_root_id, uint32_t p_tree_id) {
 		_root_node_id[p_tree_id] = p_new_root_id;
 		TNode &root = _nodes[p_new_root_id];
@@ -364,7 +391,7 @@ private:
 			// This is a VERY EXPENSIVE STEP
 			// we defer the refit updates until the update function is called once per frame
 			if (refit) {
-				leaf.set_dirty(true);
+				node_mark_dirty(owner_node_id);
 			}
 		} else {
 			// remove node if empty
@@ -30,27 +30,120 @@
 
 #include "message_queue.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 
 MessageQueue *MessageQueue::singleton = nullptr;
+std::atomic<uint64_t> MessageQueue::last_instance_id = { 0 };
+
+thread_local MessageQueue::ThreadCache MessageQueue::thread_cache;
+
+MessageQueue::ThreadCache::~ThreadCache() {
+	MessageQueue *queue = singleton;
+	if (buffer && queue && queue->instance_id == instance_id) {
+		buffer->lock.lock();
+		buffer->exited = true;
+		buffer->lock.unlock();
+	}
+}
 
 MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
+MessageQueue::ThreadBuffer *MessageQueue::_get_thread_buffer() {
+	if (likely(thread_cache.instance_id == instance_id)) {
+		return thread_cache.buffer;
+	}
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+
+	registry_mutex.lock();
+	thread_buffers.push_back(buffer);
+	registry_mutex.unlock();
+
+	thread_cache.instance_id = instance_id;
+	thread_cache.buffer = buffer;
+	return buffer;
+}
+
+MessageQueue::Message *MessageQueue::_alloc_message(ThreadBuffer *p_buffer, uint32_t p_size) {
+	// Must be called with the buffer locked.
+	if (unlikely(p_buffer->queued_bytes + p_size > max_queued_bytes)) {
+		return nullptr;
+	}
+
+	Page *page = p_buffer->pages.size() ? p_buffer->pages[p_buffer->pages.size() - 1] : nullptr;
+	if (!page || page->used + p_size > page->capacity) {
+		if (p_size <= PAGE_SIZE && p_buffer->free_pages.size()) {
+			page = p_buffer->free_pages[p_buffer->free_pages.size() - 1];
+			p_buffer->free_pages.resize(p_buffer->free_pages.size() - 1);
+		} else {
+			// Messages with many arguments may not fit in a regular page.
+			uint32_t capacity = MAX(p_size, (uint32_t)PAGE_SIZE);
+			page = memnew_placement(Memory::alloc_static(sizeof(Page) + capacity), Page);
+			page->capacity = capacity;
+		}
+		page->used = 0;
+		p_buffer->pages.push_back(page);
+	}
+
+	Message *msg = memnew_placement(page->get_data() + page->used, Message);
+	msg->sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+
+	page->used += p_size;
+	p_buffer->queued_bytes += p_size;
+	p_buffer->pushed_messages++;
+
+	return msg;
+}
+
+void MessageQueue::_free_page(ThreadBuffer *p_buffer, Page *p_page) {
+	// Must be called with the buffer locked.
+	if (p_page->capacity == PAGE_SIZE && p_buffer->free_pages.size() < MAX_FREE_PAGES) {
+		p_buffer->free_pages.push_back(p_page);
+	} else {
+		Memory::free_static(p_page);
+	}
+}
+
+void MessageQueue::_free_buffer(ThreadBuffer *p_buffer) {
+	for (uint32_t i = 0; i < p_buffer->pages.size(); i++) {
+		Page *page = p_buffer->pages[i];
+		uint32_t read_pos = 0;
+
+		while (read_pos < page->used) {
+			Message *message = (Message *)&page->get_data()[read_pos];
+			read_pos += _get_message_size(message);
+			_destroy_message(message);
+		}
+
+		Memory::free_static(page);
+	}
+
+	for (uint32_t i = 0; i < p_buffer->free_pages.size(); i++) {
+		Memory::free_static(p_buffer->free_pages[i]);
+	}
+
+	memdelete(p_buffer);
+}
+
 Error MessageQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	_THREAD_SAFE_METHOD_
+	ThreadBuffer *buffer = _get_thread_buffer();
+	buffer->lock.lock();
 
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	Message *msg = _alloc_message(buffer, sizeof(Message) + sizeof(Variant));
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (unlikely(!msg)) {
+		buffer->lock.unlock();
 		String type;
 		if (ObjectDB::get_instance(p_id)) {
 			type = ObjectDB::get_instance(p_id)->get_class();
@@ -60,41 +153,39 @@ Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Vari
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
+	Variant *v = memnew_placement(msg + 1, Variant);
 	*v = p_value;
 
+	buffer->lock.unlock();
+
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
+	ThreadBuffer *buffer = _get_thread_buffer();
+	buffer->lock.lock();
+
+	Message *msg = _alloc_message(buffer, sizeof(Message));
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (unlikely(!msg)) {
+		buffer->lock.unlock();
 		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
-
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	buffer->lock.unlock();
 
 	return OK;
 }
@@ -112,17 +203,18 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 }
 
 Error MessageQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
-	_THREAD_SAFE_METHOD_
+	ThreadBuffer *buffer = _get_thread_buffer();
+	buffer->lock.lock();
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	Message *msg = _alloc_message(buffer, sizeof(Message) + sizeof(Variant) * p_argcount);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (unlikely(!msg)) {
+		buffer->lock.unlock();
 		print_line("Failed method: " + p_callable);
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -130,14 +222,14 @@ Error MessageQueue::push_callablep(const Callable &p_callable, const Variant **p
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
+		Variant *v = memnew_placement(&args[i], Variant);
 		*v = *p_args[i];
 	}
 
+	buffer->lock.unlock();
+
 	return OK;
 }
 
@@ -146,56 +238,70 @@ void MessageQueue::statistics() {
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
+	uint64_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	MutexLock registry_lock(registry_mutex);
 
-		Object *target = message->callable.get_object();
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		ThreadBuffer *buffer = thread_buffers[i];
+		buffer->lock.lock();
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (!call_count.has(message->callable)) {
-						call_count[message->callable] = 0;
-					}
+		for (uint32_t j = 0; j < buffer->pages.size(); j++) {
+			Page *page = buffer->pages[j];
+			uint32_t read_pos = 0;
 
-					call_count[message->callable]++;
+			while (read_pos < page->used) {
+				Message *message = (Message *)&page->get_data()[read_pos];
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (!notify_count.has(message->notification)) {
-						notify_count[message->notification] = 0;
-					}
+				Object *target = message->callable.get_object();
 
-					notify_count[message->notification]++;
+				if (target != nullptr) {
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-				} break;
-				case TYPE_SET: {
-					StringName t = message->callable.get_method();
-					if (!set_count.has(t)) {
-						set_count[t] = 0;
-					}
+							call_count[message->callable]++;
 
-					set_count[t]++;
+						} break;
+						case TYPE_NOTIFICATION: {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
 
-				} break;
-			}
+							notify_count[message->notification]++;
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+						} break;
+						case TYPE_SET: {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
 
-			null_count++;
-		}
+							set_count[t]++;
+
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
+
+					null_count++;
+				}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
+				read_pos += _get_message_size(message);
+			}
 		}
+
+		total_bytes += buffer->queued_bytes;
+		print_line("THREAD " + itos(buffer->thread_id) + ": " + itos(buffer->queued_bytes) + " bytes queued, " + itos(buffer->pushed_messages) + " messages pushed");
+
+		buffer->lock.unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -215,6 +321,24 @@ int MessageQueue::get_max_buffer_usage() const {
 	return buffer_max_used;
 }
 
+MessageQueue::FrameStatistics MessageQueue::get_frame_statistics() const {
+	return last_frame_statistics;
+}
+
+void MessageQueue::get_thread_statistics(List<ThreadStatistics> *r_statistics) {
+	MutexLock registry_lock(registry_mutex);
+
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		ThreadBuffer *buffer = thread_buffers[i];
+		ThreadStatistics stats;
+		buffer->lock.lock();
+		stats.thread_id = buffer->thread_id;
+		stats.pushed_messages = buffer->pushed_messages;
+		buffer->lock.unlock();
+		r_statistics->push_back(stats);
+	}
+}
+
 void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
 	const Variant **argptrs = nullptr;
 	if (p_argcount) {
@@ -232,78 +356,178 @@ void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_a
 	}
 }
 
-void MessageQueue::flush() {
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
+void MessageQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+bool MessageQueue::_collect_pages(bool p_trim_idle) {
+	// Takes over the pages of every thread, so their owners keep pushing into fresh pages while these are flushed.
+	flush_sources.clear();
+	flush_pages.clear();
+
+	MutexLock registry_lock(registry_mutex);
+
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		ThreadBuffer *buffer = thread_buffers[i];
+		buffer->lock.lock();
+
+		if (buffer->pages.size()) {
+			FlushSource source;
+			source.buffer = buffer;
+			source.page = flush_pages.size();
+			for (uint32_t j = 0; j < buffer->pages.size(); j++) {
+				flush_pages.push_back(buffer->pages[j]);
+			}
+			source.page_end = flush_pages.size();
+			source.message = (Message *)flush_pages[source.page]->get_data();
+			flush_sources.push_back(source);
+
+			buffer->pages.clear();
+			buffer->queued_bytes = 0;
+		} else if (buffer->exited) {
+			// The thread is gone and its last messages were flushed.
+			buffer->lock.unlock();
+			_free_buffer(buffer);
+			thread_buffers.remove_at_unordered(i);
+			i--;
+			continue;
+		} else if (p_trim_idle) {
+			// Don't keep memory around for threads that stopped pushing messages (or that no longer exist).
+			for (uint32_t j = 0; j < buffer->free_pages.size(); j++) {
+				Memory::free_static(buffer->free_pages[j]);
+			}
+			buffer->free_pages.clear();
+		}
+
+		buffer->lock.unlock();
+	}
+
+	return flush_sources.size() > 0;
+}
+
+void MessageQueue::_advance_source(FlushSource &p_source, uint32_t p_size) {
+	p_source.offset += p_size;
+	if (p_source.offset >= flush_pages[p_source.page]->used) {
+		p_source.page++;
+		p_source.offset = 0;
+	}
+
+	if (p_source.page < p_source.page_end) {
+		p_source.message = (Message *)&flush_pages[p_source.page]->get_data()[p_source.offset];
+	} else {
+		p_source.message = nullptr;
 	}
+}
+
+void MessageQueue::_release_pages() {
+	for (uint32_t i = 0; i < flush_sources.size(); i++) {
+		const FlushSource &source = flush_sources[i];
+		uint32_t page_begin = i == 0 ? 0 : flush_sources[i - 1].page_end;
 
-	uint32_t read_pos = 0;
+		source.buffer->lock.lock();
+		for (uint32_t j = page_begin; j < source.page_end; j++) {
+			_free_page(source.buffer, flush_pages[j]);
+		}
+		source.buffer->lock.unlock();
+	}
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
+	flush_sources.clear();
+	flush_pages.clear();
+}
 
+void MessageQueue::flush() {
+	registry_mutex.lock();
 	if (flushing) {
-		_THREAD_SAFE_UNLOCK_
+		registry_mutex.unlock();
 		ERR_FAIL_COND(flushing); //already flushing, you did something odd
 	}
 	flushing = true;
+	registry_mutex.unlock();
 
-	while (read_pos < buffer_end) {
-		//lock on each iteration, so a call can re-add itself to the message queue
+	uint64_t frame = Engine::get_singleton() ? Engine::get_singleton()->get_process_frames() : 0;
+	if (frame != statistics_frame) {
+		last_frame_statistics = frame_statistics;
+		frame_statistics = FrameStatistics();
+		statistics_frame = frame;
+	}
 
-		Message *message = (Message *)&buffer[read_pos];
+	uint64_t flushed_bytes = 0;
+	bool first_pass = true;
+
+	// Messages pushed while flushing land in new pages, which are collected
+	// on the next pass, so a call can re-add itself to the message queue.
+	while (_collect_pages(first_pass)) {
+		first_pass = false;
+
+		while (true) {
+			// Merge the buffers of all threads back into push order.
+			FlushSource *source = nullptr;
+			for (uint32_t i = 0; i < flush_sources.size(); i++) {
+				FlushSource &candidate = flush_sources[i];
+				if (candidate.message && (!source || candidate.message->sequence < source->message->sequence)) {
+					source = &candidate;
+				}
+			}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			if (!source) {
+				break;
+			}
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+			Message *message = source->message;
+			uint32_t size = _get_message_size(message);
+			_advance_source(*source, size);
 
-		_THREAD_SAFE_UNLOCK_
+			flushed_bytes += size;
+			frame_statistics.messages++;
+			frame_statistics.bytes += size;
+			if (source->buffer != main_buffer) {
+				frame_statistics.thread_messages++;
+			}
 
-		Object *target = message->callable.get_object();
+			Object *target = message->callable.get_object();
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					Variant *args = (Variant *)(message + 1);
+			if (target != nullptr) {
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						Variant *args = (Variant *)(message + 1);
 
-					// messages don't expect a return value
+						// messages don't expect a return value
 
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					// messages don't expect a return value
-					target->notification(message->notification);
+					} break;
+					case TYPE_NOTIFICATION: {
+						// messages don't expect a return value
+						target->notification(message->notification);
 
-				} break;
-				case TYPE_SET: {
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->callable.get_method(), *arg);
+					} break;
+					case TYPE_SET: {
+						Variant *arg = (Variant *)(message + 1);
+						// messages don't expect a return value
+						target->set(message->callable.get_method(), *arg);
 
-				} break;
+					} break;
+				}
 			}
-		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
-			}
+			_destroy_message(message);
 		}
 
-		message->~Message();
+		_release_pages();
+	}
 
-		_THREAD_SAFE_LOCK_
+	if (flushed_bytes > buffer_max_used) {
+		buffer_max_used = flushed_bytes;
 	}
 
-	buffer_end = 0; // reset buffer
 	flushing = false;
-	_THREAD_SAFE_UNLOCK_
 }
 
 bool MessageQueue::is_flushing() const {
@@ -313,33 +537,21 @@ bool MessageQueue::is_flushing() const {
 MessageQueue::MessageQueue() {
 	ERR_FAIL_COND_MSG(singleton != nullptr, "A MessageQueue singleton already exists.");
 	singleton = this;
+	instance_id = ++last_instance_id;
 
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	max_queued_bytes = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	max_queued_bytes *= 1024;
+
+	// The thread creating the queue is the one flushing it; register it first.
+	main_buffer = _get_thread_buffer();
 }
 
 MessageQueue::~MessageQueue() {
-	uint32_t read_pos = 0;
-
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++) {
-				args[i].~Variant();
-			}
-		}
-		message->~Message();
+	// Cleared first, so the threads exiting from now on leave their buffers alone.
+	singleton = nullptr;
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
-		}
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		_free_buffer(thread_buffers[i]);
 	}
-
-	singleton = nullptr;
-	memdelete_arr(buffer);
 }
@@ -32,16 +32,22 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
-#include "core/os/thread_safe.h"
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class Object;
 
 class MessageQueue {
-	_THREAD_SAFE_CLASS_
-
 	enum {
-		DEFAULT_QUEUE_SIZE_KB = 4096
+		DEFAULT_QUEUE_SIZE_KB = 4096,
+		PAGE_SIZE = 64 * 1024,
+		MAX_FREE_PAGES = 4,
 	};
 
 	enum {
@@ -55,6 +61,7 @@ class MessageQueue {
 
 	struct Message {
 		Callable callable;
+		uint64_t sequence; // Global push order, used to merge the per-thread buffers when flushing.
 		int16_t type;
 		union {
 			int16_t notification;
@@ -62,17 +69,99 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer = nullptr;
-	uint32_t buffer_end = 0;
-	uint32_t buffer_max_used = 0;
-	uint32_t buffer_size = 0;
+	// Messages are appended to pages, which are allocated on demand and recycled after flushing.
+	struct Page {
+		uint32_t capacity = 0;
+		uint32_t used = 0;
 
-	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
+		_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)(this + 1); }
+	};
+
+	// Every thread pushing messages gets its own buffer, so producers never contend with each other.
+	// The lock is only shared with the flushing thread while it takes the pending pages.
+	struct ThreadBuffer {
+		SpinLock lock;
+		LocalVector<Page *> pages;
+		LocalVector<Page *> free_pages;
+		uint32_t queued_bytes = 0;
+		uint64_t pushed_messages = 0;
+		Thread::ID thread_id = 0;
+		bool exited = false; // Freed by the next flush once all its messages are flushed.
+	};
+
+	// Caches the buffer of the calling thread, and flags it when the thread exits. The instance ID
+	// (rather than a pointer) makes sure a stale buffer is never used if the queue is recreated.
+	struct ThreadCache {
+		uint64_t instance_id = 0;
+		ThreadBuffer *buffer = nullptr;
+
+		~ThreadCache();
+	};
+
+	static thread_local ThreadCache thread_cache;
+
+	struct FlushSource {
+		ThreadBuffer *buffer = nullptr;
+		uint32_t page = 0;
+		uint32_t page_end = 0;
+		uint32_t offset = 0;
+		Message *message = nullptr;
+	};
+
+public:
+	struct FrameStatistics {
+		uint32_t messages = 0;
+		uint64_t bytes = 0;
+		uint32_t thread_messages = 0; // Messages pushed from threads other than the main one.
+	};
 
+	struct ThreadStatistics {
+		Thread::ID thread_id = 0;
+		uint64_t pushed_messages = 0;
+	};
+
+private:
 	static MessageQueue *singleton;
+	static std::atomic<uint64_t> last_instance_id;
+
+	uint64_t instance_id = 0;
+	uint32_t max_queued_bytes = 0;
+	std::atomic<uint64_t> sequence = { 0 };
+
+	Mutex registry_mutex;
+	LocalVector<ThreadBuffer *> thread_buffers;
+	ThreadBuffer *main_buffer = nullptr;
+
+	LocalVector<FlushSource> flush_sources;
+	LocalVector<Page *> flush_pages;
+
+	uint32_t buffer_max_used = 0;
+	uint64_t statistics_frame = 0;
+	FrameStatistics frame_statistics;
+	FrameStatistics last_frame_statistics;
 
 	bool flushing = false;
 
+	ThreadBuffer *_get_thread_buffer();
+	Message *_alloc_message(ThreadBuffer *p_buffer, uint32_t p_size);
+	void _free_page(ThreadBuffer *p_buffer, Page *p_page);
+	void _free_buffer(ThreadBuffer *p_buffer);
+
+	bool _collect_pages(bool p_trim_idle);
+	void _advance_source(FlushSource &p_source, uint32_t p_size);
+	void _release_pages();
+
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		uint32_t size = sizeof(Message);
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			size += sizeof(Variant) * p_message->args;
+		}
+		return size;
+	}
+
+	static void _destroy_message(Message *p_message);
+	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
+
 public:
 	static MessageQueue *get_singleton();
 
@@ -122,6 +211,10 @@ public:
 
 	int get_max_buffer_usage() const;
 
+	// Statistics of the messages flushed during the last complete frame.
+	FrameStatistics get_frame_statistics() const;
+	void get_thread_statistics(List<ThreadStatistics> *r_statistics);
+
 	MessageQueue();
 	~MessageQueue();
 };
@@ -40,52 +40,165 @@ void WorkerThreadPool::Task::free_template_userdata() {
 }
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
+thread_local int32_t WorkerThreadPool::current_thread_index = -1;
 
-void WorkerThreadPool::_process_task_queue() {
-	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
-	task_mutex.unlock();
-	_process_task(task);
+bool WorkerThreadPool::TaskDeque::push(Task *p_task) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= CAPACITY) {
+		return false;
+	}
+	buffer[b & MASK].store(p_task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
 }
 
-void WorkerThreadPool::_process_task(Task *p_task) {
-	bool low_priority = p_task->low_priority;
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
 
-	if (p_task->group) {
-		// Handling a group
-		bool do_post = false;
-		Callable::CallError ce;
-		Variant ret;
-		Variant arg;
-		Variant *argptr = &arg;
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
 
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+	Task *task = buffer[b & MASK].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last element, race against thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::steal(bool &r_contended) {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
 
-			if (work_index >= p_task->group->max) {
-				break;
+	Task *task = buffer[t & MASK].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		// Lost the race against the owner or another thief, the deque may still have work.
+		r_contended = true;
+		return nullptr;
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pick_task(int32_t p_thread_index) {
+	// Own deque first (most recently posted, likely hot in cache), then the shared queue, then steal.
+	if (p_thread_index >= 0) {
+		Task *task = threads[p_thread_index].deque.pop();
+		if (task) {
+			return task;
+		}
+	}
+
+	if (task_queue_size.get() > 0) {
+		task_mutex.lock();
+		SelfList<Task> *first = task_queue.first();
+		if (first) {
+			Task *task = first->self();
+			task_queue.remove(first);
+			task_queue_size.decrement();
+			task_mutex.unlock();
+			return task;
+		}
+		task_mutex.unlock();
+	}
+
+	uint32_t start = p_thread_index >= 0 ? p_thread_index + 1 : 0;
+	bool contended = true;
+	while (contended) {
+		contended = false;
+		for (uint32_t i = 0; i < thread_count; i++) {
+			uint32_t victim = (start + i) % thread_count;
+			if (int32_t(victim) == p_thread_index) {
+				continue;
 			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				arg = work_index;
-				p_task->callable.callp((const Variant **)&argptr, 1, ret, ce);
+			Task *task = threads[victim].deque.steal(contended);
+			if (task) {
+				threads[victim].tasks_stolen_from.increment();
+				if (p_thread_index >= 0) {
+					threads[p_thread_index].tasks_stolen.increment();
+				}
+				return task;
 			}
+		}
+	}
 
-			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+	return nullptr;
+}
 
-			if (completed_amount == p_task->group->max) {
-				do_post = true;
-			}
+bool WorkerThreadPool::_process_task_queue() {
+	Task *task = _pick_task(current_thread_index);
+	if (!task) {
+		// Somebody else got to it first.
+		return false;
+	}
+	if (current_thread_index >= 0) {
+		threads[current_thread_index].tasks_processed.increment();
+	}
+	_process_task(task);
+	return true;
+}
+
+bool WorkerThreadPool::_process_group_elements(Group *p_group) {
+	bool do_post = false;
+	Callable::CallError ce;
+	Variant ret;
+	Variant arg;
+	Variant *argptr = &arg;
+
+	MemoryTagScope memory_tag_scope(p_group->memory_tag);
+
+	while (true) {
+		uint32_t work_index = p_group->index.postincrement();
+
+		if (work_index >= p_group->max) {
+			break;
+		}
+		if (p_group->native_group_func) {
+			p_group->native_group_func(p_group->native_func_userdata, work_index);
+		} else if (p_group->template_userdata) {
+			p_group->template_userdata->callback_indexed(work_index);
+		} else {
+			arg = work_index;
+			p_group->callable.callp((const Variant **)&argptr, 1, ret, ce);
 		}
 
-		if (do_post && p_task->template_userdata) {
-			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
+		// This is the only way to ensure posting is done when all tasks are really complete.
+		uint32_t completed_amount = p_group->completed_index.increment();
+
+		if (completed_amount == p_group->max) {
+			do_post = true;
 		}
+	}
+
+	if (do_post && p_group->template_userdata) {
+		memdelete(p_group->template_userdata); // This is no longer needed at this point, so get rid of it.
+		p_group->template_userdata = nullptr;
+	}
+
+	return do_post;
+}
+
+void WorkerThreadPool::_process_task(Task *p_task) {
+	bool low_priority = p_task->low_priority;
+
+	if (p_task->group) {
+		// Handling a group
+		bool do_post = _process_group_elements(p_task->group);
 
 		if (low_priority && use_native_low_priority_threads) {
 			p_task->completed = true;
@@ -115,6 +228,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			task_mutex.unlock();
 		}
 	} else {
+		MemoryTagScope memory_tag_scope(p_task->memory_tag);
+
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
 		} else if (p_task->template_userdata) {
@@ -138,11 +253,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			Task *low_prio_task = low_priority_task_queue.first()->self();
 			low_priority_task_queue.remove(low_priority_task_queue.first());
 			task_queue.add_last(&low_prio_task->task_elem);
+			task_queue_size.increment();
 			post = true;
 		} else {
 			low_priority_threads_used.decrement();
 		}
-		task_mutex.lock();
+		task_mutex.unlock();
 		if (post) {
 			task_available_semaphore.post();
 		}
@@ -150,6 +266,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	current_thread_index = ((ThreadData *)p_user)->index;
 	while (true) {
 		singleton->task_available_semaphore.wait();
 		if (singleton->exit_threads.is_set()) {
@@ -165,6 +282,15 @@ void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 }
 
 void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
+	if (p_high_priority && current_thread_index >= 0) {
+		// Tasks posted from a pool thread go to its own deque without locking, other threads steal from there.
+		p_task->low_priority = false;
+		if (threads[current_thread_index].deque.push(p_task)) {
+			task_available_semaphore.post();
+			return;
+		}
+	}
+
 	task_mutex.lock();
 	p_task->low_priority = !p_high_priority;
 	if (!p_high_priority && use_native_low_priority_threads) {
@@ -174,6 +300,7 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 
 	} else if (p_high_priority || low_priority_threads_used.get() < max_low_priority_threads) {
 		task_queue.add_last(&p_task->task_elem);
+		task_queue_size.increment();
 		if (!p_high_priority) {
 			low_priority_threads_used.increment();
 		}
@@ -200,6 +327,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->memory_tag = Memory::get_current_tag();
 	tasks.insert(id, task);
 	task_mutex.unlock();
 
@@ -253,9 +381,7 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		task->low_priority_thread->wait_to_finish();
 		native_thread_allocator.free(task->low_priority_thread);
 	} else {
-		int *index = thread_ids.getptr(Thread::get_caller_id());
-
-		if (index) {
+		if (current_thread_index >= 0) {
 			// We are an actual process thread, we must not be blocked so continue processing stuff if available.
 			while (true) {
 				if (task->done_semaphore.try_wait()) {
@@ -264,7 +390,9 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 				}
 				if (task_available_semaphore.try_wait()) {
 					// Solve tasks while they are around.
-					_process_task_queue();
+					if (_process_task_queue()) {
+						threads[current_thread_index].tasks_helped.increment();
+					}
 					continue;
 				}
 				OS::get_singleton()->delay_usec(1); // Microsleep, this could be converted to waiting for multiple objects in supported platforms for a bit more performance.
@@ -283,7 +411,7 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
-		p_tasks = threads.size();
+		p_tasks = thread_count;
 	}
 
 	task_mutex.lock();
@@ -291,6 +419,11 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->callable = p_callable;
+	group->native_group_func = p_func;
+	group->native_func_userdata = p_userdata;
+	group->template_userdata = p_template_userdata;
+	group->memory_tag = Memory::get_current_tag();
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
@@ -301,6 +434,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = 0;
 		if (p_template_userdata) {
 			memdelete(p_template_userdata);
+			group->template_userdata = nullptr;
 		}
 
 	} else {
@@ -308,12 +442,8 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
-			task->native_group_func = p_func;
-			task->native_func_userdata = p_userdata;
 			task->description = p_description;
 			task->group = group;
-			task->callable = p_callable;
-			task->template_userdata = p_template_userdata;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -389,6 +519,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
+		// Help processing the remaining elements instead of just blocking.
+		if (_process_group_elements(group)) {
+			group->done_semaphore.post();
+			group->completed.set_to(true);
+		}
+
 		group->done_semaphore.wait();
 
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
@@ -406,7 +542,7 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 }
 
 void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
-	ERR_FAIL_COND(threads.size() > 0);
+	ERR_FAIL_COND(thread_count > 0);
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
 	}
@@ -419,17 +555,47 @@ void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_pr
 
 	use_native_low_priority_threads = p_use_native_threads_low_priority;
 
-	threads.resize(p_thread_count);
+	thread_count = p_thread_count;
+	threads = memnew_arr(ThreadData, thread_count);
 
-	for (uint32_t i = 0; i < threads.size(); i++) {
+	for (uint32_t i = 0; i < thread_count; i++) {
 		threads[i].index = i;
+	}
+
+	// Start the threads only once all the deques exist, since they steal from each other.
+	for (uint32_t i = 0; i < thread_count; i++) {
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
-		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
 }
 
+WorkerThreadPool::ThreadStats WorkerThreadPool::get_thread_stats(int p_thread) const {
+	ThreadStats stats;
+	ERR_FAIL_INDEX_V(p_thread, (int)thread_count, stats);
+
+	const ThreadData &td = threads[p_thread];
+	stats.queue_depth = td.deque.size();
+	stats.tasks_processed = td.tasks_processed.get();
+	stats.tasks_stolen = td.tasks_stolen.get();
+	stats.tasks_stolen_from = td.tasks_stolen_from.get();
+	stats.tasks_helped = td.tasks_helped.get();
+	return stats;
+}
+
+Dictionary WorkerThreadPool::get_thread_statistics(int p_thread) const {
+	ERR_FAIL_INDEX_V(p_thread, (int)thread_count, Dictionary());
+
+	ThreadStats stats = get_thread_stats(p_thread);
+	Dictionary d;
+	d["queue_depth"] = stats.queue_depth;
+	d["tasks_processed"] = stats.tasks_processed;
+	d["tasks_stolen"] = stats.tasks_stolen;
+	d["tasks_stolen_from"] = stats.tasks_stolen_from;
+	d["tasks_helped"] = stats.tasks_helped;
+	return d;
+}
+
 void WorkerThreadPool::finish() {
-	if (threads.size() == 0) {
+	if (thread_count == 0) {
 		return;
 	}
 
@@ -443,15 +609,17 @@ void WorkerThreadPool::finish() {
 
 	exit_threads.set_to(true);
 
-	for (uint32_t i = 0; i < threads.size(); i++) {
+	for (uint32_t i = 0; i < thread_count; i++) {
 		task_available_semaphore.post();
 	}
 
-	for (uint32_t i = 0; i < threads.size(); i++) {
+	for (uint32_t i = 0; i < thread_count; i++) {
 		threads[i].thread.wait_to_finish();
 	}
 
-	threads.clear();
+	memdelete_arr(threads);
+	threads = nullptr;
+	thread_count = 0;
 }
 
 void WorkerThreadPool::_bind_methods() {
@@ -463,6 +631,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+
+	ClassDB::bind_method(D_METHOD("get_thread_count"), &WorkerThreadPool::get_thread_count);
+	ClassDB::bind_method(D_METHOD("get_thread_statistics", "thread"), &WorkerThreadPool::get_thread_statistics);
+	ClassDB::bind_method(D_METHOD("get_shared_queue_depth"), &WorkerThreadPool::get_shared_queue_depth);
 }
 
 WorkerThreadPool::WorkerThreadPool() {
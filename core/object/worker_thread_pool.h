@@ -40,6 +40,8 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
+
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
 public:
@@ -69,12 +71,17 @@ private:
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
 		TightLocalVector<Task *> low_priority_native_tasks;
+		// Work is stored in the group rather than the tasks, so waiting threads can help process it.
+		Callable callable;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		Memory::Tag memory_tag = Memory::TAG_UNTAGGED; // Of the thread that added the group.
 	};
 
 	struct Task {
 		Callable callable;
 		void (*native_func)(void *) = nullptr;
-		void (*native_group_func)(void *, uint32_t) = nullptr;
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore;
@@ -85,18 +92,47 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		Thread *low_priority_thread = nullptr;
+		Memory::Tag memory_tag = Memory::TAG_UNTAGGED; // Of the thread that added the task.
 
 		void free_template_userdata();
 		Task() :
 				task_elem(this) {}
 	};
 
+	// Chase-Lev work-stealing deque. Only the owner thread pushes and pops (LIFO) at the bottom,
+	// any other thread can steal (FIFO) from the top without taking a lock.
+	struct TaskDeque {
+		enum {
+			CAPACITY = 1024, // Must be a power of two. When full, tasks overflow to the shared queue.
+			MASK = CAPACITY - 1,
+		};
+
+		std::atomic<int64_t> top;
+		std::atomic<int64_t> bottom;
+		std::atomic<Task *> buffer[CAPACITY];
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal(bool &r_contended);
+
+		_FORCE_INLINE_ uint32_t size() const {
+			int64_t s = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+			return s > 0 ? s : 0;
+		}
+
+		TaskDeque() {
+			top.store(0);
+			bottom.store(0);
+		}
+	};
+
 	PagedAllocator<Task> task_allocator;
 	PagedAllocator<Group> group_allocator;
 	PagedAllocator<Thread> native_thread_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
+	SelfList<Task>::List task_queue; // Shared queue, used for tasks posted from outside the pool and deque overflow.
+	SafeNumeric<uint32_t> task_queue_size;
 
 	Mutex task_mutex;
 	Semaphore task_available_semaphore;
@@ -104,12 +140,18 @@ private:
 	struct ThreadData {
 		uint32_t index;
 		Thread thread;
+		TaskDeque deque;
+		SafeNumeric<uint64_t> tasks_processed;
+		SafeNumeric<uint64_t> tasks_stolen;
+		SafeNumeric<uint64_t> tasks_stolen_from;
+		SafeNumeric<uint64_t> tasks_helped; // Processed while waiting for another task.
 	};
 
-	TightLocalVector<ThreadData> threads;
+	ThreadData *threads = nullptr;
+	uint32_t thread_count = 0;
+	static thread_local int32_t current_thread_index; // Index of the pool thread running, or -1.
 	SafeFlag exit_threads;
 
-	HashMap<Thread::ID, int> thread_ids;
 	HashMap<TaskID, Task *> tasks;
 	HashMap<GroupID, Group *> groups;
 
@@ -122,8 +164,10 @@ private:
 	static void _thread_function(void *p_user);
 	static void _native_low_priority_thread_function(void *p_user);
 
-	void _process_task_queue();
+	Task *_pick_task(int32_t p_thread_index);
+	bool _process_task_queue();
 	void _process_task(Task *task);
+	bool _process_group_elements(Group *p_group);
 
 	void _post_task(Task *p_task, bool p_high_priority);
 
@@ -186,7 +230,19 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
-	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
+
+	struct ThreadStats {
+		uint32_t queue_depth = 0;
+		uint64_t tasks_processed = 0;
+		uint64_t tasks_stolen = 0;
+		uint64_t tasks_stolen_from = 0;
+		uint64_t tasks_helped = 0;
+	};
+
+	ThreadStats get_thread_stats(int p_thread) const;
+	Dictionary get_thread_statistics(int p_thread) const;
+	uint32_t get_shared_queue_depth() const { return task_queue_size.get(); }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
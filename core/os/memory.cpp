@@ -31,10 +31,13 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <atomic>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -61,37 +64,213 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::allocation_count;
+SafeNumeric<uint64_t> Memory::alloc_count;
+SafeNumeric<uint64_t> Memory::size_class_allocations[SIZE_CLASS_COUNT];
+SafeNumeric<uint64_t> Memory::size_class_cache_hits[SIZE_CLASS_COUNT];
 #endif
 
-SafeNumeric<uint64_t> Memory::alloc_count;
+static const uint32_t size_class_sizes[Memory::SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+// Size class for each 16 byte step, indexed by (size - 1) / 16.
+static const uint8_t size_class_lookup[Memory::MAX_SMALL_ALLOCATION / 16] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+	12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+	16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+	18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19
+};
+
+static _FORCE_INLINE_ int _get_size_class(size_t p_bytes) {
+	if (p_bytes > Memory::MAX_SMALL_ALLOCATION) {
+		return -1;
+	}
+	return p_bytes == 0 ? 0 : size_class_lookup[(p_bytes - 1) >> 4];
+}
+
+thread_local Memory::Tag Memory::current_tag = Memory::TAG_UNTAGGED;
+
+// Small blocks freed by a thread are kept here and reused by its next allocations
+// of the same size class, so most of them never reach malloc (and its locks).
+// It also holds the tagged usage of the thread, so accounting needs no atomic
+// read-modify-write; the totals are only summed up when requested.
+struct MemoryThreadCache {
+	enum {
+		MAX_CACHED_BLOCKS = 64, // Per size class.
+	};
+
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	FreeBlock *free_lists[Memory::SIZE_CLASS_COUNT] = {};
+	uint32_t free_counts[Memory::SIZE_CLASS_COUNT] = {};
+
+	// Written only by the owning thread, read by any thread summing up the usage.
+	std::atomic<int64_t> tag_bytes[Memory::TAG_MAX];
+	std::atomic<uint64_t> tag_allocations[Memory::TAG_MAX];
+
+	MemoryThreadCache *prev = nullptr;
+	MemoryThreadCache *next = nullptr;
+
+	MemoryThreadCache();
+	~MemoryThreadCache();
+};
+
+static SpinLock thread_caches_lock;
+static MemoryThreadCache *thread_caches = nullptr;
+
+// Usage accounted by threads that already exited.
+static std::atomic<int64_t> retired_tag_bytes[Memory::TAG_MAX];
+static std::atomic<uint64_t> retired_tag_allocations[Memory::TAG_MAX];
+static std::atomic<uint64_t> tag_max_usage[Memory::TAG_MAX];
+
+static const char *tag_names[Memory::TAG_MAX] = {
+	"untagged",
+	"rendering",
+	"physics",
+	"navigation",
+	"audio",
+	"scripts",
+	"resources",
+};
+
+// Allocations can still happen while thread_local objects are being destroyed,
+// at which point they fall back to malloc and free.
+static thread_local bool memory_thread_cache_destroyed = false;
+static thread_local MemoryThreadCache memory_thread_cache;
+
+MemoryThreadCache::MemoryThreadCache() {
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		tag_bytes[i].store(0, std::memory_order_relaxed);
+		tag_allocations[i].store(0, std::memory_order_relaxed);
+	}
+
+	thread_caches_lock.lock();
+	next = thread_caches;
+	if (thread_caches) {
+		thread_caches->prev = this;
+	}
+	thread_caches = this;
+	thread_caches_lock.unlock();
+}
+
+MemoryThreadCache::~MemoryThreadCache() {
+	memory_thread_cache_destroyed = true;
+
+	thread_caches_lock.lock();
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		retired_tag_bytes[i].fetch_add(tag_bytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		retired_tag_allocations[i].fetch_add(tag_allocations[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	if (prev) {
+		prev->next = next;
+	} else {
+		thread_caches = next;
+	}
+	if (next) {
+		next->prev = prev;
+	}
+	thread_caches_lock.unlock();
+
+	for (int i = 0; i < Memory::SIZE_CLASS_COUNT; i++) {
+		while (free_lists[i]) {
+			FreeBlock *block = free_lists[i];
+			free_lists[i] = block->next;
+			free(block);
+		}
+		free_counts[i] = 0;
+	}
+}
+
+static _FORCE_INLINE_ void _account_tag(uint64_t p_tag, int64_t p_bytes, uint64_t p_allocations) {
+	if (likely(!memory_thread_cache_destroyed)) {
+		MemoryThreadCache &cache = memory_thread_cache;
+		cache.tag_bytes[p_tag].store(cache.tag_bytes[p_tag].load(std::memory_order_relaxed) + p_bytes, std::memory_order_relaxed);
+		if (p_allocations) {
+			cache.tag_allocations[p_tag].store(cache.tag_allocations[p_tag].load(std::memory_order_relaxed) + p_allocations, std::memory_order_relaxed);
+		}
+	} else {
+		retired_tag_bytes[p_tag].fetch_add(p_bytes, std::memory_order_relaxed);
+		retired_tag_allocations[p_tag].fetch_add(p_allocations, std::memory_order_relaxed);
+	}
+}
+
+static _FORCE_INLINE_ void *_alloc_block(int p_size_class, bool &r_cache_hit) {
+	if (likely(!memory_thread_cache_destroyed)) {
+		MemoryThreadCache &cache = memory_thread_cache;
+		MemoryThreadCache::FreeBlock *block = cache.free_lists[p_size_class];
+		if (block) {
+			cache.free_lists[p_size_class] = block->next;
+			cache.free_counts[p_size_class]--;
+			r_cache_hit = true;
+			return block;
+		}
+	}
+
+	r_cache_hit = false;
+	return malloc(size_class_sizes[p_size_class] + PAD_ALIGN);
+}
+
+static _FORCE_INLINE_ void _free_block(void *p_block, int p_size_class) {
+	if (likely(!memory_thread_cache_destroyed)) {
+		MemoryThreadCache &cache = memory_thread_cache;
+		if (cache.free_counts[p_size_class] < MemoryThreadCache::MAX_CACHED_BLOCKS) {
+			MemoryThreadCache::FreeBlock *block = (MemoryThreadCache::FreeBlock *)p_block;
+			block->next = cache.free_lists[p_size_class];
+			cache.free_lists[p_size_class] = block;
+			cache.free_counts[p_size_class]++;
+			return;
+		}
+	}
+
+	free(p_block);
+}
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	return _alloc(p_bytes, current_tag);
+}
+
+// Every allocation is prefixed by a header holding its size, which tells
+// free_static() and realloc_static() the size class of the block, and its tag.
+void *Memory::_alloc(size_t p_bytes, Tag p_tag) {
+	int size_class = _get_size_class(p_bytes);
+
+	void *mem;
+	if (size_class >= 0) {
+		bool cache_hit;
+		mem = _alloc_block(size_class, cache_hit);
 #ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
+		size_class_allocations[size_class].increment();
+		if (cache_hit) {
+			size_class_cache_hits[size_class].increment();
+		}
 #endif
-
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	} else {
+		mem = malloc(p_bytes + PAD_ALIGN);
+	}
 
 	ERR_FAIL_COND_V(!mem, nullptr);
 
-	alloc_count.increment();
+	uint64_t *s = (uint64_t *)mem;
+	s[0] = p_bytes;
+	s[1] = p_tag;
 
-	if (prepad) {
-		uint64_t *s = (uint64_t *)mem;
-		*s = p_bytes;
+	_account_tag(p_tag, p_bytes, 1);
 
-		uint8_t *s8 = (uint8_t *)mem;
+	uint8_t *s8 = (uint8_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
+	alloc_count.increment();
+	uint64_t new_mem_usage = mem_usage.add(p_bytes);
+	max_usage.exchange_if_greater(new_mem_usage);
+	allocation_count.increment();
 #endif
-		return s8 + PAD_ALIGN;
-	} else {
-		return mem;
-	}
+	return s8 + PAD_ALIGN;
 }
 
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
@@ -99,76 +278,131 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		return alloc_static(p_bytes, p_pad_align);
 	}
 
-	uint8_t *mem = (uint8_t *)p_memory;
+	if (p_bytes == 0) {
+		free_static(p_memory, p_pad_align);
+		return nullptr;
+	}
+
+	uint8_t *mem = (uint8_t *)p_memory - PAD_ALIGN;
+	uint64_t *s = (uint64_t *)mem;
+	const uint64_t old_bytes = s[0];
+	const uint64_t tag = s[1];
+
+	const int old_size_class = _get_size_class(old_bytes);
+	const int new_size_class = _get_size_class(p_bytes);
+
+	if (old_size_class != new_size_class) {
+		// Moving between size classes (or in and out of them) needs a new block.
+		// It stays accounted to the subsystem that made the original allocation.
+		void *new_memory = _alloc(p_bytes, (Tag)tag);
+		ERR_FAIL_COND_V(!new_memory, nullptr);
+		memcpy(new_memory, p_memory, MIN(old_bytes, (uint64_t)p_bytes));
+		free_static(p_memory, p_pad_align);
+		return new_memory;
+	}
+
+	_account_tag(tag, (int64_t)p_bytes - (int64_t)old_bytes, 0);
 
 #ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
+	if (p_bytes > old_bytes) {
+		uint64_t new_mem_usage = mem_usage.add(p_bytes - old_bytes);
+		max_usage.exchange_if_greater(new_mem_usage);
+	} else {
+		mem_usage.sub(old_bytes - p_bytes);
+	}
+	allocation_count.increment();
 #endif
 
-	if (prepad) {
-		mem -= PAD_ALIGN;
-		uint64_t *s = (uint64_t *)mem;
+	if (old_size_class >= 0) {
+		// The block already has room for any size in its class.
+		s[0] = p_bytes;
+		return p_memory;
+	}
+
+	mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+	ERR_FAIL_COND_V(!mem, nullptr);
+
+	s = (uint64_t *)mem;
+	s[0] = p_bytes;
+
+	return mem + PAD_ALIGN;
+}
+
+void Memory::free_static(void *p_ptr, bool p_pad_align) {
+	ERR_FAIL_COND(p_ptr == nullptr);
+
+	uint8_t *mem = (uint8_t *)p_ptr - PAD_ALIGN;
+	uint64_t *s = (uint64_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
-		}
+	alloc_count.decrement();
+	mem_usage.sub(s[0]);
 #endif
 
-		if (p_bytes == 0) {
-			free(mem);
-			return nullptr;
-		} else {
-			*s = p_bytes;
+	_account_tag(s[1], -(int64_t)s[0], 0);
 
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
-			ERR_FAIL_COND_V(!mem, nullptr);
+	int size_class = _get_size_class(s[0]);
+	if (size_class >= 0) {
+		_free_block(mem, size_class);
+	} else {
+		free(mem);
+	}
+}
 
-			s = (uint64_t *)mem;
+const char *Memory::get_tag_name(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return tag_names[p_tag];
+}
 
-			*s = p_bytes;
+uint64_t Memory::get_tag_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
 
-			return mem + PAD_ALIGN;
-		}
-	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+	// Memory freed by a thread other than the one that allocated it makes the
+	// per-thread values go negative, but they add up correctly.
+	int64_t usage = retired_tag_bytes[p_tag].load(std::memory_order_relaxed);
+	thread_caches_lock.lock();
+	for (MemoryThreadCache *cache = thread_caches; cache; cache = cache->next) {
+		usage += cache->tag_bytes[p_tag].load(std::memory_order_relaxed);
+	}
+	thread_caches_lock.unlock();
 
-		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
+	uint64_t result = MAX(usage, (int64_t)0);
 
-		return mem;
+	uint64_t max_usage = tag_max_usage[p_tag].load(std::memory_order_relaxed);
+	while (result > max_usage && !tag_max_usage[p_tag].compare_exchange_weak(max_usage, result, std::memory_order_relaxed)) {
+		// Retry.
 	}
-}
 
-void Memory::free_static(void *p_ptr, bool p_pad_align) {
-	ERR_FAIL_COND(p_ptr == nullptr);
+	return result;
+}
 
-	uint8_t *mem = (uint8_t *)p_ptr;
+uint64_t Memory::get_tag_max_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+	return tag_max_usage[p_tag].load(std::memory_order_relaxed);
+}
 
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
-#endif
+uint64_t Memory::get_tag_allocation_count(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
 
-	alloc_count.decrement();
+	uint64_t count = retired_tag_allocations[p_tag].load(std::memory_order_relaxed);
+	thread_caches_lock.lock();
+	for (MemoryThreadCache *cache = thread_caches; cache; cache = cache->next) {
+		count += cache->tag_allocations[p_tag].load(std::memory_order_relaxed);
+	}
+	thread_caches_lock.unlock();
 
-	if (prepad) {
-		mem -= PAD_ALIGN;
+	return count;
+}
 
+Memory::SizeClassStatistics Memory::get_size_class_statistics(int p_size_class) {
+	SizeClassStatistics stats;
+	ERR_FAIL_INDEX_V(p_size_class, SIZE_CLASS_COUNT, stats);
+	stats.size = size_class_sizes[p_size_class];
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)mem;
-		mem_usage.sub(*s);
+	stats.allocations = size_class_allocations[p_size_class].get();
+	stats.cache_hits = size_class_cache_hits[p_size_class].get();
 #endif
-
-		free(mem);
-	} else {
-		free(mem);
-	}
+	return stats;
 }
 
 uint64_t Memory::get_mem_available() {
@@ -191,6 +425,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_mem_allocation_count() {
+#ifdef DEBUG_ENABLED
+	return allocation_count.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
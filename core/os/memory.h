@@ -42,12 +42,44 @@
 #endif
 
 class Memory {
+public:
+	enum {
+		SIZE_CLASS_COUNT = 20,
+		MAX_SMALL_ALLOCATION = 1024, // Larger allocations go straight to the system allocator.
+	};
+
+	struct SizeClassStatistics {
+		uint64_t size = 0;
+		uint64_t allocations = 0;
+		uint64_t cache_hits = 0;
+	};
+
+	// Subsystem an allocation is accounted to, taken from the innermost MemoryTagScope
+	// of the allocating thread. Tagged usage is tracked in all builds.
+	enum Tag {
+		TAG_UNTAGGED,
+		TAG_RENDERING,
+		TAG_PHYSICS,
+		TAG_NAVIGATION,
+		TAG_AUDIO,
+		TAG_SCRIPTS,
+		TAG_RESOURCES,
+		TAG_MAX
+	};
+
+private:
+	static thread_local Tag current_tag;
+
+	static void *_alloc(size_t p_bytes, Tag p_tag);
+
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
-#endif
-
+	static SafeNumeric<uint64_t> allocation_count;
 	static SafeNumeric<uint64_t> alloc_count;
+	static SafeNumeric<uint64_t> size_class_allocations[SIZE_CLASS_COUNT];
+	static SafeNumeric<uint64_t> size_class_cache_hits[SIZE_CLASS_COUNT];
+#endif
 
 public:
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
@@ -57,6 +89,31 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_mem_allocation_count(); // Allocations and reallocations so far, only tracked in debug builds.
+
+	// Allocations and thread cache hits are only tracked in debug builds.
+	static SizeClassStatistics get_size_class_statistics(int p_size_class);
+
+	_FORCE_INLINE_ static Tag get_current_tag() { return current_tag; }
+	_FORCE_INLINE_ static void set_current_tag(Tag p_tag) { current_tag = p_tag; }
+
+	static const char *get_tag_name(Tag p_tag);
+	static uint64_t get_tag_usage(Tag p_tag);
+	static uint64_t get_tag_max_usage(Tag p_tag); // Highest usage returned by get_tag_usage() so far.
+	static uint64_t get_tag_allocation_count(Tag p_tag);
+};
+
+class MemoryTagScope {
+	Memory::Tag previous_tag;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(Memory::Tag p_tag) {
+		previous_tag = Memory::get_current_tag();
+		Memory::set_current_tag(p_tag);
+	}
+	_FORCE_INLINE_ ~MemoryTagScope() {
+		Memory::set_current_tag(previous_tag);
+	}
 };
 
 class DefaultAllocator {
@@ -45,6 +45,7 @@
 #include "core/input/shortcut.h"
 #include "core/io/config_file.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_read_queue.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
@@ -64,6 +65,7 @@
 #include "core/io/udp_server.h"
 #include "core/io/xml_parser.h"
 #include "core/math/a_star.h"
+#include "core/math/a_star_compact.h"
 #include "core/math/expression.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
@@ -101,6 +103,7 @@ static core_bind::Geometry2D *_geometry_2d = nullptr;
 static core_bind::Geometry3D *_geometry_3d = nullptr;
 
 static WorkerThreadPool *worker_thread_pool = nullptr;
+static FileReadQueue *file_read_queue = nullptr;
 
 extern Mutex _global_mutex;
 
@@ -236,6 +239,8 @@ void register_core_types() {
 	GDREGISTER_ABSTRACT_CLASS(PackedDataContainerRef);
 	GDREGISTER_CLASS(AStar3D);
 	GDREGISTER_CLASS(AStar2D);
+	GDREGISTER_CLASS(AStarCompact3D);
+	GDREGISTER_CLASS(AStarGrid2D);
 	GDREGISTER_CLASS(EncodedObjectAsID);
 	GDREGISTER_CLASS(RandomNumberGenerator);
 
@@ -273,6 +278,7 @@ void register_core_types() {
 	GDREGISTER_NATIVE_STRUCT(ScriptLanguageExtensionProfilingInfo, "StringName signature;uint64_t call_count;uint64_t total_time;uint64_t self_time");
 
 	worker_thread_pool = memnew(WorkerThreadPool);
+	file_read_queue = memnew(FileReadQueue);
 }
 
 void register_core_settings() {
@@ -293,6 +299,10 @@ void register_core_settings() {
 	} else {
 		worker_thread_pool->init(worker_threads, low_priority_use_system_threads, low_property_ratio);
 	}
+
+	int file_read_threads = GLOBAL_DEF("threading/file_read_queue/max_threads", 2);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/file_read_queue/max_threads", PropertyInfo(Variant::INT, "threading/file_read_queue/max_threads", PROPERTY_HINT_RANGE, "0,16,1"));
+	file_read_queue->init(file_read_threads);
 }
 
 void register_core_singletons() {
@@ -362,6 +372,7 @@ void unregister_core_types() {
 	memdelete(_geometry_2d);
 	memdelete(_geometry_3d);
 
+	memdelete(file_read_queue);
 	memdelete(worker_thread_pool);
 
 	ResourceLoader::remove_resource_format_loader(resource_format_image);
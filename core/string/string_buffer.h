@@ -66,9 +66,14 @@ public:
 	}
 
 	StringBuffer &reserve(int p_size);
+	StringBuffer &truncate(int p_length);
 
 	int length() const;
 
+	_FORCE_INLINE_ const char32_t *ptr() {
+		return current_buffer_ptr();
+	}
+
 	String as_string();
 
 	double as_double();
@@ -131,6 +136,13 @@ StringBuffer<SHORT_BUFFER_SIZE> &StringBuffer<SHORT_BUFFER_SIZE>::reserve(int p_
 	return *this;
 }
 
+template <int SHORT_BUFFER_SIZE>
+StringBuffer<SHORT_BUFFER_SIZE> &StringBuffer<SHORT_BUFFER_SIZE>::truncate(int p_length) {
+	ERR_FAIL_INDEX_V(p_length, string_length + 1, *this);
+	string_length = p_length;
+	return *this;
+}
+
 template <int SHORT_BUFFER_SIZE>
 int StringBuffer<SHORT_BUFFER_SIZE>::length() const {
 	return string_length;
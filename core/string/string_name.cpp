@@ -39,14 +39,13 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StringName::_Stripe StringName::_stripes[STRING_TABLE_STRIPES];
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
 }
 
 bool StringName::configured = false;
-Mutex StringName::mutex;
 
 #ifdef DEBUG_ENABLED
 bool StringName::debug_stringname = false;
@@ -54,23 +53,30 @@ bool StringName::debug_stringname = false;
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+	for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+		_Stripe &stripe = _stripes[i];
+		stripe.buckets = memnew_arr(_Data *, STRING_TABLE_MIN_BUCKETS);
+		for (int j = 0; j < STRING_TABLE_MIN_BUCKETS; j++) {
+			stripe.buckets[j] = nullptr;
+		}
+		stripe.bucket_mask = STRING_TABLE_MIN_BUCKETS - 1;
+		stripe.count = 0;
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+			const _Stripe &stripe = _stripes[i];
+			for (uint32_t j = 0; j <= stripe.bucket_mask; j++) {
+				_Data *d = stripe.buckets[j];
+				while (d) {
+					data.push_back(d);
+					d = d->next;
+				}
 			}
 		}
 
@@ -80,10 +86,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -93,24 +99,32 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					if (d->cname) {
-						print_line("Orphan StringName: " + String(d->cname));
-					} else {
-						print_line("Orphan StringName: " + String(d->name));
+	for (int i = 0; i < STRING_TABLE_STRIPES; i++) {
+		_Stripe &stripe = _stripes[i];
+		for (uint32_t j = 0; j <= stripe.bucket_mask; j++) {
+			while (stripe.buckets[j]) {
+				_Data *d = stripe.buckets[j];
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						if (d->cname) {
+							print_line("Orphan StringName: " + String(d->cname));
+						} else {
+							print_line("Orphan StringName: " + String(d->name));
+						}
 					}
 				}
-			}
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+				stripe.buckets[j] = stripe.buckets[j]->next;
+				memdelete(d);
+			}
 		}
+
+		memdelete_arr(stripe.buckets);
+		stripe.buckets = nullptr;
+		stripe.bucket_mask = 0;
+		stripe.count = 0;
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
@@ -118,12 +132,120 @@ void StringName::cleanup() {
 	configured = false;
 }
 
+template <typename T>
+StringName::_Data *StringName::_find_and_ref(_Stripe &p_stripe, uint32_t p_hash, const T &p_name, bool p_static) {
+	// Must be called with the stripe locked (shared or exclusive).
+	_Data *d = p_stripe.get_bucket(p_hash);
+
+	while (d) {
+		// compare hash first
+		if (d->hash == p_hash && d->get_name() == p_name) {
+			// The reference count may have just dropped to zero, in which case the entry
+			// is about to be removed (which requires exclusive access) and can't be revived.
+			if (d->refcount.ref()) {
+				if (p_static) {
+					d->static_count.increment();
+				}
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					d->debug_references.increment();
+				}
+#endif
+				return d;
+			}
+		}
+		d = d->next;
+	}
+
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_intern(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static) {
+	_Stripe &stripe = _stripes[p_hash & STRING_TABLE_STRIPE_MASK];
+
+	{
+		RWLockRead read_lock(stripe.lock);
+		_Data *d = _find_and_ref(stripe, p_hash, p_name, p_static);
+		if (d) {
+			return d;
+		}
+	}
+
+	RWLockWrite write_lock(stripe.lock);
+
+	// Another thread may have added it while the stripe was unlocked.
+	_Data *d = _find_and_ref(stripe, p_hash, p_name, p_static);
+	if (d) {
+		return d;
+	}
+
+	d = memnew(_Data);
+	if (p_cname) {
+		d->cname = p_cname;
+	} else {
+		d->name = p_name;
+	}
+	d->refcount.init();
+	d->static_count.set(p_static ? 1 : 0);
+	d->hash = p_hash;
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		d->refcount.ref();
+		d->static_count.increment();
+	}
+#endif
+
+	if (stripe.count >= stripe.bucket_mask + 1) {
+		_grow(stripe);
+	}
+
+	_Data *&bucket = stripe.get_bucket(p_hash);
+	d->next = bucket;
+	d->prev = nullptr;
+	if (bucket) {
+		bucket->prev = d;
+	}
+	bucket = d;
+	stripe.count++;
+
+	return d;
+}
+
+void StringName::_grow(_Stripe &p_stripe) {
+	// Must be called with the stripe locked for writing.
+	uint32_t old_size = p_stripe.bucket_mask + 1;
+	_Data **old_buckets = p_stripe.buckets;
+
+	p_stripe.buckets = memnew_arr(_Data *, old_size * 2);
+	for (uint32_t i = 0; i < old_size * 2; i++) {
+		p_stripe.buckets[i] = nullptr;
+	}
+	p_stripe.bucket_mask = old_size * 2 - 1;
+
+	for (uint32_t i = 0; i < old_size; i++) {
+		_Data *d = old_buckets[i];
+		while (d) {
+			_Data *next = d->next;
+			_Data *&bucket = p_stripe.get_bucket(d->hash);
+			d->next = bucket;
+			d->prev = nullptr;
+			if (bucket) {
+				bucket->prev = d;
+			}
+			bucket = d;
+			d = next;
+		}
+	}
+
+	memdelete_arr(old_buckets);
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
-
 		if (_data->static_count.get() > 0) {
 			if (_data->cname) {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
@@ -131,18 +253,24 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+
+		_Stripe &stripe = _stripes[_data->hash & STRING_TABLE_STRIPE_MASK];
+		RWLockWrite lock(stripe.lock);
+
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			if (_table[_data->idx] != _data) {
+			_Data *&bucket = stripe.get_bucket(_data->hash);
+			if (bucket != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			bucket = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
+		stripe.count--;
 		memdelete(_data);
 	}
 
@@ -206,59 +334,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			if (p_static) {
-				_data->static_count.increment();
-			}
-#ifdef DEBUG_ENABLED
-			if (unlikely(debug_stringname)) {
-				_data->debug_references++;
-			}
-#endif
-		}
-
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(String::hash(p_name), p_name, nullptr, p_static);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -268,57 +344,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			if (p_static) {
-				_data->static_count.increment();
-			}
-#ifdef DEBUG_ENABLED
-			if (unlikely(debug_stringname)) {
-				_data->debug_references++;
-			}
-#endif
-			return;
-		}
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(String::hash(p_static_string.ptr), p_static_string.ptr, p_static_string.ptr, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -330,56 +356,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			if (p_static) {
-				_data->static_count.increment();
-			}
-#ifdef DEBUG_ENABLED
-			if (unlikely(debug_stringname)) {
-				_data->debug_references++;
-			}
-#endif
-			return;
-		}
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name.hash(), p_name, nullptr, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -390,32 +367,13 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Stripe &stripe = _stripes[hash & STRING_TABLE_STRIPE_MASK];
 
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-
-		return StringName(_data);
-	}
+	RWLockRead lock(stripe.lock);
+	_Data *d = _find_and_ref(stripe, hash, p_name, false);
 
-	return StringName(); //does not exist
+	return d ? StringName(d) : StringName(); //does not exist
 }
 
 StringName StringName::search(const char32_t *p_name) {
@@ -426,58 +384,25 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
+	_Stripe &stripe = _stripes[hash & STRING_TABLE_STRIPE_MASK];
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	RWLockRead lock(stripe.lock);
+	_Data *d = _find_and_ref(stripe, hash, p_name, false);
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
-	}
-
-	return StringName(); //does not exist
+	return d ? StringName(d) : StringName(); //does not exist
 }
 
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
+	_Stripe &stripe = _stripes[hash & STRING_TABLE_STRIPE_MASK];
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return StringName(_data);
-	}
+	RWLockRead lock(stripe.lock);
+	_Data *d = _find_and_ref(stripe, hash, p_name, false);
 
-	return StringName(); //does not exist
+	return d ? StringName(d) : StringName(); //does not exist
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -32,6 +32,7 @@
 #define STRING_NAME_H
 
 #include "core/os/mutex.h"
+#include "core/os/rw_lock.h"
 #include "core/string/ustring.h"
 #include "core/templates/safe_refcount.h"
 
@@ -45,10 +46,14 @@ struct StaticCString {
 };
 
 class StringName {
+	// The table is split into stripes, each with its own lock and buckets, so threads
+	// interning different names rarely contend. Lookups of existing names, by far the
+	// most common case, only need shared access.
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_STRIPE_BITS = 6,
+		STRING_TABLE_STRIPES = 1 << STRING_TABLE_STRIPE_BITS,
+		STRING_TABLE_STRIPE_MASK = STRING_TABLE_STRIPES - 1,
+		STRING_TABLE_MIN_BUCKETS = 1024,
 	};
 
 	struct _Data {
@@ -57,17 +62,25 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
 		_Data *next = nullptr;
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct alignas(64) _Stripe {
+		RWLock lock;
+		_Data **buckets = nullptr;
+		uint32_t bucket_mask = 0;
+		uint32_t count = 0;
+
+		_FORCE_INLINE_ _Data *&get_bucket(uint32_t p_hash) { return buckets[(p_hash >> STRING_TABLE_STRIPE_BITS) & bucket_mask]; }
+	};
+
+	static _Stripe _stripes[STRING_TABLE_STRIPES];
 
 	_Data *_data = nullptr;
 
@@ -76,18 +89,23 @@ class StringName {
 		uint32_t hash;
 	};
 
+	template <typename T>
+	static _Data *_find_and_ref(_Stripe &p_stripe, uint32_t p_hash, const T &p_name, bool p_static);
+	template <typename T>
+	static _Data *_intern(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static);
+	static void _grow(_Stripe &p_stripe);
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
 	static void setup();
 	static void cleanup();
 	static bool configured;
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
@@ -35,6 +35,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/string/print_string.h"
+#include "core/string/string_buffer.h"
 #include "core/string/string_name.h"
 #include "core/string/translation.h"
 #include "core/string/ucaps.h"
@@ -3374,50 +3375,62 @@ String String::format(const Variant &values, String placeholder) const {
 	return new_string;
 }
 
-String String::replace(const String &p_key, const String &p_with) const {
-	String new_string;
-	int search_from = 0;
-	int result = 0;
+static _FORCE_INLINE_ void _copy_replacement(char32_t *p_dst, const char32_t *p_src, int p_length) {
+	memcpy(p_dst, p_src, p_length * sizeof(char32_t));
+}
 
-	while ((result = find(p_key, search_from)) >= 0) {
-		new_string += substr(search_from, result - search_from);
-		new_string += p_with;
-		search_from = result + p_key.length();
+static _FORCE_INLINE_ void _copy_replacement(char32_t *p_dst, const char *p_src, int p_length) {
+	for (int i = 0; i < p_length; i++) {
+		p_dst[i] = (uint8_t)p_src[i];
 	}
+}
 
-	if (search_from == 0) {
-		return *this;
+// Counts the matches first, so the result is built with a single allocation.
+template <class K, class W>
+static String _replace_all(const String &p_string, const K &p_key, int p_key_length, const W *p_with, int p_with_length) {
+	if (p_key_length == 0) {
+		return p_string;
 	}
 
-	new_string += substr(search_from, length() - search_from);
+	int count = 0;
+	for (int pos = p_string.find(p_key); pos >= 0; pos = p_string.find(p_key, pos + p_key_length)) {
+		count++;
+	}
 
-	return new_string;
-}
+	if (count == 0) {
+		return p_string;
+	}
 
-String String::replace(const char *p_key, const char *p_with) const {
+	const int new_length = p_string.length() + count * (p_with_length - p_key_length);
 	String new_string;
-	int search_from = 0;
-	int result = 0;
+	new_string.resize(new_length + 1);
 
-	while ((result = find(p_key, search_from)) >= 0) {
-		new_string += substr(search_from, result - search_from);
-		new_string += p_with;
-		int k = 0;
-		while (p_key[k] != '\0') {
-			k++;
-		}
-		search_from = result + k;
-	}
+	const char32_t *src = p_string.get_data();
+	char32_t *dst = new_string.ptrw();
+	int search_from = 0;
 
-	if (search_from == 0) {
-		return *this;
+	for (int pos = p_string.find(p_key); pos >= 0; pos = p_string.find(p_key, search_from)) {
+		memcpy(dst, src + search_from, (pos - search_from) * sizeof(char32_t));
+		dst += pos - search_from;
+		_copy_replacement(dst, p_with, p_with_length);
+		dst += p_with_length;
+		search_from = pos + p_key_length;
 	}
 
-	new_string += substr(search_from, length() - search_from);
+	memcpy(dst, src + search_from, (p_string.length() - search_from) * sizeof(char32_t));
+	new_string.ptrw()[new_length] = 0;
 
 	return new_string;
 }
 
+String String::replace(const String &p_key, const String &p_with) const {
+	return _replace_all(*this, p_key, p_key.length(), p_with.get_data(), p_with.length());
+}
+
+String String::replace(const char *p_key, const char *p_with) const {
+	return _replace_all(*this, p_key, strlen(p_key), p_with, strlen(p_with));
+}
+
 String String::replace_first(const String &p_key, const String &p_with) const {
 	int pos = find(p_key);
 	if (pos >= 0) {
@@ -3648,72 +3661,72 @@ bool String::is_network_share_path() const {
 }
 
 String String::simplify_path() const {
-	String s = *this;
-	String drive;
-	if (s.begins_with("local://")) {
-		drive = "local://";
-		s = s.substr(8, s.length());
-	} else if (s.begins_with("res://")) {
-		drive = "res://";
-		s = s.substr(6, s.length());
-	} else if (s.begins_with("user://")) {
-		drive = "user://";
-		s = s.substr(7, s.length());
+	const char32_t *src = get_data();
+	const int len = length();
+
+	int drive_length = 0;
+	if (begins_with("local://")) {
+		drive_length = 8;
+	} else if (begins_with("res://")) {
+		drive_length = 6;
+	} else if (begins_with("user://")) {
+		drive_length = 7;
 	} else if (is_network_share_path()) {
-		drive = s.substr(0, 2);
-		s = s.substr(2, s.length() - 2);
-	} else if (s.begins_with("/") || s.begins_with("\\")) {
-		drive = s.substr(0, 1);
-		s = s.substr(1, s.length() - 1);
+		drive_length = 2;
+	} else if (begins_with("/") || begins_with("\\")) {
+		drive_length = 1;
 	} else {
-		int p = s.find(":/");
+		int p = find(":/");
 		if (p == -1) {
-			p = s.find(":\\");
+			p = find(":\\");
 		}
-		if (p != -1 && p < s.find("/")) {
-			drive = s.substr(0, p + 2);
-			s = s.substr(p + 2, s.length());
+		if (p != -1 && p < find("/")) {
+			drive_length = p + 2;
 		}
 	}
 
-	s = s.replace("\\", "/");
-	while (true) { // in case of using 2 or more slash
-		String compare = s.replace("//", "/");
-		if (s == compare) {
-			break;
-		} else {
-			s = compare;
+	// Paths are short, so this usually doesn't allocate anything but the result.
+	StringBuffer<256> simplified;
+	simplified.append(src, drive_length);
+
+	int i = drive_length;
+	while (i < len) {
+		if (src[i] == '/' || src[i] == '\\') {
+			i++;
+			continue;
 		}
-	}
-	Vector<String> dirs = s.split("/", false);
 
-	for (int i = 0; i < dirs.size(); i++) {
-		String d = dirs[i];
-		if (d == ".") {
-			dirs.remove_at(i);
-			i--;
-		} else if (d == "..") {
-			if (i == 0) {
-				dirs.remove_at(i);
-				i--;
-			} else {
-				dirs.remove_at(i);
-				dirs.remove_at(i - 1);
-				i -= 2;
-			}
+		const int from = i;
+		while (i < len && src[i] != '/' && src[i] != '\\') {
+			i++;
 		}
-	}
+		const int dir_length = i - from;
 
-	s = "";
+		if (dir_length == 1 && src[from] == '.') {
+			continue;
+		}
 
-	for (int i = 0; i < dirs.size(); i++) {
-		if (i > 0) {
-			s += "/";
+		if (dir_length == 2 && src[from] == '.' && src[from + 1] == '.') {
+			// Remove the previous directory, if any.
+			const char32_t *dst = simplified.ptr();
+			int end = simplified.length();
+			while (end > drive_length && dst[end - 1] != '/') {
+				end--;
+			}
+			if (end > drive_length) {
+				end--;
+			}
+			simplified.truncate(end);
+			continue;
 		}
-		s += dirs[i];
+
+		if (simplified.length() > drive_length) {
+			simplified.append('/');
+		}
+		simplified.append(src + from, dir_length);
 	}
 
-	return drive + s;
+	return simplified.as_string();
 }
 
 static int _humanize_digits(int p_num) {
@@ -4369,6 +4382,30 @@ bool String::is_relative_path() const {
 	return !is_absolute_path();
 }
 
+static int _find_last_path_separator(const String &p_path) {
+	const char32_t *src = p_path.get_data();
+	for (int i = p_path.length() - 1; i >= 0; i--) {
+		if (src[i] == '/' || src[i] == '\\') {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Position of the dot starting the extension of the file name, or -1.
+static int _find_extension_dot(const String &p_path) {
+	const char32_t *src = p_path.get_data();
+	for (int i = p_path.length() - 1; i >= 0; i--) {
+		if (src[i] == '.') {
+			return i;
+		}
+		if (src[i] == '/' || src[i] == '\\') {
+			return -1;
+		}
+	}
+	return -1;
+}
+
 String String::get_base_dir() const {
 	int end = 0;
 
@@ -4413,25 +4450,16 @@ String String::get_base_dir() const {
 		}
 	}
 
-	String rs;
-	String base;
-	if (end != 0) {
-		rs = substr(end, length());
-		base = substr(0, end);
-	} else {
-		rs = *this;
-	}
-
-	int sep = MAX(rs.rfind("/"), rs.rfind("\\"));
-	if (sep == -1) {
-		return base;
+	int sep = _find_last_path_separator(*this);
+	if (sep < end) {
+		return substr(0, end);
 	}
 
-	return base + rs.substr(0, sep);
+	return substr(0, sep);
 }
 
 String String::get_file() const {
-	int sep = MAX(rfind("/"), rfind("\\"));
+	int sep = _find_last_path_separator(*this);
 	if (sep == -1) {
 		return *this;
 	}
@@ -4440,8 +4468,8 @@ String String::get_file() const {
 }
 
 String String::get_extension() const {
-	int pos = rfind(".");
-	if (pos < 0 || pos < MAX(rfind("/"), rfind("\\"))) {
+	int pos = _find_extension_dot(*this);
+	if (pos == -1) {
 		return "";
 	}
 
@@ -4452,10 +4480,23 @@ String String::plus_file(const String &p_file) const {
 	if (is_empty()) {
 		return p_file;
 	}
-	if (operator[](length() - 1) == '/' || (p_file.size() > 0 && p_file.operator[](0) == '/')) {
-		return *this + p_file;
+
+	const int len = length();
+	const int file_len = p_file.length();
+	const int separator = (operator[](len - 1) == '/' || (file_len > 0 && p_file.operator[](0) == '/')) ? 0 : 1;
+
+	// Single allocation, instead of one per concatenation.
+	String joined;
+	joined.resize(len + separator + file_len + 1);
+	char32_t *dst = joined.ptrw();
+	memcpy(dst, get_data(), len * sizeof(char32_t));
+	if (separator) {
+		dst[len] = '/';
 	}
-	return *this + "/" + p_file;
+	memcpy(dst + len + separator, p_file.get_data(), file_len * sizeof(char32_t));
+	dst[len + separator + file_len] = 0;
+
+	return joined;
 }
 
 String String::property_name_encode() const {
@@ -4484,8 +4525,8 @@ String String::validate_node_name() const {
 }
 
 String String::get_basename() const {
-	int pos = rfind(".");
-	if (pos < 0 || pos < MAX(rfind("/"), rfind("\\"))) {
+	int pos = _find_extension_dot(*this);
+	if (pos == -1) {
 		return *this;
 	}
 
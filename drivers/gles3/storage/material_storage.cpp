@@ -2696,6 +2696,27 @@ Variant MaterialStorage::material_get_param(RID p_material, const StringName &p_
 	}
 }
 
+void MaterialStorage::material_get_textures(RID p_material, LocalVector<RID> &r_textures) const {
+	const GLES3::Material *material = material_owner.get_or_null(p_material);
+	ERR_FAIL_COND(!material);
+	// Texture uniforms are stored as RIDs, or arrays of them for sampler arrays.
+	for (const KeyValue<StringName, Variant> &E : material->params) {
+		if (E.value.get_type() == Variant::RID) {
+			r_textures.push_back(E.value);
+		} else if (E.value.get_type() == Variant::ARRAY) {
+			const Array &array = E.value;
+			for (int i = 0; i < array.size(); i++) {
+				if (array[i].get_type() == Variant::RID) {
+					r_textures.push_back(array[i]);
+				}
+			}
+		}
+	}
+	if (material->next_pass.is_valid()) {
+		material_get_textures(material->next_pass, r_textures);
+	}
+}
+
 void MaterialStorage::material_set_next_pass(RID p_material, RID p_next_material) {
 	GLES3::Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_COND(!material);
@@ -310,6 +310,83 @@ void MeshStorage::mesh_surface_update_attribute_region(RID p_mesh, int p_surface
 void MeshStorage::mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
 }
 
+void MeshStorage::mesh_surface_remove_finest_lods(RID p_mesh, int p_surface, int p_count) {
+	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_surface, mesh->surface_count);
+	Mesh::Surface *s = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(p_count < 0 || (uint32_t)p_count > s->lod_count);
+	if (p_count == 0) {
+		return;
+	}
+
+	glDeleteBuffers(1, &s->index_buffer);
+	for (int i = 0; i < p_count - 1; i++) {
+		glDeleteBuffers(1, &s->lods[i].index_buffer);
+	}
+	s->index_buffer = s->lods[p_count - 1].index_buffer;
+	s->index_count = s->lods[p_count - 1].index_count;
+	s->index_buffer_size = s->lods[p_count - 1].index_buffer_size;
+
+	Mesh::Surface::LOD *lods = nullptr;
+	uint32_t lod_count = s->lod_count - p_count;
+	if (lod_count) {
+		lods = memnew_arr(Mesh::Surface::LOD, lod_count);
+		for (uint32_t i = 0; i < lod_count; i++) {
+			lods[i] = s->lods[p_count + i];
+		}
+	}
+	memdelete_arr(s->lods);
+	s->lods = lods;
+	s->lod_count = lod_count;
+}
+
+void MeshStorage::mesh_surface_add_finer_lods(RID p_mesh, int p_surface, const Vector<uint8_t> &p_index_data, const Vector<RS::SurfaceData::LOD> &p_lods, float p_edge_length) {
+	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_surface, mesh->surface_count);
+	Mesh::Surface *s = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(s->index_buffer == 0);
+	ERR_FAIL_COND(p_index_data.is_empty());
+
+	bool is_index_16 = s->vertex_count <= 65536;
+
+	uint32_t lod_count = p_lods.size() + 1 + s->lod_count;
+	Mesh::Surface::LOD *lods = memnew_arr(Mesh::Surface::LOD, lod_count);
+	for (int i = 0; i < p_lods.size(); i++) {
+		glGenBuffers(1, &lods[i].index_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lods[i].index_buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, p_lods[i].index_data.size(), p_lods[i].index_data.ptr(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+		lods[i].edge_length = p_lods[i].edge_length;
+		lods[i].index_count = p_lods[i].index_data.size() / (is_index_16 ? 2 : 4);
+		lods[i].index_buffer_size = p_lods[i].index_data.size();
+	}
+
+	// The current index buffer is kept as the next LOD.
+	Mesh::Surface::LOD &previous = lods[p_lods.size()];
+	previous.index_buffer = s->index_buffer;
+	previous.index_count = s->index_count;
+	previous.index_buffer_size = s->index_buffer_size;
+	previous.edge_length = p_edge_length;
+
+	for (uint32_t i = 0; i < s->lod_count; i++) {
+		lods[p_lods.size() + 1 + i] = s->lods[i];
+	}
+	if (s->lods) {
+		memdelete_arr(s->lods);
+	}
+	s->lods = lods;
+	s->lod_count = lod_count;
+
+	glGenBuffers(1, &s->index_buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s->index_buffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, p_index_data.size(), p_index_data.ptr(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+	s->index_count = p_index_data.size() / (is_index_16 ? 2 : 4);
+	s->index_buffer_size = p_index_data.size();
+}
+
 void MeshStorage::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_COND(!mesh);
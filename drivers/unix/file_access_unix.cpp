@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -150,6 +151,15 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+#if defined(UNIX_ENABLED)
+	if (mapped_data) {
+		munmap((void *)mapped_data, mapped_size);
+	}
+#endif
+	mapped_data = nullptr;
+	mapped_size = 0;
+	mapping_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -245,6 +255,44 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	// Written data may still be in stdio buffers, only files opened for reading can be mapped.
+	if (flags != READ || mapping_failed) {
+		return nullptr;
+	}
+
+	if (!mapped_data) {
+		uint64_t length = get_length();
+		void *data = MAP_FAILED;
+		if (length > 0 && length <= (uint64_t)SIZE_MAX) {
+			data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fileno(f), 0);
+		}
+		if (data == MAP_FAILED) {
+			mapping_failed = true;
+			return nullptr;
+		}
+		mapped_data = (const uint8_t *)data;
+		mapped_size = length;
+	}
+
+	uint64_t pos = get_position();
+	if (pos + p_length > mapped_size) {
+		return nullptr;
+	}
+
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+	return mapped_data + pos;
+#else
+	return nullptr;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Mapping of the whole file, made when a view of it is first requested.
+	mutable const uint8_t *mapped_data = nullptr;
+	mutable uint64_t mapped_size = 0;
+	mutable bool mapping_failed = false;
+
 	void _close();
 
 public:
@@ -69,6 +74,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const;
 
 	virtual Error get_error() const; ///< get last error
 
@@ -34,7 +34,9 @@
 #include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
+#include "scene/resources/residency_manager.h"
 #include "servers/audio_server.h"
+#include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
 #include "servers/physics_server_3d.h"
 #include "servers/rendering_server.h"
@@ -73,6 +75,38 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(NAVIGATION_ACTIVE_MAPS);
+	BIND_ENUM_CONSTANT(NAVIGATION_REGION_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_POLYGON_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_SYNC_TIME);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_MESSAGES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_BYTES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_THREAD_MESSAGES);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_NAVIGATION);
+	BIND_ENUM_CONSTANT(MEMORY_NAVIGATION_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_NAVIGATION_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPTS);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPTS_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPTS_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(STREAMING_MEMORY_BUDGET);
+	BIND_ENUM_CONSTANT(STREAMING_MEMORY_RESIDENT);
+	BIND_ENUM_CONSTANT(STREAMING_MEMORY_FULL);
+	BIND_ENUM_CONSTANT(STREAMING_RESOURCES);
+	BIND_ENUM_CONSTANT(STREAMING_PENDING_LOADS);
+	BIND_ENUM_CONSTANT(STREAMING_EVICTIONS);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -112,12 +146,68 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/driver/output_latency",
+		"navigation/active_maps",
+		"navigation/regions",
+		"navigation/polygons",
+		"navigation/edge_connections",
+		"navigation/sync_time",
+		"message_queue/messages",
+		"message_queue/bytes",
+		"message_queue/thread_messages",
+		"memory/rendering",
+		"memory/rendering_max",
+		"memory/rendering_allocations",
+		"memory/physics",
+		"memory/physics_max",
+		"memory/physics_allocations",
+		"memory/navigation",
+		"memory/navigation_max",
+		"memory/navigation_allocations",
+		"memory/audio",
+		"memory/audio_max",
+		"memory/audio_allocations",
+		"memory/scripts",
+		"memory/scripts_max",
+		"memory/scripts_allocations",
+		"memory/resources",
+		"memory/resources_max",
+		"memory/resources_allocations",
+		"streaming/memory_budget",
+		"streaming/memory_resident",
+		"streaming/memory_full",
+		"streaming/resources",
+		"streaming/pending_loads",
+		"streaming/evictions",
 
 	};
 
 	return names[p_monitor];
 }
 
+static int _get_navigation_process_info(NavigationServer3D::ProcessInfo p_info) {
+	// The navigation server is missing when the module is disabled.
+	const NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	return navigation_server ? navigation_server->get_process_info(p_info) : 0;
+}
+
+double Performance::_get_memory_tag_allocation_rate(Memory::Tag p_tag) const {
+	// Sampling too often would make the rates jump around, keep the last ones for a while.
+	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+	uint64_t elapsed = ticks - _memory_tag_sample_ticks;
+	if (elapsed >= 250000) {
+		for (int i = 0; i < Memory::TAG_MAX; i++) {
+			uint64_t allocations = Memory::get_tag_allocation_count(Memory::Tag(i));
+			if (_memory_tag_sample_ticks != 0) {
+				_memory_tag_allocation_rates[i] = (allocations - _memory_tag_sample_allocations[i]) * 1000000.0 / elapsed;
+			}
+			_memory_tag_sample_allocations[i] = allocations;
+		}
+		_memory_tag_sample_ticks = ticks;
+	}
+
+	return _memory_tag_allocation_rates[p_tag];
+}
+
 double Performance::get_monitor(Monitor p_monitor) const {
 	switch (p_monitor) {
 		case TIME_FPS:
@@ -166,6 +256,70 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case NAVIGATION_ACTIVE_MAPS:
+			return _get_navigation_process_info(NavigationServer3D::INFO_ACTIVE_MAPS);
+		case NAVIGATION_REGION_COUNT:
+			return _get_navigation_process_info(NavigationServer3D::INFO_REGION_COUNT);
+		case NAVIGATION_POLYGON_COUNT:
+			return _get_navigation_process_info(NavigationServer3D::INFO_POLYGON_COUNT);
+		case NAVIGATION_EDGE_CONNECTION_COUNT:
+			return _get_navigation_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
+		case NAVIGATION_SYNC_TIME:
+			return _get_navigation_process_info(NavigationServer3D::INFO_SYNC_TIME) / 1000000.0;
+		case MESSAGE_QUEUE_MESSAGES:
+			return MessageQueue::get_singleton()->get_frame_statistics().messages;
+		case MESSAGE_QUEUE_BYTES:
+			return MessageQueue::get_singleton()->get_frame_statistics().bytes;
+		case MESSAGE_QUEUE_THREAD_MESSAGES:
+			return MessageQueue::get_singleton()->get_frame_statistics().thread_messages;
+		case MEMORY_RENDERING:
+			return Memory::get_tag_usage(Memory::TAG_RENDERING);
+		case MEMORY_RENDERING_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_RENDERING);
+		case MEMORY_RENDERING_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_RENDERING);
+		case MEMORY_PHYSICS:
+			return Memory::get_tag_usage(Memory::TAG_PHYSICS);
+		case MEMORY_PHYSICS_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_PHYSICS);
+		case MEMORY_PHYSICS_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_PHYSICS);
+		case MEMORY_NAVIGATION:
+			return Memory::get_tag_usage(Memory::TAG_NAVIGATION);
+		case MEMORY_NAVIGATION_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_NAVIGATION);
+		case MEMORY_NAVIGATION_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_NAVIGATION);
+		case MEMORY_AUDIO:
+			return Memory::get_tag_usage(Memory::TAG_AUDIO);
+		case MEMORY_AUDIO_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_AUDIO);
+		case MEMORY_AUDIO_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_AUDIO);
+		case MEMORY_SCRIPTS:
+			return Memory::get_tag_usage(Memory::TAG_SCRIPTS);
+		case MEMORY_SCRIPTS_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_SCRIPTS);
+		case MEMORY_SCRIPTS_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_SCRIPTS);
+		case MEMORY_RESOURCES:
+			return Memory::get_tag_usage(Memory::TAG_RESOURCES);
+		case MEMORY_RESOURCES_MAX:
+			return Memory::get_tag_max_usage(Memory::TAG_RESOURCES);
+		case MEMORY_RESOURCES_ALLOCATIONS:
+			return _get_memory_tag_allocation_rate(Memory::TAG_RESOURCES);
+		case STREAMING_MEMORY_BUDGET:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_memory_budget() : 0;
+		case STREAMING_MEMORY_RESIDENT:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_resident_memory() : 0;
+		case STREAMING_MEMORY_FULL:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_full_memory() : 0;
+		case STREAMING_RESOURCES:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_resource_count() : 0;
+		case STREAMING_PENDING_LOADS:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_pending_load_count() : 0;
+		case STREAMING_EVICTIONS:
+			return ResidencyManager::get_singleton() ? ResidencyManager::get_singleton()->get_eviction_count() : 0;
 
 		default: {
 		}
@@ -201,6 +355,38 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -32,6 +32,7 @@
 #define PERFORMANCE_H
 
 #include "core/object/class_db.h"
+#include "core/os/memory.h"
 #include "core/templates/hash_map.h"
 
 #define PERF_WARN_OFFLINE_FUNCTION
@@ -61,6 +62,13 @@ class Performance : public Object {
 	HashMap<StringName, MonitorCall> _monitor_map;
 	uint64_t _monitor_modification_time;
 
+	// Allocation rates are measured over the time between samples.
+	mutable uint64_t _memory_tag_sample_ticks = 0;
+	mutable uint64_t _memory_tag_sample_allocations[Memory::TAG_MAX] = {};
+	mutable double _memory_tag_allocation_rates[Memory::TAG_MAX] = {};
+
+	double _get_memory_tag_allocation_rate(Memory::Tag p_tag) const;
+
 public:
 	enum Monitor {
 		TIME_FPS,
@@ -87,6 +95,38 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		NAVIGATION_ACTIVE_MAPS,
+		NAVIGATION_REGION_COUNT,
+		NAVIGATION_POLYGON_COUNT,
+		NAVIGATION_EDGE_CONNECTION_COUNT,
+		NAVIGATION_SYNC_TIME,
+		MESSAGE_QUEUE_MESSAGES,
+		MESSAGE_QUEUE_BYTES,
+		MESSAGE_QUEUE_THREAD_MESSAGES,
+		MEMORY_RENDERING,
+		MEMORY_RENDERING_MAX,
+		MEMORY_RENDERING_ALLOCATIONS,
+		MEMORY_PHYSICS,
+		MEMORY_PHYSICS_MAX,
+		MEMORY_PHYSICS_ALLOCATIONS,
+		MEMORY_NAVIGATION,
+		MEMORY_NAVIGATION_MAX,
+		MEMORY_NAVIGATION_ALLOCATIONS,
+		MEMORY_AUDIO,
+		MEMORY_AUDIO_MAX,
+		MEMORY_AUDIO_ALLOCATIONS,
+		MEMORY_SCRIPTS,
+		MEMORY_SCRIPTS_MAX,
+		MEMORY_SCRIPTS_ALLOCATIONS,
+		MEMORY_RESOURCES,
+		MEMORY_RESOURCES_MAX,
+		MEMORY_RESOURCES_ALLOCATIONS,
+		STREAMING_MEMORY_BUDGET,
+		STREAMING_MEMORY_RESIDENT,
+		STREAMING_MEMORY_FULL,
+		STREAMING_RESOURCES,
+		STREAMING_PENDING_LOADS,
+		STREAMING_EVICTIONS,
 		MONITOR_MAX
 	};
 
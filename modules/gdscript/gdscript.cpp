@@ -2239,6 +2239,10 @@ GDScriptLanguage::GDScriptLanguage() {
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/max_call_stack", PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater")); //minimum is 1024
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	GDScriptJIT::initialize();
+#endif
+
 	if (EngineDebugger::is_active()) {
 		//debugging enabled!
 
@@ -572,6 +572,16 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Numeric operators get their own opcodes, operating on the values without calling an evaluator.
+		GDScriptFunction::Opcode typed_opcode = GDScriptFunction::get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			append(typed_opcode, 3);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
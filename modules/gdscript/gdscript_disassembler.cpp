@@ -134,6 +134,46 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_ADD_INT:
+			case OPCODE_OPERATOR_SUBTRACT_INT:
+			case OPCODE_OPERATOR_MULTIPLY_INT:
+			case OPCODE_OPERATOR_EQUAL_INT:
+			case OPCODE_OPERATOR_NOT_EQUAL_INT:
+			case OPCODE_OPERATOR_LESS_INT:
+			case OPCODE_OPERATOR_LESS_EQUAL_INT:
+			case OPCODE_OPERATOR_GREATER_INT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			case OPCODE_OPERATOR_ADD_FLOAT:
+			case OPCODE_OPERATOR_SUBTRACT_FLOAT:
+			case OPCODE_OPERATOR_MULTIPLY_FLOAT:
+			case OPCODE_OPERATOR_DIVIDE_FLOAT:
+			case OPCODE_OPERATOR_LESS_FLOAT:
+			case OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_GREATER_FLOAT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_ADD_VECTOR3:
+			case OPCODE_OPERATOR_SUBTRACT_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT: {
+				const TypedOperator *typed_operator = get_typed_operator(code);
+
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += Variant::get_operator_name(typed_operator->op);
+				text += " ";
+				text += DADDR(2);
+				text += " (";
+				text += Variant::get_type_name(typed_operator->left_type);
+				text += ", ";
+				text += Variant::get_type_name(typed_operator->right_type);
+				text += ")";
+
+				incr += 4;
+			} break;
 			case OPCODE_EXTENDS_TEST: {
 				text += "is object ";
 				text += DADDR(3);
@@ -72,6 +72,49 @@ StringName GDScriptFunction::get_name() const {
 	return name;
 }
 
+// Same order as the opcodes.
+static const GDScriptFunction::TypedOperator typed_operators[] = {
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_INT, Variant::OP_ADD, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT, Variant::OP_SUBTRACT, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT, Variant::OP_MULTIPLY, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT, Variant::OP_EQUAL, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT, Variant::OP_NOT_EQUAL, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_INT, Variant::OP_LESS, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT, Variant::OP_LESS_EQUAL, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_INT, Variant::OP_GREATER, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT, Variant::OP_GREATER_EQUAL, Variant::INT, Variant::INT },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT, Variant::OP_ADD, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT, Variant::OP_SUBTRACT, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT, Variant::OP_MULTIPLY, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT, Variant::OP_DIVIDE, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT, Variant::OP_LESS, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT, Variant::OP_LESS_EQUAL, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT, Variant::OP_GREATER, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, Variant::OP_GREATER_EQUAL, Variant::FLOAT, Variant::FLOAT },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3, Variant::OP_ADD, Variant::VECTOR3, Variant::VECTOR3 },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3, Variant::OP_SUBTRACT, Variant::VECTOR3, Variant::VECTOR3 },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3, Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::VECTOR3 },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::FLOAT },
+};
+
+GDScriptFunction::Opcode GDScriptFunction::get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	for (const TypedOperator &E : typed_operators) {
+		if (E.op == p_operator && E.left_type == p_left_type && E.right_type == p_right_type) {
+			return E.opcode;
+		}
+	}
+	return OPCODE_OPERATOR_VALIDATED;
+}
+
+const GDScriptFunction::TypedOperator *GDScriptFunction::get_typed_operator(Opcode p_opcode) {
+	if (p_opcode < OPCODE_OPERATOR_ADD_INT || p_opcode > OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+		return nullptr;
+	}
+	const TypedOperator *typed_operator = &typed_operators[p_opcode - OPCODE_OPERATOR_ADD_INT];
+	DEV_ASSERT(typed_operator->opcode == p_opcode);
+	return typed_operator;
+}
+
 int GDScriptFunction::get_max_stack_size() const {
 	return _stack_size;
 }
@@ -148,11 +191,45 @@ GDScriptFunction::GDScriptFunction() {
 #endif
 }
 
+#ifdef GDSCRIPT_JIT_ENABLED
+GDScriptNativeCode *GDScriptFunction::_get_native_code() {
+	GDScriptNativeCode *native = native_code.load(std::memory_order_acquire);
+	if (native || native_unavailable.is_set()) {
+		return native;
+	}
+
+	if (native_hotness < GDScriptJIT::get_hot_threshold()) {
+		native_hotness++;
+		return nullptr;
+	}
+
+	// Only the first caller past the threshold compiles, the others keep interpreting meanwhile.
+	if (native_compiling.exchange(true, std::memory_order_acq_rel)) {
+		return nullptr;
+	}
+
+	native = GDScriptJIT::compile(this);
+	if (!native) {
+		native_unavailable.set();
+		return nullptr;
+	}
+	native_code.store(native, std::memory_order_release);
+	return native;
+}
+#endif
+
 GDScriptFunction::~GDScriptFunction() {
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	GDScriptNativeCode *native = native_code.load();
+	if (native) {
+		memdelete(native);
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 
 	MutexLock lock(GDScriptLanguage::get_singleton()->lock);
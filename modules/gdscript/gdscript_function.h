@@ -36,10 +36,14 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
+#include "gdscript_jit.h"
 #include "gdscript_utility_functions.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -219,6 +223,28 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Operators on statically typed numeric operands, which work on the raw values.
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET_KEYED,
@@ -422,6 +448,13 @@ public:
 		INSTR_ARGS_MASK = ~INSTR_MASK,
 	};
 
+	struct TypedOperator {
+		Opcode opcode;
+		Variant::Operator op;
+		Variant::Type left_type;
+		Variant::Type right_type;
+	};
+
 	struct StackDebug {
 		int line;
 		int pos;
@@ -432,6 +465,9 @@ public:
 private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+#ifdef GDSCRIPT_JIT_ENABLED
+	friend class GDScriptJITCompiler;
+#endif
 
 	StringName source;
 
@@ -519,6 +555,17 @@ private:
 	friend class GDScriptLanguage;
 
 	SelfList<GDScriptFunction> function_list{ this };
+
+#ifdef GDSCRIPT_JIT_ENABLED
+	// Calls and loop iterations counted towards compiling to native code, saturating at the threshold.
+	// Not atomic: increments lost to other threads only delay compiling a bit.
+	uint32_t native_hotness = 0;
+	std::atomic_bool native_compiling{ false };
+	SafeFlag native_unavailable;
+	std::atomic<GDScriptNativeCode *> native_code{ nullptr };
+
+	GDScriptNativeCode *_get_native_code();
+#endif
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -557,6 +604,10 @@ public:
 
 	_FORCE_INLINE_ bool is_static() const { return _static; }
 
+	// Returns OPCODE_OPERATOR_VALIDATED when there is no specialized opcode for the operand types.
+	static Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type);
+	static const TypedOperator *get_typed_operator(Opcode p_opcode);
+
 	const int *get_code() const; //used for debug
 	int get_code_size() const;
 	Variant get_constant(int p_idx) const;
@@ -595,6 +646,10 @@ public:
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	bool has_native_code() const { return native_code.load(std::memory_order_acquire) != nullptr; }
+#endif
+
 #ifdef DEBUG_ENABLED
 	void disassemble(const Vector<String> &p_code_lines) const;
 #endif
@@ -0,0 +1,1021 @@
+/*************************************************************************/
+/*  gdscript_jit.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_jit.h"
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+#include "gdscript_function.h"
+
+#include "core/config/project_settings.h"
+#include "core/variant/variant_internal.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+bool GDScriptJIT::enabled = false;
+uint32_t GDScriptJIT::hot_threshold = 1000;
+
+// Helpers called from native code. They are kept out of line so the
+// generated code stays small; the validated evaluators are called directly.
+
+static void _jit_assign(Variant *r_dst, const Variant *p_src) {
+	*r_dst = *p_src;
+}
+
+static void _jit_assign_bool(Variant *r_dst, bool p_value) {
+	*r_dst = p_value;
+}
+
+static bool _jit_booleanize(const Variant *p_value) {
+	return p_value->booleanize();
+}
+
+static bool _jit_set_keyed(Variant *p_dst, const Variant *p_key, const Variant *p_value, Variant::ValidatedKeyedSetter p_setter) {
+	bool valid;
+	p_setter(p_dst, p_key, p_value, &valid);
+	return valid;
+}
+
+static bool _jit_get_keyed(const Variant *p_src, const Variant *p_key, Variant *r_dst, Variant::ValidatedKeyedGetter p_getter) {
+	// Use a temporary so the interpreter can still report errors when src and dst overlap.
+	Variant ret;
+	bool valid;
+	p_getter(p_src, p_key, &ret, &valid);
+	if (unlikely(!valid)) {
+		return false;
+	}
+	*r_dst = ret;
+	return true;
+}
+
+static bool _jit_set_indexed(Variant *p_dst, const Variant *p_index, const Variant *p_value, Variant::ValidatedIndexedSetter p_setter) {
+	bool oob;
+	p_setter(p_dst, *VariantInternal::get_int(p_index), p_value, &oob);
+	return !oob;
+}
+
+static bool _jit_get_indexed(const Variant *p_src, const Variant *p_index, Variant *r_dst, Variant::ValidatedIndexedGetter p_getter) {
+	bool oob;
+	p_getter(p_src, *VariantInternal::get_int(p_index), r_dst, &oob);
+	return !oob;
+}
+
+static bool _jit_iterate_begin_int(Variant *p_counter, const Variant *p_container, Variant *p_iterator) {
+	int64_t size = *VariantInternal::get_int(p_container);
+
+	VariantInternal::initialize(p_counter, Variant::INT);
+	*VariantInternal::get_int(p_counter) = 0;
+
+	if (size > 0) {
+		VariantInternal::initialize(p_iterator, Variant::INT);
+		*VariantInternal::get_int(p_iterator) = 0;
+		return true;
+	}
+	return false;
+}
+
+static bool _jit_iterate_int(Variant *p_counter, const Variant *p_container, Variant *p_iterator) {
+	int64_t size = *VariantInternal::get_int(p_container);
+	int64_t *count = VariantInternal::get_int(p_counter);
+
+	(*count)++;
+
+	if (*count >= size) {
+		return false;
+	}
+	*VariantInternal::get_int(p_iterator) = *count;
+	return true;
+}
+
+template <class T>
+static void _jit_type_adjust(Variant *p_arg) {
+	VariantTypeAdjust<T>::adjust(p_arg);
+}
+
+// Minimal x86-64 assembler, only covering what the compiler below emits.
+class GDScriptJITAssembler {
+public:
+	enum Reg {
+		RAX = 0,
+		RCX = 1,
+		RDX = 2,
+		RBX = 3,
+		RSP = 4,
+		RBP = 5,
+		RSI = 6,
+		RDI = 7,
+		R8 = 8,
+		R12 = 12,
+		R13 = 13,
+		R14 = 14,
+		R15 = 15,
+	};
+
+	LocalVector<uint8_t> buffer;
+
+	_FORCE_INLINE_ uint32_t size() const { return buffer.size(); }
+
+	void emit_byte(uint8_t p_byte) {
+		buffer.push_back(p_byte);
+	}
+
+	void emit_int32(int32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			buffer.push_back(uint8_t(uint32_t(p_value) >> (i * 8)));
+		}
+	}
+
+	void emit_int64(uint64_t p_value) {
+		for (int i = 0; i < 8; i++) {
+			buffer.push_back(uint8_t(p_value >> (i * 8)));
+		}
+	}
+
+	void patch_int32(uint32_t p_pos, int32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			buffer[p_pos + i] = uint8_t(uint32_t(p_value) >> (i * 8));
+		}
+	}
+
+	void push(Reg p_reg) {
+		if (p_reg >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0x50 + (p_reg & 7));
+	}
+
+	void pop(Reg p_reg) {
+		if (p_reg >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0x58 + (p_reg & 7));
+	}
+
+	// mov/lea p_reg, [p_base + p_disp] with a 32-bit displacement.
+	void _mem_op(uint8_t p_opcode, Reg p_reg, Reg p_base, int32_t p_disp) {
+		emit_byte(0x48 | (p_reg >= R8 ? 0x04 : 0) | (p_base >= R8 ? 0x01 : 0));
+		emit_byte(p_opcode);
+		emit_byte(0x80 | ((p_reg & 7) << 3) | (p_base & 7));
+		if ((p_base & 7) == RSP) {
+			emit_byte(0x24); // SIB, no index.
+		}
+		emit_int32(p_disp);
+	}
+
+	// Same as above for two-byte (0x0F prefixed) opcodes.
+	void _mem_op_0f(uint8_t p_opcode, Reg p_reg, Reg p_base, int32_t p_disp) {
+		emit_byte(0x48 | (p_reg >= R8 ? 0x04 : 0) | (p_base >= R8 ? 0x01 : 0));
+		emit_byte(0x0F);
+		emit_byte(p_opcode);
+		emit_byte(0x80 | ((p_reg & 7) << 3) | (p_base & 7));
+		if ((p_base & 7) == RSP) {
+			emit_byte(0x24);
+		}
+		emit_int32(p_disp);
+	}
+
+	// Scalar double instructions on xmm0 with a memory operand.
+	void _sse_op(uint8_t p_prefix, uint8_t p_opcode, Reg p_base, int32_t p_disp) {
+		emit_byte(p_prefix);
+		if (p_base >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0x0F);
+		emit_byte(p_opcode);
+		emit_byte(0x80 | (p_base & 7));
+		if ((p_base & 7) == RSP) {
+			emit_byte(0x24);
+		}
+		emit_int32(p_disp);
+	}
+
+	void lea(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op(0x8D, p_dst, p_base, p_disp);
+	}
+
+	void load(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op(0x8B, p_dst, p_base, p_disp);
+	}
+
+	void store(Reg p_base, int32_t p_disp, Reg p_src) {
+		_mem_op(0x89, p_src, p_base, p_disp);
+	}
+
+	void store_byte(Reg p_base, int32_t p_disp, Reg p_src) {
+		_mem_op(0x88, p_src, p_base, p_disp);
+	}
+
+	// Integer arithmetic and comparison of rax with a memory operand.
+	void add(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op(0x03, p_dst, p_base, p_disp);
+	}
+
+	void sub(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op(0x2B, p_dst, p_base, p_disp);
+	}
+
+	void imul(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op_0f(0xAF, p_dst, p_base, p_disp);
+	}
+
+	void cmp(Reg p_dst, Reg p_base, int32_t p_disp) {
+		_mem_op(0x3B, p_dst, p_base, p_disp);
+	}
+
+	enum Condition {
+		COND_B = 0x2,
+		COND_AE = 0x3,
+		COND_E = 0x4,
+		COND_NE = 0x5,
+		COND_A = 0x7,
+		COND_L = 0xC,
+		COND_GE = 0xD,
+		COND_LE = 0xE,
+		COND_G = 0xF,
+	};
+
+	// setcc al
+	void set_al(Condition p_condition) {
+		emit_byte(0x0F);
+		emit_byte(0x90 | p_condition);
+		emit_byte(0xC0);
+	}
+
+	void movsd_load(Reg p_base, int32_t p_disp) {
+		_sse_op(0xF2, 0x10, p_base, p_disp);
+	}
+
+	void movsd_store(Reg p_base, int32_t p_disp) {
+		_sse_op(0xF2, 0x11, p_base, p_disp);
+	}
+
+	enum SSEOp {
+		SSE_ADD = 0x58,
+		SSE_MUL = 0x59,
+		SSE_SUB = 0x5C,
+		SSE_DIV = 0x5E,
+	};
+
+	void sse_arith(SSEOp p_op, Reg p_base, int32_t p_disp) {
+		_sse_op(0xF2, p_op, p_base, p_disp);
+	}
+
+	void ucomisd(Reg p_base, int32_t p_disp) {
+		_sse_op(0x66, 0x2E, p_base, p_disp);
+	}
+
+	// mov dword [p_base], imm32
+	void store_imm32(Reg p_base, int32_t p_value) {
+		if (p_base >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0xC7);
+		emit_byte(0x80 | (p_base & 7));
+		if ((p_base & 7) == RSP) {
+			emit_byte(0x24);
+		}
+		emit_int32(0);
+		emit_int32(p_value);
+	}
+
+	void mov(Reg p_dst, Reg p_src) {
+		emit_byte(0x48 | (p_src >= R8 ? 0x04 : 0) | (p_dst >= R8 ? 0x01 : 0));
+		emit_byte(0x89);
+		emit_byte(0xC0 | ((p_src & 7) << 3) | (p_dst & 7));
+	}
+
+	// Zero-extends into the full register.
+	void mov_imm32(Reg p_dst, int32_t p_value) {
+		if (p_dst >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0xB8 + (p_dst & 7));
+		emit_int32(p_value);
+	}
+
+	void mov_imm64(Reg p_dst, uint64_t p_value) {
+		emit_byte(0x48 | (p_dst >= R8 ? 0x01 : 0));
+		emit_byte(0xB8 + (p_dst & 7));
+		emit_int64(p_value);
+	}
+
+	void add_rsp(int32_t p_value) {
+		emit_byte(0x48);
+		emit_byte(0x81);
+		emit_byte(0xC4);
+		emit_int32(p_value);
+	}
+
+	void sub_rsp(int32_t p_value) {
+		emit_byte(0x48);
+		emit_byte(0x81);
+		emit_byte(0xEC);
+		emit_int32(p_value);
+	}
+
+	void call(const void *p_function) {
+		mov_imm64(RAX, uint64_t(p_function));
+		emit_byte(0xFF);
+		emit_byte(0xD0); // call rax
+	}
+
+	void jmp_reg(Reg p_reg) {
+		if (p_reg >= R8) {
+			emit_byte(0x41);
+		}
+		emit_byte(0xFF);
+		emit_byte(0xE0 | (p_reg & 7));
+	}
+
+	void test_al() {
+		emit_byte(0x84);
+		emit_byte(0xC0);
+	}
+
+	// Jumps with a 32-bit displacement, return the position to patch.
+	uint32_t jmp() {
+		emit_byte(0xE9);
+		emit_int32(0);
+		return size() - 4;
+	}
+
+	uint32_t jz() {
+		emit_byte(0x0F);
+		emit_byte(0x84);
+		emit_int32(0);
+		return size() - 4;
+	}
+
+	uint32_t jnz() {
+		emit_byte(0x0F);
+		emit_byte(0x85);
+		emit_int32(0);
+		return size() - 4;
+	}
+
+	void bind(uint32_t p_patch_pos, uint32_t p_target) {
+		patch_int32(p_patch_pos, int32_t(p_target) - int32_t(p_patch_pos + 4));
+	}
+
+	void ret() {
+		emit_byte(0xC3);
+	}
+};
+
+typedef GDScriptJITAssembler Asm;
+
+class GDScriptJITCompiler {
+	const GDScriptFunction *function = nullptr;
+	const int *code = nullptr;
+	int code_size = 0;
+
+	Asm a;
+	int32_t frame_size = 0;
+
+	LocalVector<int32_t> labels;
+	LocalVector<int32_t> entries;
+	LocalVector<int> worklist;
+
+	struct Fixup {
+		uint32_t pos = 0;
+		int target = 0;
+	};
+	LocalVector<Fixup> fixups;
+
+	uint32_t compiled_instructions = 0;
+	bool uses_members = false;
+	int32_t value_offset = 0;
+
+	enum {
+		NO_FALLTHROUGH = -1,
+		UNSUPPORTED = -2,
+	};
+
+	void _emit_prologue();
+	void _emit_exit(int p_ip);
+	void _emit_exit_if_false(int p_ip);
+	void _emit_branch(uint32_t p_patch_pos, int p_target);
+	bool _resolve_address(int p_address, Asm::Reg &r_base, int32_t &r_disp);
+	bool _emit_address(int p_address, Asm::Reg p_dst);
+	int _emit_typed_operator(int p_ip, const GDScriptFunction::TypedOperator *p_operator);
+	bool _emit_call_args(int p_ip, int p_argc);
+	bool _is_valid_target(int p_target) const { return p_target >= 0 && p_target < code_size; }
+
+	int _emit_instruction(int p_ip);
+	int _get_fallthrough_size(int p_ip) const;
+
+public:
+	GDScriptNativeCode *compile();
+
+	GDScriptJITCompiler(const GDScriptFunction *p_function) {
+		function = p_function;
+		code = p_function->_code_ptr;
+		code_size = p_function->_code_size;
+
+		Variant value = int64_t(0);
+		value_offset = int32_t((const uint8_t *)VariantInternal::get_int(&value) - (const uint8_t *)&value);
+	}
+};
+
+void GDScriptJITCompiler::_emit_prologue() {
+	// Callee-saved registers hold the addressing bases, the fifth push keeps the stack aligned.
+	a.push(Asm::RBX);
+	a.push(Asm::R12);
+	a.push(Asm::R13);
+	a.push(Asm::R14);
+	a.push(Asm::R15);
+	a.sub_rsp(frame_size);
+
+	a.load(Asm::RBX, Asm::RDI, offsetof(GDScriptNativeCode::Frame, stack));
+	a.load(Asm::R12, Asm::RDI, offsetof(GDScriptNativeCode::Frame, constants));
+	a.load(Asm::R13, Asm::RDI, offsetof(GDScriptNativeCode::Frame, members));
+	a.load(Asm::R14, Asm::RDI, offsetof(GDScriptNativeCode::Frame, line));
+	a.jmp_reg(Asm::RSI);
+}
+
+void GDScriptJITCompiler::_emit_exit(int p_ip) {
+	a.mov_imm32(Asm::RAX, p_ip);
+	a.add_rsp(frame_size);
+	a.pop(Asm::R15);
+	a.pop(Asm::R14);
+	a.pop(Asm::R13);
+	a.pop(Asm::R12);
+	a.pop(Asm::RBX);
+	a.ret();
+}
+
+// Leaves native code when a checked helper fails, so the interpreter
+// executes the instruction again and reports the error.
+void GDScriptJITCompiler::_emit_exit_if_false(int p_ip) {
+	a.test_al();
+	uint32_t skip = a.jnz();
+	_emit_exit(p_ip);
+	a.bind(skip, a.size());
+}
+
+void GDScriptJITCompiler::_emit_branch(uint32_t p_patch_pos, int p_target) {
+	Fixup fixup;
+	fixup.pos = p_patch_pos;
+	fixup.target = p_target;
+	fixups.push_back(fixup);
+	if (labels[p_target] < 0) {
+		worklist.push_back(p_target);
+	}
+}
+
+bool GDScriptJITCompiler::_resolve_address(int p_address, Asm::Reg &r_base, int32_t &r_disp) {
+	int index = p_address & GDScriptFunction::ADDR_MASK;
+
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_STACK: {
+			if (index >= function->_stack_size) {
+				return false;
+			}
+			r_base = Asm::RBX;
+		} break;
+		case GDScriptFunction::ADDR_TYPE_CONSTANT: {
+			if (index >= function->_constant_count) {
+				return false;
+			}
+			r_base = Asm::R12;
+		} break;
+		case GDScriptFunction::ADDR_TYPE_MEMBER: {
+			uses_members = true;
+			r_base = Asm::R13;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	r_disp = index * int32_t(sizeof(Variant));
+	return true;
+}
+
+bool GDScriptJITCompiler::_emit_address(int p_address, Asm::Reg p_dst) {
+	Asm::Reg base;
+	int32_t disp;
+	if (!_resolve_address(p_address, base, disp)) {
+		return false;
+	}
+	a.lea(p_dst, base, disp);
+	return true;
+}
+
+// Typed operands always hold a value of their type, so native code works on the raw values in place.
+int GDScriptJITCompiler::_emit_typed_operator(int p_ip, const GDScriptFunction::TypedOperator *p_operator) {
+	if (p_ip + 4 >= code_size) {
+		return UNSUPPORTED;
+	}
+
+	Asm::Reg left, right, dst;
+	int32_t left_disp, right_disp, dst_disp;
+	if (!_resolve_address(code[p_ip + 1], left, left_disp) || !_resolve_address(code[p_ip + 2], right, right_disp) || !_resolve_address(code[p_ip + 3], dst, dst_disp)) {
+		return UNSUPPORTED;
+	}
+
+	if (p_operator->left_type == Variant::INT) {
+		a.load(Asm::RAX, left, left_disp + value_offset);
+		switch (p_operator->op) {
+			case Variant::OP_ADD:
+				a.add(Asm::RAX, right, right_disp + value_offset);
+				break;
+			case Variant::OP_SUBTRACT:
+				a.sub(Asm::RAX, right, right_disp + value_offset);
+				break;
+			case Variant::OP_MULTIPLY:
+				a.imul(Asm::RAX, right, right_disp + value_offset);
+				break;
+			default: {
+				static const Asm::Condition conditions[] = { Asm::COND_E, Asm::COND_NE, Asm::COND_L, Asm::COND_LE, Asm::COND_G, Asm::COND_GE };
+				a.cmp(Asm::RAX, right, right_disp + value_offset);
+				a.set_al(conditions[p_operator->op - Variant::OP_EQUAL]);
+				a.store_byte(dst, dst_disp + value_offset, Asm::RAX);
+				return p_ip + 4;
+			}
+		}
+		a.store(dst, dst_disp + value_offset, Asm::RAX);
+		return p_ip + 4;
+	}
+
+	if (p_operator->left_type == Variant::FLOAT) {
+		switch (p_operator->op) {
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE: {
+				static const Asm::SSEOp ops[] = { Asm::SSE_ADD, Asm::SSE_SUB, Asm::SSE_MUL, Asm::SSE_DIV };
+				a.movsd_load(left, left_disp + value_offset);
+				a.sse_arith(ops[p_operator->op - Variant::OP_ADD], right, right_disp + value_offset);
+				a.movsd_store(dst, dst_disp + value_offset);
+			} break;
+			case Variant::OP_GREATER:
+			case Variant::OP_GREATER_EQUAL: {
+				a.movsd_load(left, left_disp + value_offset);
+				a.ucomisd(right, right_disp + value_offset);
+				a.set_al(p_operator->op == Variant::OP_GREATER ? Asm::COND_A : Asm::COND_AE);
+				a.store_byte(dst, dst_disp + value_offset, Asm::RAX);
+			} break;
+			default: {
+				// Less comparisons are done with swapped operands, so they're false for NaN like in C++.
+				a.movsd_load(right, right_disp + value_offset);
+				a.ucomisd(left, left_disp + value_offset);
+				a.set_al(p_operator->op == Variant::OP_LESS ? Asm::COND_A : Asm::COND_AE);
+				a.store_byte(dst, dst_disp + value_offset, Asm::RAX);
+			} break;
+		}
+		return p_ip + 4;
+	}
+
+	Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(p_operator->op, p_operator->left_type, p_operator->right_type);
+	if (!evaluator) {
+		return UNSUPPORTED;
+	}
+	a.lea(Asm::RDI, left, left_disp);
+	a.lea(Asm::RSI, right, right_disp);
+	a.lea(Asm::RDX, dst, dst_disp);
+	a.call((const void *)evaluator);
+	return p_ip + 4;
+}
+
+// Stores the addresses of the first p_argc instruction arguments in the frame, as an argument array.
+bool GDScriptJITCompiler::_emit_call_args(int p_ip, int p_argc) {
+	for (int i = 0; i < p_argc; i++) {
+		if (!_emit_address(code[p_ip + 1 + i], Asm::RAX)) {
+			return false;
+		}
+		a.store(Asm::RSP, i * int32_t(sizeof(void *)), Asm::RAX);
+	}
+	return true;
+}
+
+#define JIT_CHECK(m_cond)      \
+	if (unlikely(!(m_cond))) { \
+		return UNSUPPORTED;    \
+	}
+
+// Valid code always ends with OPCODE_END, so whatever follows a compiled instruction is in range.
+#define JIT_CHECK_SPACE(m_space) JIT_CHECK(p_ip + (m_space) < code_size)
+
+#define JIT_ADDRESS(m_code_ofs, m_reg) JIT_CHECK(_emit_address(code[p_ip + (m_code_ofs)], Asm::m_reg))
+
+#define JIT_TYPE_ADJUST(m_v_type, m_c_type)                     \
+	case GDScriptFunction::OPCODE_TYPE_ADJUST_##m_v_type: {     \
+		JIT_CHECK_SPACE(2);                                     \
+		JIT_ADDRESS(1, RDI);                                    \
+		a.call((const void *)&_jit_type_adjust<m_c_type>);      \
+		return p_ip + 2;                                        \
+	}
+
+int GDScriptJITCompiler::_emit_instruction(int p_ip) {
+	int opcode = code[p_ip] & GDScriptFunction::INSTR_MASK;
+	int instr_arg_count = (code[p_ip] & GDScriptFunction::INSTR_ARGS_MASK) >> GDScriptFunction::INSTR_BITS;
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			JIT_CHECK_SPACE(5);
+			int operator_idx = code[p_ip + 4];
+			JIT_CHECK(operator_idx >= 0 && operator_idx < function->_operator_funcs_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.call((const void *)function->_operator_funcs_ptr[operator_idx]);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+			JIT_CHECK_SPACE(5);
+			int index_setter = code[p_ip + 4];
+			JIT_CHECK(index_setter >= 0 && index_setter < function->_keyed_setters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.mov_imm64(Asm::RCX, uint64_t(function->_keyed_setters_ptr[index_setter]));
+			a.call((const void *)&_jit_set_keyed);
+			_emit_exit_if_false(p_ip);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+			JIT_CHECK_SPACE(5);
+			int index_getter = code[p_ip + 4];
+			JIT_CHECK(index_getter >= 0 && index_getter < function->_keyed_getters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.mov_imm64(Asm::RCX, uint64_t(function->_keyed_getters_ptr[index_getter]));
+			a.call((const void *)&_jit_get_keyed);
+			_emit_exit_if_false(p_ip);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			JIT_CHECK_SPACE(5);
+			int index_setter = code[p_ip + 4];
+			JIT_CHECK(index_setter >= 0 && index_setter < function->_indexed_setters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.mov_imm64(Asm::RCX, uint64_t(function->_indexed_setters_ptr[index_setter]));
+			a.call((const void *)&_jit_set_indexed);
+			_emit_exit_if_false(p_ip);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			JIT_CHECK_SPACE(5);
+			int index_getter = code[p_ip + 4];
+			JIT_CHECK(index_getter >= 0 && index_getter < function->_indexed_getters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.mov_imm64(Asm::RCX, uint64_t(function->_indexed_getters_ptr[index_getter]));
+			a.call((const void *)&_jit_get_indexed);
+			_emit_exit_if_false(p_ip);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			JIT_CHECK_SPACE(4);
+			int index_setter = code[p_ip + 3];
+			JIT_CHECK(index_setter >= 0 && index_setter < function->_setters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			a.call((const void *)function->_setters_ptr[index_setter]);
+			return p_ip + 4;
+		}
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			JIT_CHECK_SPACE(4);
+			int index_getter = code[p_ip + 3];
+			JIT_CHECK(index_getter >= 0 && index_getter < function->_getters_count);
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			a.call((const void *)function->_getters_ptr[index_getter]);
+			return p_ip + 4;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			JIT_CHECK_SPACE(3);
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			a.call((const void *)&_jit_assign);
+			return p_ip + 3;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			JIT_CHECK_SPACE(2);
+			JIT_ADDRESS(1, RDI);
+			a.mov_imm32(Asm::RSI, opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE ? 1 : 0);
+			a.call((const void *)&_jit_assign_bool);
+			return p_ip + 2;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			JIT_CHECK_SPACE(3 + instr_arg_count);
+			int argc = code[p_ip + instr_arg_count + 1];
+			int constructor_idx = code[p_ip + instr_arg_count + 2];
+			JIT_CHECK(argc >= 0 && argc + 1 <= instr_arg_count);
+			JIT_CHECK(constructor_idx >= 0 && constructor_idx < function->_constructors_count);
+
+			JIT_CHECK(_emit_call_args(p_ip, argc));
+			JIT_ADDRESS(1 + argc, RDI);
+			a.mov(Asm::RSI, Asm::RSP);
+			a.call((const void *)function->_constructors_ptr[constructor_idx]);
+			return p_ip + instr_arg_count + 3;
+		}
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			JIT_CHECK_SPACE(3 + instr_arg_count);
+			int argc = code[p_ip + instr_arg_count + 1];
+			int method_idx = code[p_ip + instr_arg_count + 2];
+			JIT_CHECK(argc >= 0 && argc + 2 <= instr_arg_count);
+			JIT_CHECK(method_idx >= 0 && method_idx < function->_builtin_methods_count);
+
+			JIT_CHECK(_emit_call_args(p_ip, argc));
+			JIT_ADDRESS(1 + argc, RDI);
+			a.mov(Asm::RSI, Asm::RSP);
+			a.mov_imm32(Asm::RDX, argc);
+			JIT_ADDRESS(2 + argc, RCX);
+			a.call((const void *)function->_builtin_methods_ptr[method_idx]);
+			return p_ip + instr_arg_count + 3;
+		}
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			JIT_CHECK_SPACE(3 + instr_arg_count);
+			int argc = code[p_ip + instr_arg_count + 1];
+			int utility_idx = code[p_ip + instr_arg_count + 2];
+			JIT_CHECK(argc >= 0 && argc + 1 <= instr_arg_count);
+			JIT_CHECK(utility_idx >= 0 && utility_idx < function->_utilities_count);
+
+			JIT_CHECK(_emit_call_args(p_ip, argc));
+			JIT_ADDRESS(1 + argc, RDI);
+			a.mov(Asm::RSI, Asm::RSP);
+			a.mov_imm32(Asm::RDX, argc);
+			a.call((const void *)function->_utilities_ptr[utility_idx]);
+			return p_ip + instr_arg_count + 3;
+		}
+		case GDScriptFunction::OPCODE_JUMP: {
+			JIT_CHECK_SPACE(2);
+			int to = code[p_ip + 1];
+			JIT_CHECK(_is_valid_target(to));
+
+			_emit_branch(a.jmp(), to);
+			return NO_FALLTHROUGH;
+		}
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			JIT_CHECK_SPACE(3);
+			int to = code[p_ip + 2];
+			JIT_CHECK(_is_valid_target(to) && _is_valid_target(p_ip + 3));
+
+			JIT_ADDRESS(1, RDI);
+			a.call((const void *)&_jit_booleanize);
+			a.test_al();
+			_emit_branch(opcode == GDScriptFunction::OPCODE_JUMP_IF ? a.jnz() : a.jz(), to);
+			return p_ip + 3;
+		}
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			JIT_CHECK_SPACE(opcode == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? 8 : 5);
+			int jumpto = code[p_ip + 4];
+			JIT_CHECK(_is_valid_target(jumpto) && _is_valid_target(p_ip + 5));
+
+			JIT_ADDRESS(1, RDI);
+			JIT_ADDRESS(2, RSI);
+			JIT_ADDRESS(3, RDX);
+			a.call(opcode == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? (const void *)&_jit_iterate_begin_int : (const void *)&_jit_iterate_int);
+			a.test_al();
+			_emit_branch(a.jz(), jumpto);
+			return p_ip + 5;
+		}
+		case GDScriptFunction::OPCODE_LINE: {
+			JIT_CHECK_SPACE(2);
+			a.store_imm32(Asm::R14, code[p_ip + 1]);
+			return p_ip + 2;
+		}
+
+			JIT_TYPE_ADJUST(BOOL, bool);
+			JIT_TYPE_ADJUST(INT, int64_t);
+			JIT_TYPE_ADJUST(FLOAT, double);
+			JIT_TYPE_ADJUST(STRING, String);
+			JIT_TYPE_ADJUST(VECTOR2, Vector2);
+			JIT_TYPE_ADJUST(VECTOR2I, Vector2i);
+			JIT_TYPE_ADJUST(RECT2, Rect2);
+			JIT_TYPE_ADJUST(RECT2I, Rect2i);
+			JIT_TYPE_ADJUST(VECTOR3, Vector3);
+			JIT_TYPE_ADJUST(VECTOR3I, Vector3i);
+			JIT_TYPE_ADJUST(TRANSFORM2D, Transform2D);
+			JIT_TYPE_ADJUST(VECTOR4, Vector4);
+			JIT_TYPE_ADJUST(VECTOR4I, Vector4i);
+			JIT_TYPE_ADJUST(PLANE, Plane);
+			JIT_TYPE_ADJUST(QUATERNION, Quaternion);
+			JIT_TYPE_ADJUST(AABB, AABB);
+			JIT_TYPE_ADJUST(BASIS, Basis);
+			JIT_TYPE_ADJUST(TRANSFORM3D, Transform3D);
+			JIT_TYPE_ADJUST(PROJECTION, Projection);
+			JIT_TYPE_ADJUST(COLOR, Color);
+			JIT_TYPE_ADJUST(ARRAY, Array);
+			JIT_TYPE_ADJUST(DICTIONARY, Dictionary);
+
+		default: {
+			const GDScriptFunction::TypedOperator *typed_operator = GDScriptFunction::get_typed_operator(GDScriptFunction::Opcode(opcode));
+			if (typed_operator) {
+				return _emit_typed_operator(p_ip, typed_operator);
+			}
+			// Untyped, object and control flow opcodes that need the interpreter state.
+			return UNSUPPORTED;
+		}
+	}
+}
+
+#undef JIT_TYPE_ADJUST
+#undef JIT_ADDRESS
+#undef JIT_CHECK_SPACE
+#undef JIT_CHECK
+
+// Size of the interpreted instructions that simply continue with the next one,
+// used to keep compiling the code that follows them.
+int GDScriptJITCompiler::_get_fallthrough_size(int p_ip) const {
+	int instr_arg_count = (code[p_ip] & GDScriptFunction::INSTR_ARGS_MASK) >> GDScriptFunction::INSTR_BITS;
+
+	switch (code[p_ip] & GDScriptFunction::INSTR_MASK) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+			return 5;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_IS_BUILTIN:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_ASSERT:
+			return 3;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			return instr_arg_count + 2;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+			return instr_arg_count + 4;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA:
+			return instr_arg_count + 3;
+		default: {
+			int opcode = code[p_ip] & GDScriptFunction::INSTR_MASK;
+			if (opcode >= GDScriptFunction::OPCODE_CALL_PTRCALL_NO_RETURN && opcode <= GDScriptFunction::OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY) {
+				return instr_arg_count + 3;
+			}
+			return 0;
+		}
+	}
+}
+
+GDScriptNativeCode *GDScriptJITCompiler::compile() {
+	if (code_size <= 0) {
+		return nullptr;
+	}
+
+	// Room for the argument arrays of calls, keeping the stack 16-byte aligned.
+	frame_size = ((MAX(function->_instruction_args_size, 1) * int32_t(sizeof(void *))) + 15) & ~15;
+
+	labels.resize(code_size);
+	entries.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		labels[i] = -1;
+		entries[i] = -1;
+	}
+
+	_emit_prologue();
+
+	worklist.push_back(0);
+	while (worklist.size()) {
+		int ip = worklist[worklist.size() - 1];
+		worklist.resize(worklist.size() - 1);
+
+		// Lay out fallthrough chains contiguously.
+		while (labels[ip] < 0) {
+			uint32_t start = a.size();
+			uint32_t fixup_count = fixups.size();
+			labels[ip] = start;
+
+			int next = _emit_instruction(ip);
+			if (next == UNSUPPORTED) {
+				a.buffer.resize(start);
+				fixups.resize(fixup_count);
+				_emit_exit(ip);
+
+				int size = _get_fallthrough_size(ip);
+				if (size > 0 && _is_valid_target(ip + size) && labels[ip + size] < 0) {
+					worklist.push_back(ip + size);
+				}
+				break;
+			}
+
+			entries[ip] = start;
+			compiled_instructions++;
+
+			if (next == NO_FALLTHROUGH) {
+				break;
+			}
+			if (labels[next] >= 0) {
+				_emit_branch(a.jmp(), next);
+				break;
+			}
+			ip = next;
+		}
+	}
+
+	if (compiled_instructions == 0) {
+		return nullptr;
+	}
+
+	for (uint32_t i = 0; i < fixups.size(); i++) {
+		a.bind(fixups[i].pos, labels[fixups[i].target]);
+	}
+
+	static size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t alloc_size = (a.size() + page_size - 1) & ~(page_size - 1);
+
+	void *memory = mmap(nullptr, alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ERR_FAIL_COND_V_MSG(memory == MAP_FAILED, nullptr, "Unable to allocate memory for GDScript native code.");
+	memcpy(memory, a.buffer.ptr(), a.size());
+	if (mprotect(memory, alloc_size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(memory, alloc_size);
+		ERR_FAIL_V_MSG(nullptr, "Unable to make GDScript native code executable.");
+	}
+
+	GDScriptNativeCode *native = memnew(GDScriptNativeCode);
+	native->code = (uint8_t *)memory;
+	native->code_size = alloc_size;
+	native->entry_func = (GDScriptNativeCode::EntryFunc)memory;
+	native->entries = entries;
+	native->compiled_instructions = compiled_instructions;
+	native->uses_members = uses_members;
+	return native;
+}
+
+GDScriptNativeCode::~GDScriptNativeCode() {
+	if (code) {
+		munmap(code, code_size);
+	}
+}
+
+void GDScriptJIT::initialize() {
+	enabled = GLOBAL_DEF("gdscript/jit/enabled", false);
+	hot_threshold = MAX(1, int(GLOBAL_DEF("gdscript/jit/hot_threshold", 1000)));
+	ProjectSettings::get_singleton()->set_custom_property_info("gdscript/jit/hot_threshold", PropertyInfo(Variant::INT, "gdscript/jit/hot_threshold", PROPERTY_HINT_RANGE, "1,100000,1,or_greater"));
+}
+
+GDScriptNativeCode *GDScriptJIT::compile(const GDScriptFunction *p_function) {
+	GDScriptJITCompiler compiler(p_function);
+	GDScriptNativeCode *native = compiler.compile();
+	if (native) {
+		print_verbose(vformat("GDScript: Compiled %d instructions of hot function '%s' to native code.", native->get_compiled_instruction_count(), p_function->get_name()));
+	}
+	return native;
+}
+
+#endif // GDSCRIPT_JIT_ENABLED
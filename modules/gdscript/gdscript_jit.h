@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  gdscript_jit.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_JIT_H
+#define GDSCRIPT_JIT_H
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// The native tier emits x86-64 machine code following the System V calling
+// convention, so it is only available on Linux (and the BSDs) for now.
+#if defined(__x86_64__) && (defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__))
+#define GDSCRIPT_JIT_ENABLED
+#endif
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+class GDScriptFunction;
+
+// Native code generated for the typed parts of a GDScriptFunction.
+// It shares the stack layout with the interpreter, so execution can move
+// between both tiers at any instruction boundary: native code runs until it
+// reaches an instruction it can't handle and returns its address, which the
+// interpreter then executes.
+class GDScriptNativeCode {
+	friend class GDScriptJITCompiler;
+
+public:
+	struct Frame {
+		Variant *stack = nullptr;
+		Variant *constants = nullptr;
+		Variant *members = nullptr;
+		int *line = nullptr;
+	};
+
+private:
+	typedef int (*EntryFunc)(Frame *p_frame, const void *p_entry);
+
+	uint8_t *code = nullptr;
+	size_t code_size = 0;
+	EntryFunc entry_func = nullptr;
+	LocalVector<int32_t> entries; // Offset in code for each compiled bytecode address, -1 otherwise.
+	uint32_t compiled_instructions = 0;
+	bool uses_members = false;
+
+public:
+	_FORCE_INLINE_ bool needs_instance() const { return uses_members; }
+	_FORCE_INLINE_ uint32_t get_compiled_instruction_count() const { return compiled_instructions; }
+
+	_FORCE_INLINE_ const void *get_entry(int p_ip) const {
+		int32_t offset = entries[p_ip];
+		return offset < 0 ? nullptr : code + offset;
+	}
+
+	// Returns the bytecode address where the interpreter has to resume.
+	_FORCE_INLINE_ int run(Frame *p_frame, const void *p_entry) const {
+		return entry_func(p_frame, p_entry);
+	}
+
+	~GDScriptNativeCode();
+};
+
+class GDScriptJIT {
+	static bool enabled;
+	static uint32_t hot_threshold;
+
+public:
+	static void initialize();
+
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	_FORCE_INLINE_ static uint32_t get_hot_threshold() { return hot_threshold; }
+
+	// Override the project settings, e.g. to test the native tier.
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static void set_hot_threshold(uint32_t p_threshold) { hot_threshold = MAX(p_threshold, 1u); }
+
+	static GDScriptNativeCode *compile(const GDScriptFunction *p_function);
+};
+
+#endif // GDSCRIPT_JIT_ENABLED
+
+#endif // GDSCRIPT_JIT_H
@@ -232,6 +232,27 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_ADD_INT,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,              \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,              \
+		&&OPCODE_OPERATOR_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_LESS_INT,                  \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,            \
+		&&OPCODE_OPERATOR_GREATER_INT,               \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,         \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                 \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,            \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,            \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,              \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,          \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,             \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,       \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,               \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,    \
 		&&OPCODE_EXTENDS_TEST,                       \
 		&&OPCODE_IS_BUILTIN,                         \
 		&&OPCODE_SET_KEYED,                          \
@@ -480,6 +501,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	MemoryTagScope memory_tag_scope(Memory::TAG_SCRIPTS);
+
 	r_err.error = Callable::CallError::CALL_OK;
 
 	Variant retvalue;
@@ -640,6 +663,45 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 #endif
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	// Hot functions run their typed instructions as native code, which hands
+	// control back here for anything else. Stepping and profiling need the
+	// interpreter to see every instruction, so they disable the native tier.
+	bool native_allowed = GDScriptJIT::is_enabled() && !EngineDebugger::is_active();
+#ifdef DEBUG_ENABLED
+	native_allowed = native_allowed && !GDScriptLanguage::get_singleton()->profiling;
+#endif
+	GDScriptNativeCode *native = nullptr;
+	GDScriptNativeCode::Frame native_frame;
+	native_frame.stack = stack;
+	native_frame.constants = _constants_ptr;
+	native_frame.line = &line;
+
+	// The members are only looked up once native code needs them, as ptrw() is not free.
+#define GET_NATIVE_CODE()                                                            \
+	{                                                                                \
+		native = _get_native_code();                                                 \
+		if (native && native->needs_instance()) {                                    \
+			if (p_instance) {                                                        \
+				native_frame.members = p_instance->members.ptrw();                   \
+			} else {                                                                 \
+				native = nullptr;                                                    \
+				native_allowed = false;                                              \
+			}                                                                        \
+		}                                                                            \
+	}
+
+	if (native_allowed) {
+		GET_NATIVE_CODE();
+		if (native) {
+			const void *entry = native->get_entry(ip);
+			if (entry) {
+				ip = native->run(&native_frame, entry);
+			}
+		}
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip] & INSTR_MASK;
@@ -706,6 +768,39 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_name, m_left_type, m_right_type, m_ret_type, m_op)                                                              \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                                                          \
+		CHECK_SPACE(4);                                                                                                                         \
+		GET_INSTRUCTION_ARG(a, 0);                                                                                                              \
+		GET_INSTRUCTION_ARG(b, 1);                                                                                                              \
+		GET_INSTRUCTION_ARG(dst, 2);                                                                                                            \
+		*VariantInternal::OP_GET_##m_ret_type(dst) = *VariantInternal::OP_GET_##m_left_type(a) m_op *VariantInternal::OP_GET_##m_right_type(b); \
+		ip += 4;                                                                                                                                \
+	}                                                                                                                                           \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, INT, INT, INT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, INT, INT, INT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, INT, INT, INT, *);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, INT, INT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, INT, INT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_INT, INT, INT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, INT, INT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, INT, INT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, INT, INT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, FLOAT, FLOAT, FLOAT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, FLOAT, FLOAT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, FLOAT, FLOAT, FLOAT, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, FLOAT, FLOAT, FLOAT, /);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, FLOAT, FLOAT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, FLOAT, FLOAT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, VECTOR3, VECTOR3, VECTOR3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, VECTOR3, VECTOR3, VECTOR3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, VECTOR3, VECTOR3, VECTOR3, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, VECTOR3, FLOAT, VECTOR3, *);
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 				CHECK_SPACE(4);
 
@@ -2331,6 +2426,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				int to = _code_ptr[ip + 1];
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
+#ifdef GDSCRIPT_JIT_ENABLED
+				// Loop back edges count towards hotness and enter native code mid-call.
+				if (to < ip && native_allowed) {
+					if (!native) {
+						GET_NATIVE_CODE();
+					}
+					const void *entry = native ? native->get_entry(to) : nullptr;
+					if (entry) {
+						ip = native->run(&native_frame, entry);
+						DISPATCH_OPCODE;
+					}
+				}
+#endif
 				ip = to;
 			}
 			DISPATCH_OPCODE;
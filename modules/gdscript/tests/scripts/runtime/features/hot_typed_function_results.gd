@@ -0,0 +1,30 @@
+# Typed functions called often enough get compiled to native code,
+# their results must not change when that happens.
+
+var total := 0
+
+func accumulate(count: int) -> int:
+	var sum := 0
+	for i in count:
+		sum += i * 2
+		if sum > 1000:
+			sum -= 1000
+	total += sum
+	return sum
+
+func lerp_steps(steps: int) -> Vector2:
+	var v := Vector2()
+	var i := 0
+	while i < steps:
+		v = v.lerp(Vector2(10, 20), 0.5)
+		i += 1
+	return v
+
+func test():
+	var checksum := 0
+	for n in 2000:
+		checksum += accumulate(n % 50)
+	print(checksum)
+	print(total)
+	print(lerp_steps(3))
+	print(lerp_steps(5000).is_equal_approx(Vector2(10, 20)))
@@ -0,0 +1,17 @@
+func test():
+	var a: int = 7
+	var b: int = -3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= 7, " ", a > b, " ", b >= a)
+
+	var x: float = 1.5
+	var y: float = 0.25
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x < y, " ", x <= 1.5, " ", x > y, " ", y >= x)
+
+	var nan_value: float = NAN
+	print(nan_value < x, " ", nan_value <= x, " ", nan_value > x, " ", nan_value >= x)
+
+	var u: Vector3 = Vector3(1, 2, 3)
+	var v: Vector3 = Vector3(0.5, -1, 2)
+	print(u + v, " ", u - v, " ", u * v, " ", u * 2.0)
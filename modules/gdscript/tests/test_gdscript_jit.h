@@ -0,0 +1,135 @@
+/*************************************************************************/
+/*  test_gdscript_jit.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_GDSCRIPT_JIT_H
+#define TEST_GDSCRIPT_JIT_H
+
+#include "../gdscript.h"
+#include "../gdscript_jit.h"
+
+#include "tests/test_macros.h"
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Typed functions compiled to native code give the same results as the interpreter") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+var total := 0
+
+func accumulate(count: int) -> int:
+	var sum := 0
+	for i in count:
+		sum += i * 2
+		if sum > 1000:
+			sum -= 1000
+	total += sum
+	return sum
+
+func lerp_steps(steps: int) -> Vector2:
+	var v := Vector2()
+	var i := 0
+	while i < steps:
+		v = v.lerp(Vector2(10, 20), 0.5)
+		i += 1
+	return v
+
+func halve(value: float, times: int) -> float:
+	for i in times:
+		value *= 0.5
+	return value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	const char *function_names[] = { "accumulate", "lerp_steps", "halve" };
+	for (const char *name : function_names) {
+		GDScriptFunction *function = gdscript->get_member_functions().get(StringName(name));
+		GDScriptNativeCode *native = GDScriptJIT::compile(function);
+		REQUIRE_MESSAGE(native != nullptr, vformat("'%s' should compile to native code.", name));
+		CHECK_MESSAGE(native->get_compiled_instruction_count() > 0, vformat("'%s' should have instructions compiled to native code.", name));
+		memdelete(native);
+	}
+
+	const bool was_enabled = GDScriptJIT::is_enabled();
+	const uint32_t hot_threshold = GDScriptJIT::get_hot_threshold();
+
+	struct Results {
+		Vector<Variant> values;
+
+		void run(Ref<RefCounted> p_object) {
+			for (int i = 0; i < 200; i++) {
+				values.push_back(p_object->call("accumulate", i % 50));
+			}
+			values.push_back(p_object->get("total"));
+			values.push_back(p_object->call("lerp_steps", 3));
+			values.push_back(p_object->call("lerp_steps", 500));
+			values.push_back(p_object->call("halve", 1000.0, 7));
+		}
+	};
+
+	GDScriptJIT::set_enabled(false);
+	Ref<RefCounted> interpreted_object = memnew(RefCounted);
+	interpreted_object->set_script(gdscript);
+	Results interpreted;
+	interpreted.run(interpreted_object);
+
+	// Functions get compiled on their first calls, then switch to native code in the middle of their loops.
+	GDScriptJIT::set_enabled(true);
+	GDScriptJIT::set_hot_threshold(1);
+	Ref<RefCounted> native_object = memnew(RefCounted);
+	native_object->set_script(gdscript);
+	Results native;
+	native.run(native_object);
+
+	GDScriptJIT::set_enabled(was_enabled);
+	GDScriptJIT::set_hot_threshold(hot_threshold);
+
+	for (const char *name : function_names) {
+		CHECK_MESSAGE(gdscript->get_member_functions().get(StringName(name))->has_native_code(), vformat("'%s' should have run as native code.", name));
+	}
+	REQUIRE(native.values.size() == interpreted.values.size());
+	bool all_equal = true;
+	for (int i = 0; i < native.values.size(); i++) {
+		all_equal = all_equal && native.values[i] == interpreted.values[i];
+	}
+	CHECK_MESSAGE(all_equal, "Native code should give the same results as the interpreter.");
+}
+
+} // namespace GDScriptTests
+
+#endif // GDSCRIPT_JIT_ENABLED
+
+#endif // TEST_GDSCRIPT_JIT_H
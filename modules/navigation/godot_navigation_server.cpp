@@ -112,6 +112,7 @@
 GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
+	_wait_for_path_queries();
 	flush_queries();
 }
 
@@ -217,6 +218,63 @@ Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin,
 	return map->get_path(p_origin, p_destination, p_optimize, p_navigation_layers);
 }
 
+void GodotNavigationServer::map_request_paths(RID p_map, const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers, const Callable &p_callback) const {
+	ERR_FAIL_COND(!map_owner.owns(p_map));
+	ERR_FAIL_COND_MSG(p_origins.size() != p_destinations.size(), "The number of origins and destinations of the path queries must match.");
+
+	GodotNavigationServer *mut_this = const_cast<GodotNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	PathQueryBatch batch;
+	batch.map = p_map;
+	batch.callback = p_callback;
+	batch.first = pending_path_queries.size();
+	batch.count = p_origins.size();
+	mut_this->pending_path_query_batches.push_back(batch);
+
+	for (int i = 0; i < p_origins.size(); i++) {
+		PathQuery query;
+		query.origin = p_origins[i];
+		query.destination = p_destinations[i];
+		query.optimize = p_optimize;
+		query.navigation_layers = p_navigation_layers;
+		mut_this->pending_path_queries.push_back(query);
+	}
+}
+
+COMMAND_2(map_set_use_hierarchical_paths, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_use_hierarchical_paths(p_enabled);
+}
+
+bool GodotNavigationServer::map_get_use_hierarchical_paths(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, false);
+
+	return map->get_use_hierarchical_paths();
+}
+
+Array GodotNavigationServer::map_get_region_corridor(RID p_map, Vector3 p_origin, Vector3 p_destination, uint32_t p_navigation_layers) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, Array());
+
+	Array corridor;
+	Vector<RID> regions = map->get_region_corridor(p_origin, p_destination, p_navigation_layers);
+	for (int i = 0; i < regions.size(); i++) {
+		corridor.push_back(regions[i]);
+	}
+	return corridor;
+}
+
+Vector<Vector3> GodotNavigationServer::map_get_partial_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, int p_max_regions) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
+
+	return map->get_partial_path(p_origin, p_destination, p_optimize, p_navigation_layers, p_max_regions);
+}
+
 Vector3 GodotNavigationServer::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector3());
@@ -610,26 +668,46 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND(map == nullptr);
 
+	_wait_for_path_queries();
 	flush_queries();
 
 	map->sync();
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_NAVIGATION);
+
+	// The path queries started by the last process read the maps, so they
+	// have to be done before any command modifies them.
+	_dispatch_path_queries();
+
 	flush_queries();
 
 	if (!active) {
+		// The maps aren't synchronized, so the requested paths are resolved on their current state.
+		_start_path_queries();
 		return;
 	}
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(operations_mutex);
+
+	region_count = 0;
+	polygon_count = 0;
+	edge_connection_count = 0;
+	sync_time_usec = 0;
+
 	for (uint32_t i(0); i < active_maps.size(); i++) {
 		active_maps[i]->sync();
 		active_maps[i]->step(p_delta_time);
 		active_maps[i]->dispatch_callbacks();
 
+		region_count += active_maps[i]->get_regions().size();
+		polygon_count += active_maps[i]->get_polygon_count();
+		edge_connection_count += active_maps[i]->get_edge_connection_count();
+		sync_time_usec += active_maps[i]->get_sync_time_usec();
+
 		// Emit a signal if a map changed.
 		const uint32_t new_map_update_id = active_maps[i]->get_map_update_id();
 		if (new_map_update_id != active_maps_update_id[i]) {
@@ -637,6 +715,96 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 			active_maps_update_id[i] = new_map_update_id;
 		}
 	}
+
+	_start_path_queries();
+}
+
+void GodotNavigationServer::_resolve_path_query(uint32_t p_index, PathQuery *p_queries) {
+	PathQuery &query = p_queries[p_index];
+	if (query.map) {
+		query.path = query.map->get_path(query.origin, query.destination, query.optimize, query.navigation_layers);
+	}
+}
+
+void GodotNavigationServer::_start_path_queries() {
+	MutexLock lock(path_queries_mutex);
+	if (pending_path_query_batches.is_empty()) {
+		return;
+	}
+
+	running_path_queries = pending_path_queries;
+	running_path_query_batches = pending_path_query_batches;
+	pending_path_queries.clear();
+	pending_path_query_batches.clear();
+
+	// Maps freed since the request give empty paths.
+	for (uint32_t i = 0; i < running_path_query_batches.size(); i++) {
+		const PathQueryBatch &batch = running_path_query_batches[i];
+		NavMap *map = map_owner.get_or_null(batch.map);
+		for (uint32_t j = batch.first; j < batch.first + batch.count; j++) {
+			running_path_queries[j].map = map;
+		}
+	}
+
+	if (running_path_queries.size() > 0) {
+		path_query_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_resolve_path_query, running_path_queries.ptr(), running_path_queries.size(), -1, true, SNAME("NavigationPathQueries"));
+		path_queries_running = true;
+	}
+}
+
+void GodotNavigationServer::_wait_for_path_queries() {
+	if (path_queries_running) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(path_query_group_task);
+		path_queries_running = false;
+	}
+}
+
+void GodotNavigationServer::_dispatch_path_queries() {
+	_wait_for_path_queries();
+
+	for (uint32_t i = 0; i < running_path_query_batches.size(); i++) {
+		const PathQueryBatch &batch = running_path_query_batches[i];
+
+		Array paths;
+		paths.resize(batch.count);
+		for (uint32_t j = 0; j < batch.count; j++) {
+			paths[j] = running_path_queries[batch.first + j].path;
+		}
+
+		Variant paths_arg = paths;
+		const Variant *args[1] = { &paths_arg };
+		Variant ret;
+		Callable::CallError ce;
+		batch.callback.callp(args, 1, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling path query callback: " + Variant::get_callable_error_text(batch.callback, args, 1, ce));
+		}
+	}
+
+	running_path_queries.clear();
+	running_path_query_batches.clear();
+}
+
+int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
+	switch (p_info) {
+		case INFO_ACTIVE_MAPS: {
+			return active_maps.size();
+		} break;
+		case INFO_REGION_COUNT: {
+			return region_count;
+		} break;
+		case INFO_POLYGON_COUNT: {
+			return polygon_count;
+		} break;
+		case INFO_EDGE_CONNECTION_COUNT: {
+			return edge_connection_count;
+		} break;
+		case INFO_SYNC_TIME: {
+			return sync_time_usec;
+		} break;
+	}
+
+	return 0;
 }
 
 #undef COMMAND_1
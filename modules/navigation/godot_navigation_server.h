@@ -79,6 +79,40 @@ class GodotNavigationServer : public NavigationServer3D {
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
 
+	struct PathQuery {
+		NavMap *map = nullptr;
+		Vector3 origin;
+		Vector3 destination;
+		bool optimize = false;
+		uint32_t navigation_layers = 1;
+		Vector<Vector3> path;
+	};
+
+	struct PathQueryBatch {
+		RID map;
+		Callable callback;
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	/// Path queries requested since the last process.
+	Mutex path_queries_mutex;
+	LocalVector<PathQuery> pending_path_queries;
+	LocalVector<PathQueryBatch> pending_path_query_batches;
+
+	/// Path queries being resolved on the worker threads. The maps are only
+	/// modified during process, so they stay the same until they are done.
+	LocalVector<PathQuery> running_path_queries;
+	LocalVector<PathQueryBatch> running_path_query_batches;
+	WorkerThreadPool::GroupID path_query_group_task = 0;
+	bool path_queries_running = false;
+
+	// Stats of the last process.
+	int region_count = 0;
+	int polygon_count = 0;
+	int edge_connection_count = 0;
+	uint64_t sync_time_usec = 0;
+
 public:
 	GodotNavigationServer();
 	virtual ~GodotNavigationServer();
@@ -101,6 +135,12 @@ public:
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
+	virtual void map_request_paths(RID p_map, const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers, const Callable &p_callback) const override;
+
+	COMMAND_2(map_set_use_hierarchical_paths, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_paths(RID p_map) const override;
+	virtual Array map_get_region_corridor(RID p_map, Vector3 p_origin, Vector3 p_destination, uint32_t p_navigation_layers = 1) const override;
+	virtual Vector<Vector3> map_get_partial_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1, int p_max_regions = 2) const override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const override;
@@ -153,6 +193,14 @@ public:
 
 	void flush_queries();
 	virtual void process(real_t p_delta_time) override;
+
+	virtual int get_process_info(ProcessInfo p_info) const override;
+
+private:
+	void _resolve_path_query(uint32_t p_index, PathQuery *p_queries);
+	void _start_path_queries();
+	void _wait_for_path_queries();
+	void _dispatch_path_queries();
 };
 
 #undef COMMAND_1
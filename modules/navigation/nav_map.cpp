@@ -31,6 +31,9 @@
 #include "nav_map.h"
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/sort_array.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
 #include <algorithm>
@@ -52,6 +55,10 @@ void NavMap::set_edge_connection_margin(float p_edge_connection_margin) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_paths(bool p_enabled) {
+	use_hierarchical_paths = p_enabled;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -65,57 +72,304 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
+bool NavMap::_find_path_polygons(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers, const gd::Polygon *&r_begin_poly, Vector3 &r_begin_point, const gd::Polygon *&r_end_poly, Vector3 &r_end_point) const {
+	r_begin_poly = nullptr;
+	r_end_poly = nullptr;
+	real_t begin_ds = 1e20;
+	real_t end_ds = 1e20;
+	// Find the initial poly and the end poly on this map.
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		const NavRegion *region = regions[r];
+
+		// Only consider the polygons in regions with compatible layers.
+		if ((p_navigation_layers & region->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		Vector3 normal;
+		region->get_polygon_bvh().get_closest_point(p_origin, begin_ds, r_begin_point, normal, r_begin_poly);
+		region->get_polygon_bvh().get_closest_point(p_destination, end_ds, r_end_point, normal, r_end_poly);
+	}
+
+	return r_begin_poly && r_end_poly;
+}
+
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	// Find the start poly and the end poly on this map.
 	const gd::Polygon *begin_poly = nullptr;
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
 
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+	// Check for trivial cases
+	if (!_find_path_polygons(p_origin, p_destination, p_navigation_layers, begin_poly, begin_point, end_poly, end_point)) {
+		return Vector<Vector3>();
+	}
+	if (begin_poly == end_poly) {
+		Vector<Vector3> path;
+		path.resize(2);
+		path.write[0] = begin_point;
+		path.write[1] = end_point;
+		return path;
+	}
+
+	// For the paths going through other regions, plan which regions to cross on the coarse graph first,
+	// so the polygon search doesn't explore the regions away from the way.
+	if (use_hierarchical_paths && begin_poly->owner != end_poly->owner) {
+		LocalVector<const NavRegion *> corridor;
+		LocalVector<Vector3> exits;
+		if (_find_region_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, corridor, exits) && corridor.size() > 2) {
+			Vector<Vector3> path = _get_polygon_path(begin_poly, begin_point, end_poly, end_point, p_destination, p_optimize, p_navigation_layers, &corridor);
+			if (!path.is_empty()) {
+				return path;
+			}
+		}
+	}
+
+	return _get_polygon_path(begin_poly, begin_point, end_poly, end_point, p_destination, p_optimize, p_navigation_layers, nullptr);
+}
+
+Vector<Vector3> NavMap::get_partial_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, int p_max_regions) const {
+	ERR_FAIL_COND_V(p_max_regions < 1, Vector<Vector3>());
+
+	const gd::Polygon *begin_poly = nullptr;
+	const gd::Polygon *end_poly = nullptr;
+	Vector3 begin_point;
+	Vector3 end_point;
+	if (!_find_path_polygons(p_origin, p_destination, p_navigation_layers, begin_poly, begin_point, end_poly, end_point)) {
+		return Vector<Vector3>();
+	}
+
+	LocalVector<const NavRegion *> corridor;
+	LocalVector<Vector3> exits;
+	if (begin_poly->owner == end_poly->owner || !_find_region_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, corridor, exits)) {
+		return get_path(p_origin, p_destination, p_optimize, p_navigation_layers);
+	}
+
+	if (corridor.size() > uint32_t(p_max_regions)) {
+		// Stop at the portal leaving the last region, the rest of the way is refined by a later query.
+		const Vector3 exit = exits[p_max_regions - 1];
+		corridor.resize(p_max_regions);
+
+		real_t exit_ds = 1e20;
+		Vector3 normal;
+		end_poly = nullptr;
+		corridor[p_max_regions - 1]->get_polygon_bvh().get_closest_point(exit, exit_ds, end_point, normal, end_poly);
+		ERR_FAIL_COND_V(!end_poly, Vector<Vector3>());
+
+		if (begin_poly == end_poly) {
+			Vector<Vector3> path;
+			path.resize(2);
+			path.write[0] = begin_point;
+			path.write[1] = end_point;
+			return path;
+		}
+
+		return _get_polygon_path(begin_poly, begin_point, end_poly, end_point, exit, p_optimize, p_navigation_layers, &corridor);
+	}
+
+	return _get_polygon_path(begin_poly, begin_point, end_poly, end_point, p_destination, p_optimize, p_navigation_layers, &corridor);
+}
+
+Vector<RID> NavMap::get_region_corridor(Vector3 p_origin, Vector3 p_destination, uint32_t p_navigation_layers) const {
+	const gd::Polygon *begin_poly = nullptr;
+	const gd::Polygon *end_poly = nullptr;
+	Vector3 begin_point;
+	Vector3 end_point;
+	if (!_find_path_polygons(p_origin, p_destination, p_navigation_layers, begin_poly, begin_point, end_poly, end_point)) {
+		return Vector<RID>();
+	}
+
+	LocalVector<const NavRegion *> corridor;
+	LocalVector<Vector3> exits;
+	if (!_find_region_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, corridor, exits)) {
+		return Vector<RID>();
+	}
+
+	Vector<RID> rids;
+	rids.resize(corridor.size());
+	for (uint32_t i = 0; i < corridor.size(); i++) {
+		rids.write[i] = corridor[i]->get_self();
+	}
+	return rids;
+}
+
+bool NavMap::_find_region_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<const NavRegion *> &r_corridor, LocalVector<Vector3> &r_exits) const {
+	r_corridor.clear();
+	r_exits.clear();
+
+	const NavRegion *begin_region = p_begin_poly->owner;
+	const NavRegion *end_region = p_end_poly->owner;
+	if (begin_region == end_region) {
+		r_corridor.push_back(begin_region);
+		return true;
+	}
+
+	HashMap<const NavRegion *, uint32_t>::ConstIterator begin_offset = region_portal_offsets.find(begin_region);
+	HashMap<const NavRegion *, uint32_t>::ConstIterator end_offset = region_portal_offsets.find(end_region);
+	if (!begin_offset || !end_offset) {
+		return false;
+	}
+
+	// A* over the portals, from the begin point to a virtual goal node reached through the portals of the end region.
+	const uint32_t node_count = portal_regions.size();
+	const uint32_t goal = node_count;
+
+	LocalVector<real_t> costs;
+	LocalVector<int> previous;
+	costs.resize(node_count + 1);
+	previous.resize(node_count + 1);
+	for (uint32_t i = 0; i <= node_count; i++) {
+		costs[i] = 1e30;
+		previous[i] = -1;
+	}
+
+	LocalVector<real_t> begin_costs;
+	LocalVector<real_t> end_costs;
+	begin_region->get_portal_costs_from(p_begin_poly, p_begin_point, begin_costs);
+	end_region->get_portal_costs_from(p_end_poly, p_end_point, end_costs);
+
+	LocalVector<gd::SearchEntry> open_list;
+	SortArray<gd::SearchEntry, gd::SearchEntryCmp> sorter;
+
+	for (uint32_t i = 0; i < begin_costs.size(); i++) {
+		gd::SearchEntry entry;
+		entry.id = begin_offset->value + i;
+		entry.cost = begin_costs[i] + begin_region->get_portals()[i].position.distance_to(p_end_point);
+		costs[entry.id] = begin_costs[i];
+		open_list.push_back(entry);
+		sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+	}
+
+	bool found = false;
+	while (!open_list.is_empty()) {
+		const gd::SearchEntry entry = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.resize(open_list.size() - 1);
+
+		if (entry.id == goal) {
+			found = true;
+			break;
+		}
+
+		const NavRegion *region = portal_regions[entry.id];
+		const uint32_t region_offset = region_portal_offsets[region];
+		const uint32_t portal_index = entry.id - region_offset;
+		const real_t cost = costs[entry.id];
+		if (entry.cost > cost + region->get_portals()[portal_index].position.distance_to(p_end_point)) {
+			// Already reached with a lower cost.
 			continue;
 		}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+		// Moves to other nodes: the goal, the other portals of the region, and the portal on the other side.
+		uint32_t next_count = 0;
+		uint32_t next_ids[3];
+		real_t next_costs[3];
+
+		if (region == end_region) {
+			next_ids[next_count] = goal;
+			next_costs[next_count++] = cost + end_costs[portal_index];
+		}
 
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
+		const int link = portal_links[entry.id];
+		if (link != -1 && (p_navigation_layers & portal_regions[link]->get_navigation_layers()) != 0) {
+			next_ids[next_count] = link;
+			next_costs[next_count++] = cost + region->get_portals()[portal_index].position.distance_to(portal_regions[link]->get_portals()[link - region_portal_offsets[portal_regions[link]]].position) + portal_regions[link]->get_enter_cost();
+		}
+
+		const uint32_t region_portal_count = region->get_portals().size();
+		for (uint32_t i = 0; i < region_portal_count + next_count; i++) {
+			uint32_t next_id;
+			real_t next_cost;
+			if (i < next_count) {
+				next_id = next_ids[i];
+				next_cost = next_costs[i];
+			} else {
+				const uint32_t other_portal = i - next_count;
+				if (other_portal == portal_index) {
+					continue;
+				}
+				next_id = region_offset + other_portal;
+				next_cost = cost + region->get_portal_cost(portal_index, other_portal);
 			}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
+			if (next_cost >= costs[next_id]) {
+				continue;
+			}
+			costs[next_id] = next_cost;
+			previous[next_id] = entry.id;
+
+			gd::SearchEntry next;
+			next.id = next_id;
+			next.cost = next_cost;
+			if (next_id != goal) {
+				const NavRegion *next_region = portal_regions[next_id];
+				next.cost += next_region->get_portals()[next_id - region_portal_offsets[next_region]].position.distance_to(p_end_point);
 			}
+			open_list.push_back(next);
+			sorter.push_heap(0, open_list.size() - 1, 0, next, open_list.ptr());
 		}
 	}
 
-	// Check for trivial cases
-	if (!begin_poly || !end_poly) {
-		return Vector<Vector3>();
+	if (!found) {
+		return false;
 	}
-	if (begin_poly == end_poly) {
-		Vector<Vector3> path;
-		path.resize(2);
-		path.write[0] = begin_point;
-		path.write[1] = end_point;
-		return path;
+
+	// Walk back from the goal, each change of region is a portal crossed.
+	LocalVector<uint32_t> nodes;
+	for (int node = previous[goal]; node != -1; node = previous[node]) {
+		nodes.push_back(node);
+	}
+	nodes.invert();
+
+	r_corridor.push_back(begin_region);
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		const NavRegion *region = portal_regions[nodes[i]];
+		if (region != r_corridor[r_corridor.size() - 1]) {
+			const uint32_t exit_node = nodes[i - 1];
+			const NavRegion *exit_region = portal_regions[exit_node];
+			r_exits.push_back(exit_region->get_portals()[exit_node - region_portal_offsets[exit_region]].position);
+			r_corridor.push_back(region);
+		}
+	}
+
+	return true;
+}
+
+void NavMap::_update_portal_graph() {
+	region_portal_offsets.clear();
+	portal_regions.clear();
+	portal_links.clear();
+
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		region_portal_offsets.insert(regions[r], portal_regions.size());
+		for (uint32_t i = 0; i < regions[r]->get_portals().size(); i++) {
+			portal_regions.push_back(regions[r]);
+		}
 	}
 
+	portal_links.resize(portal_regions.size());
+	for (uint32_t i = 0; i < portal_regions.size(); i++) {
+		const NavRegion *region = portal_regions[i];
+		const gd::Portal &portal = region->get_portals()[i - region_portal_offsets[region]];
+
+		portal_links[i] = -1;
+		HashMap<const NavRegion *, uint32_t>::Iterator neighbour_offset = region_portal_offsets.find(portal.neighbour);
+		if (neighbour_offset) {
+			int link = portal.neighbour->find_portal(region);
+			if (link != -1) {
+				portal_links[i] = neighbour_offset->value + link;
+			}
+		}
+	}
+}
+
+Vector<Vector3> NavMap::_get_polygon_path(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, const LocalVector<const NavRegion *> *p_corridor) const {
+	const gd::Polygon *begin_poly = p_begin_poly;
+	const gd::Polygon *end_poly = p_end_poly;
+	const Vector3 begin_point = p_begin_point;
+	Vector3 end_point = p_end_point;
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
 	navigation_polys.reserve(polygons.size() * 0.75);
@@ -128,6 +382,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
 
+	// The regions of the corridor, as a set since they are checked for each connection.
+	HashSet<const NavRegion *> corridor_regions;
+	if (p_corridor) {
+		for (uint32_t i = 0; i < p_corridor->size(); i++) {
+			corridor_regions.insert((*p_corridor)[i]);
+		}
+	}
+
 	// List of polygon IDs to visit.
 	List<uint32_t> to_visit;
 	to_visit.push_back(0);
@@ -158,6 +420,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Stay in the regions of the corridor found by the hierarchical search.
+				if (p_corridor && !corridor_regions.has(connection.polygon->owner)) {
+					continue;
+				}
+
 				float region_enter_cost = 0.0;
 				float region_travel_cost = least_cost_poly->poly->owner->get_travel_cost();
 
@@ -216,7 +483,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = 1e20;
+			float end_d = 1e20;
 			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
 				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
@@ -375,49 +642,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
 	real_t closest_point_d = 1e20;
 
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
+	// The point where the segment crosses the polygons, closest to its start.
+	bool collided = false;
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		if (regions[r]->get_polygon_bvh().intersect_segment(p_from, p_to, closest_point_d, closest_point)) {
+			collided = true;
 		}
+	}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
+	if (collided || p_use_collision) {
+		return closest_point;
+	}
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
-		}
+	// Otherwise, the point of the polygon edges closest to the segment.
+	closest_point_d = 1e20;
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		regions[r]->get_polygon_bvh().get_closest_point_to_segment(p_from, p_to, closest_point_d, closest_point);
 	}
 
 	return closest_point;
@@ -441,22 +684,14 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = 1e20;
+	const gd::Polygon *closest_poly = nullptr;
 
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		regions[r]->get_polygon_bvh().get_closest_point(p_point, closest_point_ds, result.point, result.normal, closest_poly);
+	}
+
+	if (closest_poly) {
+		result.owner = closest_poly->owner->get_self();
 	}
 
 	return result;
@@ -464,14 +699,15 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	regions_changed = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index != -1) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		changed_region_bounds.push_back(p_region->get_bounds());
+		regions_changed = true;
 	}
 }
 
@@ -511,85 +747,72 @@ void NavMap::remove_agent_as_controlled(RvoAgent *agent) {
 	}
 }
 
-void NavMap::sync() {
-	// Check if we need to update the links.
-	if (regenerate_polygons) {
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			regions[r]->scratch_polygons();
-		}
-		regenerate_links = true;
+static _FORCE_INLINE_ gd::EdgeKey _get_edge_key(const gd::Edge::Connection &p_edge) {
+	const gd::Polygon *poly = p_edge.polygon;
+	return gd::EdgeKey(poly->points[p_edge.edge].key, poly->points[(p_edge.edge + 1) % poly->points.size()].key);
+}
+
+void NavMap::sync_region(uint32_t p_index, NavRegion **p_regions) {
+	p_regions[p_index]->sync();
+}
+
+void NavMap::match_region_edges(uint32_t p_index, NavRegion **p_regions) {
+	NavRegion *region = p_regions[p_index];
+	const LocalVector<gd::Edge::Connection> &free_edges = region->get_free_edges();
+
+	// Only the regions close enough can be connected to this one.
+	LocalVector<NavRegion *> &neighbours = link_neighbours[p_index];
+	neighbours.clear();
+	if (free_edges.is_empty()) {
+		return;
 	}
 
+	const AABB link_bounds = region->get_bounds().grow(MAX(edge_connection_margin, cell_size));
 	for (uint32_t r = 0; r < regions.size(); r++) {
-		if (regions[r]->sync()) {
-			regenerate_links = true;
+		if (regions[r] != region && !regions[r]->get_free_edges().is_empty() && link_bounds.intersects(regions[r]->get_bounds())) {
+			neighbours.push_back(regions[r]);
 		}
 	}
 
-	if (regenerate_links) {
-		// Remove regions connections.
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			regions[r]->get_connections().clear();
-		}
+	// Flag the edges shared with a polygon of another region, they are never connected to near edges.
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::EdgeKey ek = _get_edge_key(free_edges[i]);
 
-		// Resize the polygon count.
-		int count = 0;
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			count += regions[r]->get_polygons().size();
+		bool matched = false;
+		for (uint32_t n = 0; n < neighbours.size() && !matched; n++) {
+			matched = neighbours[n]->find_free_edge(ek) != -1;
 		}
-		polygons.resize(count);
-
-		// Copy all region polygons in the map.
-		count = 0;
-		for (uint32_t r = 0; r < regions.size(); r++) {
-			const LocalVector<gd::Polygon> &polygons_source = regions[r]->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
-			}
-			count += regions[r]->get_polygons().size();
-		}
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (uint32_t poly_id = 0; poly_id < polygons.size(); poly_id++) {
-			gd::Polygon &poly(polygons[poly_id]);
-
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+		region->set_free_edge_matched(i, matched);
+	}
+}
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
+void NavMap::link_region_edges(uint32_t p_index, NavRegion **p_regions) {
+	NavRegion *region = p_regions[p_index];
+	const LocalVector<gd::Edge::Connection> &free_edges = region->get_free_edges();
+	const LocalVector<NavRegion *> &neighbours = link_neighbours[p_index];
+
+	// Each region only writes the connections of its own edges, the ones of
+	// its neighbours are linked by their own task, or didn't change.
+	region->get_connections().clear();
+	uint32_t connection_count = 0;
+
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::Edge::Connection &free_edge = free_edges[i];
+		Vector<gd::Edge::Connection> &edge_connections = free_edge.polygon->edges[free_edge.edge].connections;
+		edge_connections.clear();
+
+		if (region->is_free_edge_matched(i)) {
+			// Connect edge that are shared with polygons of other regions.
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			const gd::EdgeKey ek = _get_edge_key(free_edge);
+			for (uint32_t n = 0; n < neighbours.size(); n++) {
+				int other_edge_index = neighbours[n]->find_free_edge(ek);
+				if (other_edge_index != -1) {
+					edge_connections.push_back(neighbours[n]->get_free_edges()[other_edge_index]);
 				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
-				}
-			}
-		}
-
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				free_edges.push_back(E.value[0]);
 			}
+			connection_count += edge_connections.size();
+			continue;
 		}
 
 		// Find the compatible near edges.
@@ -599,17 +822,18 @@ void NavMap::sync() {
 		// to be connected, create new polygons to remove that small gap is
 		// not really useful and would result in wasteful computation during
 		// connection, integration and path finding.
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+		for (uint32_t n = 0; n < neighbours.size(); n++) {
+			const LocalVector<gd::Edge::Connection> &other_edges = neighbours[n]->get_free_edges();
+
+			for (uint32_t j = 0; j < other_edges.size(); j++) {
+				if (neighbours[n]->is_free_edge_matched(j)) {
 					continue;
 				}
 
+				const gd::Edge::Connection &other_edge = other_edges[j];
 				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
 				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
 
@@ -648,12 +872,104 @@ void NavMap::sync() {
 				gd::Edge::Connection new_connection = other_edge;
 				new_connection.pathway_start = (self1 + other1) / 2.0;
 				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+				edge_connections.push_back(new_connection);
+				connection_count++;
 
 				// Add the connection to the region_connection map.
-				free_edge.polygon->owner->get_connections().push_back(new_connection);
+				region->get_connections().push_back(new_connection);
+			}
+		}
+	}
+
+	region->set_external_connection_count(connection_count);
+
+	// The portals to the neighbours come from the connections just made.
+	region->update_portals();
+}
+
+void NavMap::sync() {
+	const uint64_t sync_begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Check if we need to update the links.
+	if (regenerate_polygons) {
+		for (uint32_t r = 0; r < regions.size(); r++) {
+			regions[r]->scratch_polygons();
+		}
+		regenerate_links = true;
+	}
+
+	// Rebuild the polygons of the changed regions, each one on its own thread.
+	// Both where they were and where they are now are areas where the connections need to be updated.
+	sync_regions.clear();
+	for (uint32_t r = 0; r < regions.size(); r++) {
+		if (regions[r]->is_dirty()) {
+			sync_regions.push_back(regions[r]);
+			if (!regions[r]->get_polygons().is_empty()) {
+				changed_region_bounds.push_back(regions[r]->get_bounds());
+			}
+		}
+	}
+
+	if (sync_regions.size() > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::sync_region, sync_regions.ptr(), sync_regions.size(), -1, true, SNAME("NavigationMapRegions"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t r = 0; r < sync_regions.size(); r++) {
+			if (!sync_regions[r]->get_polygons().is_empty()) {
+				changed_region_bounds.push_back(sync_regions[r]->get_bounds());
+			}
+		}
+	}
+
+	// Only the regions around a change need to be connected again, as the
+	// edges of the others can't reach the polygons that changed.
+	link_regions.clear();
+	if (regenerate_links) {
+		link_regions = regions;
+	} else if (changed_region_bounds.size() > 0) {
+		const real_t link_margin = MAX(edge_connection_margin, cell_size);
+		for (uint32_t r = 0; r < regions.size(); r++) {
+			const AABB link_bounds = regions[r]->get_bounds().grow(link_margin);
+			for (uint32_t b = 0; b < changed_region_bounds.size(); b++) {
+				if (link_bounds.intersects(changed_region_bounds[b])) {
+					link_regions.push_back(regions[r]);
+					break;
+				}
 			}
 		}
+	}
+
+	if (link_regions.size() > 0) {
+		// All the shared edges have to be known before connecting the near ones, so it's done in two passes.
+		link_neighbours.resize(link_regions.size());
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::match_region_edges, link_regions.ptr(), link_regions.size(), -1, true, SNAME("NavigationMapEdgeMatching"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::link_region_edges, link_regions.ptr(), link_regions.size(), -1, true, SNAME("NavigationMapEdgeLinking"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	if (regions_changed || sync_regions.size() > 0 || link_regions.size() > 0) {
+		// Collect the polygons of all the regions in the map.
+		uint32_t count = 0;
+		for (uint32_t r = 0; r < regions.size(); r++) {
+			count += regions[r]->get_polygons().size();
+		}
+		polygons.resize(count);
+
+		count = 0;
+		edge_connection_count = 0;
+		for (uint32_t r = 0; r < regions.size(); r++) {
+			const LocalVector<gd::Polygon> &polygons_source = regions[r]->get_polygons();
+			for (uint32_t n = 0; n < polygons_source.size(); n++) {
+				polygons[count + n] = &polygons_source[n];
+			}
+			count += polygons_source.size();
+			edge_connection_count += regions[r]->get_edge_connection_count();
+		}
+
+		_update_portal_graph();
 
 		// Update the update ID.
 		map_update_id = (map_update_id + 1) % 9999999;
@@ -672,7 +988,11 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	regions_changed = false;
 	agents_dirty = false;
+	changed_region_bounds.clear();
+
+	sync_time_usec = OS::get_singleton()->get_ticks_usec() - sync_begin_usec;
 }
 
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
@@ -58,10 +58,31 @@ class NavMap : public NavRid {
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
 
+	/// Search the graph of the region portals first for the paths crossing
+	/// several regions, then only the polygons of the regions on the way.
+	bool use_hierarchical_paths = false;
+
 	LocalVector<NavRegion *> regions;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Map polygons, owned by the regions.
+	LocalVector<const gd::Polygon *> polygons;
+
+	/// Where the regions removed or changed since the last sync were, as
+	/// their neighbours have to be connected again.
+	LocalVector<AABB> changed_region_bounds;
+	bool regions_changed = false;
+
+	/// Coarse graph of the map, each portal of each region is a node.
+	/// The nodes of a region are contiguous, starting at its offset.
+	HashMap<const NavRegion *, uint32_t> region_portal_offsets;
+	LocalVector<const NavRegion *> portal_regions;
+	/// The portal of the neighbour region leading back, -1 if there is none.
+	LocalVector<int> portal_links;
+
+	/// Regions processed by the worker threads during the sync.
+	LocalVector<NavRegion *> sync_regions;
+	LocalVector<NavRegion *> link_regions;
+	LocalVector<LocalVector<NavRegion *>> link_neighbours;
 
 	/// Rvo world
 	RVO::KdTree rvo;
@@ -81,6 +102,10 @@ class NavMap : public NavRid {
 	/// Change the id each time the map is updated.
 	uint32_t map_update_id = 0;
 
+	/// Stats of the last sync.
+	uint32_t edge_connection_count = 0;
+	uint64_t sync_time_usec = 0;
+
 public:
 	NavMap();
 	~NavMap();
@@ -100,9 +125,16 @@ public:
 		return edge_connection_margin;
 	}
 
+	void set_use_hierarchical_paths(bool p_enabled);
+	bool get_use_hierarchical_paths() const {
+		return use_hierarchical_paths;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
+	Vector<Vector3> get_partial_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, int p_max_regions) const;
+	Vector<RID> get_region_corridor(Vector3 p_origin, Vector3 p_destination, uint32_t p_navigation_layers) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -129,12 +161,30 @@ public:
 		return map_update_id;
 	}
 
+	uint32_t get_polygon_count() const {
+		return polygons.size();
+	}
+	uint32_t get_edge_connection_count() const {
+		return edge_connection_count;
+	}
+	uint64_t get_sync_time_usec() const {
+		return sync_time_usec;
+	}
+
 	void sync();
 	void step(real_t p_deltatime);
 	void dispatch_callbacks();
 
 private:
+	bool _find_path_polygons(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers, const gd::Polygon *&r_begin_poly, Vector3 &r_begin_point, const gd::Polygon *&r_end_poly, Vector3 &r_end_point) const;
+	bool _find_region_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<const NavRegion *> &r_corridor, LocalVector<Vector3> &r_exits) const;
+	Vector<Vector3> _get_polygon_path(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, const LocalVector<const NavRegion *> *p_corridor) const;
+	void _update_portal_graph();
+
 	void compute_single_step(uint32_t index, RvoAgent **agent);
+	void sync_region(uint32_t p_index, NavRegion **p_regions);
+	void match_region_edges(uint32_t p_index, NavRegion **p_regions);
+	void link_region_edges(uint32_t p_index, NavRegion **p_regions);
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
 
@@ -0,0 +1,288 @@
+/*************************************************************************/
+/*  nav_polygon_bvh.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+struct _NavPolygonCenterCmp {
+	const Vector3 *centers = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return centers[p_a][axis] < centers[p_b][axis];
+	}
+};
+
+int NavPolygonBVH::_build(const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers, uint32_t p_from, uint32_t p_count, int p_depth) {
+	if (p_depth > max_depth) {
+		max_depth = p_depth;
+	}
+
+	int index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB aabb = p_aabbs[polygon_indices[p_from]];
+	AABB center_aabb(p_centers[polygon_indices[p_from]], Vector3());
+	for (uint32_t i = 1; i < p_count; i++) {
+		aabb.merge_with(p_aabbs[polygon_indices[p_from + i]]);
+		center_aabb.expand_to(p_centers[polygon_indices[p_from + i]]);
+	}
+	nodes[index].aabb = aabb;
+
+	if (p_count <= MAX_LEAF_POLYGONS) {
+		nodes[index].first = p_from;
+		nodes[index].count = p_count;
+		return index;
+	}
+
+	// Split at the median along the axis where the polygons are the most spread.
+	SortArray<uint32_t, _NavPolygonCenterCmp> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = center_aabb.get_longest_axis_index();
+	sorter.nth_element(0, p_count, p_count / 2, &polygon_indices[p_from]);
+
+	int left = _build(p_aabbs, p_centers, p_from, p_count / 2, p_depth + 1);
+	int right = _build(p_aabbs, p_centers, p_from + p_count / 2, p_count - p_count / 2, p_depth + 1);
+	nodes[index].left = left;
+	nodes[index].right = right;
+
+	return index;
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<AABB> aabbs;
+	LocalVector<Vector3> centers;
+	aabbs.resize(p_polygons.size());
+	centers.resize(p_polygons.size());
+	polygon_indices.reserve(p_polygons.size());
+
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		if (p.points.size() < 3) {
+			continue;
+		}
+
+		AABB aabb(p.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < p.points.size(); j++) {
+			aabb.expand_to(p.points[j].pos);
+		}
+		aabbs[i] = aabb;
+		centers[i] = aabb.get_center();
+		polygon_indices.push_back(i);
+	}
+
+	if (polygon_indices.is_empty()) {
+		return;
+	}
+
+	polygons = p_polygons.ptr();
+	nodes.reserve(polygon_indices.size() / 2 + 1);
+	_build(aabbs, centers, 0, polygon_indices.size(), 0);
+}
+
+void NavPolygonBVH::clear() {
+	polygons = nullptr;
+	nodes.clear();
+	polygon_indices.clear();
+	max_depth = 0;
+}
+
+real_t NavPolygonBVH::get_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	const Vector3 closest(CLAMP(p_point.x, p_aabb.position.x, end.x), CLAMP(p_point.y, p_aabb.position.y, end.y), CLAMP(p_point.z, p_aabb.position.z, end.z));
+	return closest.distance_squared_to(p_point);
+}
+
+real_t NavPolygonBVH::get_distance_squared(const AABB &p_aabb, const AABB &p_other) {
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t gap = MAX(p_aabb.position[i] - (p_other.position[i] + p_other.size[i]), p_other.position[i] - (p_aabb.position[i] + p_aabb.size[i]));
+		if (gap > 0.0) {
+			distance_squared += gap * gap;
+		}
+	}
+	return distance_squared;
+}
+
+bool NavPolygonBVH::get_closest_point(const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point, Vector3 &r_normal, const gd::Polygon *&r_polygon) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 2));
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	bool found = false;
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (get_distance_squared(node.aabb, p_point) >= r_distance_squared) {
+			continue;
+		}
+
+		if (node.left == -1) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const gd::Polygon &p = polygons[polygon_indices[i]];
+
+				// For each face check the distance to the point.
+				for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+					const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					const Vector3 inters = f.get_closest_point_to(p_point);
+					const real_t ds = inters.distance_squared_to(p_point);
+					if (ds < r_distance_squared) {
+						r_distance_squared = ds;
+						r_point = inters;
+						r_normal = f.get_plane().normal;
+						r_polygon = &p;
+						found = true;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Visit the closest child first, it's the most likely to shrink the search.
+		int near = node.left;
+		int far = node.right;
+		if (get_distance_squared(nodes[far].aabb, p_point) < get_distance_squared(nodes[near].aabb, p_point)) {
+			SWAP(near, far);
+		}
+		stack[stack_size++] = far;
+		stack[stack_size++] = near;
+	}
+
+	return found;
+}
+
+bool NavPolygonBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 2));
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	bool found = false;
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.left == -1) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const gd::Polygon &p = polygons[polygon_indices[i]];
+
+				// For each face check the intersection with the segment.
+				for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+					const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					Vector3 inters;
+					if (f.intersects_segment(p_from, p_to, &inters)) {
+						const real_t d = p_from.distance_to(inters);
+						if (d < r_distance) {
+							r_distance = d;
+							r_point = inters;
+							found = true;
+						}
+					}
+				}
+			}
+			continue;
+		}
+
+		stack[stack_size++] = node.right;
+		stack[stack_size++] = node.left;
+	}
+
+	return found;
+}
+
+bool NavPolygonBVH::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 2));
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	bool found = false;
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (get_distance_squared(node.aabb, segment_aabb) >= r_distance * r_distance) {
+			continue;
+		}
+
+		if (node.left == -1) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const gd::Polygon &p = polygons[polygon_indices[i]];
+
+				// For each edge check the distance to the segment.
+				for (uint32_t point_id = 0; point_id < p.points.size(); point_id++) {
+					Vector3 a, b;
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p.points[point_id].pos,
+							p.points[(point_id + 1) % p.points.size()].pos,
+							a,
+							b);
+
+					const real_t d = a.distance_to(b);
+					if (d < r_distance) {
+						r_distance = d;
+						r_point = b;
+						found = true;
+					}
+				}
+			}
+			continue;
+		}
+
+		int near = node.left;
+		int far = node.right;
+		if (get_distance_squared(nodes[far].aabb, segment_aabb) < get_distance_squared(nodes[near].aabb, segment_aabb)) {
+			SWAP(near, far);
+		}
+		stack[stack_size++] = far;
+		stack[stack_size++] = near;
+	}
+
+	return found;
+}
@@ -0,0 +1,76 @@
+/*************************************************************************/
+/*  nav_polygon_bvh.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "core/math/aabb.h"
+#include "nav_utils.h"
+
+/// Static bounding volume hierarchy over the polygons of a region, rebuilt
+/// each time the region polygons change. It lets the closest point queries
+/// skip the polygons that can't be closer than the best one found so far.
+class NavPolygonBVH {
+	enum {
+		MAX_LEAF_POLYGONS = 4,
+	};
+
+	struct Node {
+		AABB aabb;
+		/// Children nodes, -1 for the leaves.
+		int left = -1;
+		int right = -1;
+		/// Range of `polygon_indices` in the leaves.
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	const gd::Polygon *polygons = nullptr;
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> polygon_indices;
+	int max_depth = 0;
+
+	int _build(const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers, uint32_t p_from, uint32_t p_count, int p_depth);
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	/// The queries only update the results when they find something closer
+	/// than the given distance, so they can be chained over several regions.
+	bool get_closest_point(const Vector3 &p_point, real_t &r_distance_squared, Vector3 &r_point, Vector3 &r_normal, const gd::Polygon *&r_polygon) const;
+	bool intersect_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+	bool get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance, Vector3 &r_point) const;
+
+	static real_t get_distance_squared(const AABB &p_aabb, const Vector3 &p_point);
+	static real_t get_distance_squared(const AABB &p_aabb, const AABB &p_other);
+};
+
+#endif // NAV_POLYGON_BVH_H
@@ -32,6 +32,8 @@
 
 #include "nav_map.h"
 
+#include "core/templates/sort_array.h"
+
 void NavRegion::set_map(NavMap *p_map) {
 	map = p_map;
 	polygons_dirty = true;
@@ -77,6 +79,158 @@ Vector3 NavRegion::get_connection_pathway_end(int p_connection_id) const {
 	return connections[p_connection_id].pathway_end;
 }
 
+int NavRegion::find_free_edge(const gd::EdgeKey &p_key) const {
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::ConstIterator E = free_edge_indices.find(p_key);
+	return E ? int(E->value) : -1;
+}
+
+int NavRegion::find_portal(const NavRegion *p_neighbour) const {
+	for (uint32_t i = 0; i < portals.size(); i++) {
+		if (portals[i].neighbour == p_neighbour) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void NavRegion::update_portals() {
+	portals.clear();
+	portal_costs.clear();
+
+	// Group the connections to other regions per neighbour.
+	LocalVector<uint32_t> connection_counts;
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::Polygon *poly = free_edges[i].polygon;
+		const Vector<gd::Edge::Connection> &edge_connections = poly->edges[free_edges[i].edge].connections;
+
+		for (int j = 0; j < edge_connections.size(); j++) {
+			const gd::Edge::Connection &connection = edge_connections[j];
+
+			int portal_index = find_portal(connection.polygon->owner);
+			if (portal_index == -1) {
+				portal_index = portals.size();
+				portals.push_back(gd::Portal());
+				portals[portal_index].neighbour = connection.polygon->owner;
+				connection_counts.push_back(0);
+			}
+
+			gd::Portal &portal = portals[portal_index];
+			portal.position += (connection.pathway_start + connection.pathway_end) * 0.5;
+			connection_counts[portal_index]++;
+			if (portal.polygons.find(poly) == -1) {
+				portal.polygons.push_back(poly);
+			}
+		}
+	}
+
+	if (portals.is_empty()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < portals.size(); i++) {
+		portals[i].position /= connection_counts[i];
+	}
+
+	// Cost of going through this region from each portal to the others.
+	portal_costs.resize(portals.size() * portals.size());
+
+	LocalVector<gd::SearchEntry> seeds;
+	LocalVector<real_t> polygon_costs;
+	LocalVector<real_t> costs;
+	for (uint32_t i = 0; i < portals.size(); i++) {
+		const gd::Portal &portal = portals[i];
+
+		seeds.clear();
+		for (uint32_t j = 0; j < portal.polygons.size(); j++) {
+			gd::SearchEntry seed;
+			seed.id = portal.polygons[j] - polygons.ptr();
+			seed.cost = portal.position.distance_to(portal.polygons[j]->center) * travel_cost;
+			seeds.push_back(seed);
+		}
+
+		_get_polygon_costs(seeds, polygon_costs);
+		_get_portal_costs(polygon_costs, costs);
+		for (uint32_t j = 0; j < portals.size(); j++) {
+			portal_costs[i * portals.size() + j] = costs[j];
+		}
+	}
+}
+
+void NavRegion::get_portal_costs_from(const gd::Polygon *p_polygon, const Vector3 &p_point, LocalVector<real_t> &r_costs) const {
+	LocalVector<gd::SearchEntry> seeds;
+	gd::SearchEntry seed;
+	seed.id = p_polygon - polygons.ptr();
+	seed.cost = p_point.distance_to(p_polygon->center) * travel_cost;
+	seeds.push_back(seed);
+
+	LocalVector<real_t> polygon_costs;
+	_get_polygon_costs(seeds, polygon_costs);
+	_get_portal_costs(polygon_costs, r_costs);
+}
+
+void NavRegion::_get_polygon_costs(const LocalVector<gd::SearchEntry> &p_seeds, LocalVector<real_t> &r_costs) const {
+	// Dijkstra over the polygon centers of this region.
+	r_costs.resize(polygons.size());
+	for (uint32_t i = 0; i < r_costs.size(); i++) {
+		r_costs[i] = 1e30;
+	}
+
+	LocalVector<gd::SearchEntry> open_list;
+	SortArray<gd::SearchEntry, gd::SearchEntryCmp> sorter;
+
+	for (uint32_t i = 0; i < p_seeds.size(); i++) {
+		if (p_seeds[i].cost < r_costs[p_seeds[i].id]) {
+			r_costs[p_seeds[i].id] = p_seeds[i].cost;
+			open_list.push_back(p_seeds[i]);
+			sorter.push_heap(0, open_list.size() - 1, 0, p_seeds[i], open_list.ptr());
+		}
+	}
+
+	while (!open_list.is_empty()) {
+		const gd::SearchEntry entry = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.resize(open_list.size() - 1);
+
+		if (entry.cost > r_costs[entry.id]) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		const gd::Polygon &poly = polygons[entry.id];
+		for (uint32_t i = 0; i < poly.edges.size(); i++) {
+			const Vector<gd::Edge::Connection> &edge_connections = poly.edges[i].connections;
+			for (int j = 0; j < edge_connections.size(); j++) {
+				const gd::Polygon *other_poly = edge_connections[j].polygon;
+				if (other_poly->owner != this) {
+					continue;
+				}
+
+				gd::SearchEntry next;
+				next.id = other_poly - polygons.ptr();
+				next.cost = entry.cost + poly.center.distance_to(other_poly->center) * travel_cost;
+				if (next.cost < r_costs[next.id]) {
+					r_costs[next.id] = next.cost;
+					open_list.push_back(next);
+					sorter.push_heap(0, open_list.size() - 1, 0, next, open_list.ptr());
+				}
+			}
+		}
+	}
+}
+
+void NavRegion::_get_portal_costs(const LocalVector<real_t> &p_polygon_costs, LocalVector<real_t> &r_costs) const {
+	r_costs.resize(portals.size());
+	for (uint32_t i = 0; i < portals.size(); i++) {
+		const gd::Portal &portal = portals[i];
+
+		r_costs[i] = 1e30;
+		for (uint32_t j = 0; j < portal.polygons.size(); j++) {
+			const real_t cost = p_polygon_costs[portal.polygons[j] - polygons.ptr()] + portal.polygons[j]->center.distance_to(portal.position) * travel_cost;
+			r_costs[i] = MIN(r_costs[i], cost);
+		}
+	}
+}
+
 bool NavRegion::sync() {
 	bool something_changed = polygons_dirty /* || something_dirty? */;
 
@@ -92,6 +246,16 @@ void NavRegion::update_polygons() {
 	polygons.clear();
 	polygons_dirty = false;
 
+	bounds = AABB();
+	polygon_bvh.clear();
+	free_edges.clear();
+	free_edge_indices.clear();
+	free_edges_matched.clear();
+	internal_connection_count = 0;
+	external_connection_count = 0;
+	portals.clear();
+	portal_costs.clear();
+
 	if (map == nullptr) {
 		return;
 	}
@@ -154,4 +318,61 @@ void NavRegion::update_polygons() {
 			p.center = center / float(mesh_poly.size());
 		}
 	}
+
+	update_internal_connections();
+	polygon_bvh.build(polygons);
+}
+
+void NavRegion::update_internal_connections() {
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> connections_by_key;
+	for (uint32_t poly_id = 0; poly_id < polygons.size(); poly_id++) {
+		gd::Polygon &poly(polygons[poly_id]);
+
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			if (poly_id == 0 && p == 0) {
+				bounds.position = poly.points[p].pos;
+			} else {
+				bounds.expand_to(poly.points[p].pos);
+			}
+
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			LocalVector<gd::Edge::Connection> &key_connections = connections_by_key[ek];
+			if (key_connections.size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				key_connections.push_back(new_connection);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+			}
+		}
+	}
+
+	for (const KeyValue<gd::EdgeKey, LocalVector<gd::Edge::Connection>> &E : connections_by_key) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			const gd::Edge::Connection &c1 = E.value[0];
+			const gd::Edge::Connection &c2 = E.value[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			internal_connection_count += 2;
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			free_edge_indices.insert(E.key, free_edges.size());
+			free_edges.push_back(E.value[0]);
+		}
+	}
+
+	free_edges_matched.resize(free_edges.size());
+	for (uint32_t i = 0; i < free_edges_matched.size(); i++) {
+		free_edges_matched[i] = false;
+	}
 }
@@ -33,6 +33,7 @@
 
 #include "scene/resources/navigation_mesh.h"
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -55,6 +56,28 @@ class NavRegion : public NavRid {
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
 
+	/// Bounds of the polygons, used by the map to find the regions that may connect to this one.
+	AABB bounds;
+
+	/// Spatial index of the polygons for the closest point queries.
+	NavPolygonBVH polygon_bvh;
+
+	/// The polygon edges not shared with another polygon of this region.
+	/// They are the only ones that can be connected to other regions.
+	LocalVector<gd::Edge::Connection> free_edges;
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> free_edge_indices;
+
+	/// Whether each free edge is shared with a polygon of another region.
+	LocalVector<bool> free_edges_matched;
+
+	uint32_t internal_connection_count = 0;
+	uint32_t external_connection_count = 0;
+
+	/// Portals to the neighbour regions, and the cost to go through this
+	/// region between each pair of them (row major).
+	LocalVector<gd::Portal> portals;
+	LocalVector<real_t> portal_costs;
+
 public:
 	NavRegion() {}
 
@@ -97,10 +120,57 @@ public:
 		return polygons;
 	}
 
+	bool is_dirty() const {
+		return polygons_dirty;
+	}
+
+	const AABB &get_bounds() const {
+		return bounds;
+	}
+
+	const NavPolygonBVH &get_polygon_bvh() const {
+		return polygon_bvh;
+	}
+
+	const LocalVector<gd::Edge::Connection> &get_free_edges() const {
+		return free_edges;
+	}
+	int find_free_edge(const gd::EdgeKey &p_key) const;
+
+	bool is_free_edge_matched(uint32_t p_free_edge) const {
+		return free_edges_matched[p_free_edge];
+	}
+	void set_free_edge_matched(uint32_t p_free_edge, bool p_matched) {
+		free_edges_matched[p_free_edge] = p_matched;
+	}
+
+	void set_external_connection_count(uint32_t p_count) {
+		external_connection_count = p_count;
+	}
+	uint32_t get_edge_connection_count() const {
+		return internal_connection_count + external_connection_count;
+	}
+
+	const LocalVector<gd::Portal> &get_portals() const {
+		return portals;
+	}
+	real_t get_portal_cost(uint32_t p_from, uint32_t p_to) const {
+		return portal_costs[p_from * portals.size() + p_to];
+	}
+	int find_portal(const NavRegion *p_neighbour) const;
+	void update_portals();
+
+	/// Travel cost from a point of one of the region polygons to each of its portals.
+	void get_portal_costs_from(const gd::Polygon *p_polygon, const Vector3 &p_point, LocalVector<real_t> &r_costs) const;
+
 	bool sync();
 
 private:
+	void _get_polygon_costs(const LocalVector<gd::SearchEntry> &p_seeds, LocalVector<real_t> &r_costs) const;
+	void _get_portal_costs(const LocalVector<real_t> &p_polygon_costs, LocalVector<real_t> &r_costs) const;
+
 	void update_polygons();
+	void update_internal_connections();
 };
 
 #endif // NAV_REGION_H
@@ -138,6 +138,29 @@ struct NavigationPoly {
 	}
 };
 
+/// A way from a region to one of its neighbours, the nodes of the coarse
+/// graph used by the hierarchical path finding.
+struct Portal {
+	NavRegion *neighbour = nullptr;
+	/// Middle of the connections to the neighbour.
+	Vector3 position;
+	/// The polygons of the region connected to the neighbour.
+	LocalVector<const Polygon *> polygons;
+};
+
+/// Open list entry of the graph searches.
+struct SearchEntry {
+	real_t cost = 0.0;
+	uint32_t id = 0;
+};
+
+struct SearchEntryCmp {
+	_FORCE_INLINE_ bool operator()(const SearchEntry &p_a, const SearchEntry &p_b) const {
+		// The heap puts the lowest cost first.
+		return p_a.cost > p_b.cost;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
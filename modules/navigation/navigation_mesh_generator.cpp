@@ -33,6 +33,7 @@
 #include "navigation_mesh_generator.h"
 
 #include "core/math/convex_hull.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -405,6 +406,71 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 	}
 }
 
+void NavigationMeshGenerator::_setup_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+	memset(&r_cfg, 0, sizeof(r_cfg));
+
+	r_cfg.cs = p_nav_mesh->get_cell_size();
+	r_cfg.ch = p_nav_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+	r_cfg.detailSampleDist = MAX(p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance(), 0.1f);
+	r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+
+	if (!Math::is_equal_approx((float)r_cfg.walkableHeight * r_cfg.ch, p_nav_mesh->get_agent_height())) {
+		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.walkableClimb * r_cfg.ch, p_nav_mesh->get_agent_max_climb())) {
+		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.walkableRadius * r_cfg.cs, p_nav_mesh->get_agent_radius())) {
+		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.maxEdgeLen * r_cfg.cs, p_nav_mesh->get_edge_max_length())) {
+		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.minRegionArea, p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size())) {
+		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.mergeRegionArea, p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size())) {
+		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.maxVertsPerPoly, p_nav_mesh->get_verts_per_poly())) {
+		WARN_PRINT("Property verts_per_poly is converted to int and loses precision.");
+	}
+	if (p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance() < 0.1f) {
+		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+	}
+}
+
+uint32_t NavigationMeshGenerator::_get_bake_settings_hash(Ref<NavigationMesh> p_nav_mesh) {
+	uint32_t h = hash_murmur3_one_float(p_nav_mesh->get_cell_size());
+	h = hash_murmur3_one_float(p_nav_mesh->get_cell_height(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_agent_height(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_agent_radius(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_agent_max_climb(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_agent_max_slope(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_region_min_size(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_region_merge_size(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_edge_max_length(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_edge_max_error(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_verts_per_poly(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_detail_sample_distance(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_detail_sample_max_error(), h);
+	h = hash_murmur3_one_32(p_nav_mesh->get_sample_partition_type(), h);
+	h = hash_murmur3_one_32(p_nav_mesh->get_filter_low_hanging_obstacles(), h);
+	h = hash_murmur3_one_32(p_nav_mesh->get_filter_ledge_spans(), h);
+	h = hash_murmur3_one_32(p_nav_mesh->get_filter_walkable_low_height_spans(), h);
+	h = hash_murmur3_one_float(p_nav_mesh->get_tile_size(), h);
+	return hash_fmix32(h);
+}
+
 void NavigationMeshGenerator::_build_recast_navigation_mesh(
 		Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -434,46 +500,7 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
 	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_nav_mesh->get_cell_size();
-	cfg.ch = p_nav_mesh->get_cell_height();
-	cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-	cfg.detailSampleDist = MAX(p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
-
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_nav_mesh->get_agent_height())) {
-		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_nav_mesh->get_agent_max_climb())) {
-		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_nav_mesh->get_agent_radius())) {
-		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_nav_mesh->get_edge_max_length())) {
-		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size())) {
-		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size())) {
-		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_nav_mesh->get_verts_per_poly())) {
-		WARN_PRINT("Property verts_per_poly is converted to int and loses precision.");
-	}
-	if (p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance() < 0.1f) {
-		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
-	}
+	_setup_recast_config(p_nav_mesh, cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -630,6 +657,306 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	detail_mesh = nullptr;
 }
 
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, TileBakeData *p_data) {
+	const LocalVector<int> &tile_triangles = p_data->triangles[p_index];
+	const AABB &bounds = p_data->bounds[p_index];
+	BakeTile &tile = p_data->results[p_index];
+
+	rcContext ctx;
+	rcConfig cfg = p_data->cfg;
+
+	// The border is baked too so the tile's walkable area matches its neighbours, then clipped away from the contours.
+	cfg.borderSize = cfg.walkableRadius + 3;
+	cfg.bmin[0] = bounds.position.x - cfg.borderSize * cfg.cs;
+	cfg.bmin[1] = bounds.position.y;
+	cfg.bmin[2] = bounds.position.z - cfg.borderSize * cfg.cs;
+	cfg.bmax[0] = bounds.position.x + bounds.size.x + cfg.borderSize * cfg.cs;
+	cfg.bmax[1] = bounds.position.y + bounds.size.y;
+	cfg.bmax[2] = bounds.position.z + bounds.size.z + cfg.borderSize * cfg.cs;
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	const int ntris = tile_triangles.size();
+	LocalVector<int> tris;
+	tris.resize(ntris * 3);
+	for (int i = 0; i < ntris; i++) {
+		const int *tri = &p_data->tris[tile_triangles[i] * 3];
+		tris[i * 3 + 0] = tri[0];
+		tris[i * 3 + 1] = tri[1];
+		tris[i * 3 + 2] = tri[2];
+	}
+
+	rcHeightfield *hf = rcAllocHeightfield();
+	ERR_FAIL_COND(!hf);
+	if (!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch)) {
+		rcFreeHeightField(hf);
+		ERR_FAIL_MSG("Failed to create the heightfield of a navigation mesh tile.");
+	}
+
+	{
+		LocalVector<unsigned char> tri_areas;
+		tri_areas.resize(ntris);
+		memset(tri_areas.ptr(), 0, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, p_data->verts, p_data->nverts, tris.ptr(), ntris, tri_areas.ptr());
+
+		if (!rcRasterizeTriangles(&ctx, p_data->verts, p_data->nverts, tris.ptr(), tri_areas.ptr(), ntris, *hf, cfg.walkableClimb)) {
+			rcFreeHeightField(hf);
+			ERR_FAIL_MSG("Failed to rasterize the triangles of a navigation mesh tile.");
+		}
+	}
+
+	if (p_data->filter_low_hanging_obstacles) {
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+	}
+	if (p_data->filter_ledge_spans) {
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+	}
+	if (p_data->filter_walkable_low_height_spans) {
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+	}
+
+	rcCompactHeightfield *chf = rcAllocCompactHeightfield();
+	bool built = chf && rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf);
+	rcFreeHeightField(hf);
+
+	built = built && rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf);
+	if (built) {
+		if (p_data->partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+			built = rcBuildDistanceField(&ctx, *chf) && rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea);
+		} else if (p_data->partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+			built = rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea);
+		} else {
+			built = rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea);
+		}
+	}
+
+	rcContourSet *cset = built ? rcAllocContourSet() : nullptr;
+	built = cset && rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset);
+
+	rcPolyMesh *poly_mesh = built ? rcAllocPolyMesh() : nullptr;
+	built = poly_mesh && rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh);
+
+	rcPolyMeshDetail *detail_mesh = built ? rcAllocPolyMeshDetail() : nullptr;
+	built = detail_mesh && rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh);
+
+	if (built) {
+		tile.vertices.resize(detail_mesh->nverts);
+		Vector3 *w = tile.vertices.ptrw();
+		for (int i = 0; i < detail_mesh->nverts; i++) {
+			const float *v = &detail_mesh->verts[i * 3];
+			w[i] = Vector3(v[0], v[1], v[2]);
+		}
+
+		for (int i = 0; i < detail_mesh->nmeshes; i++) {
+			const unsigned int *m = &detail_mesh->meshes[i * 4];
+			const unsigned int bverts = m[0];
+			const unsigned int btris = m[2];
+			const unsigned int mesh_ntris = m[3];
+			const unsigned char *mesh_tris = &detail_mesh->tris[btris * 4];
+			for (unsigned int j = 0; j < mesh_ntris; j++) {
+				// Polygon order in recast is opposite than godot's
+				tile.triangles.push_back((int)(bverts + mesh_tris[j * 4 + 0]));
+				tile.triangles.push_back((int)(bverts + mesh_tris[j * 4 + 2]));
+				tile.triangles.push_back((int)(bverts + mesh_tris[j * 4 + 1]));
+			}
+		}
+	}
+
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(poly_mesh);
+	rcFreePolyMeshDetail(detail_mesh);
+
+	ERR_FAIL_COND_MSG(!built, "Failed to bake a navigation mesh tile.");
+}
+
+void NavigationMeshGenerator::_build_tiled_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices) {
+	TileBakeData data;
+	_setup_recast_config(p_nav_mesh, data.cfg);
+	data.partition_type = p_nav_mesh->get_sample_partition_type();
+	data.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+	data.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+	data.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+	data.verts = p_vertices.ptr();
+	data.nverts = p_vertices.size() / 3;
+	data.tris = p_indices.ptr();
+	const int ntris = p_indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(data.verts, data.nverts, bmin, bmax);
+
+	AABB baking_aabb = p_nav_mesh->get_filter_baking_aabb();
+	if (!baking_aabb.has_no_volume()) {
+		baking_aabb.position += p_nav_mesh->get_filter_baking_aabb_offset();
+		for (int i = 0; i < 3; i++) {
+			bmin[i] = baking_aabb.position[i];
+			bmax[i] = baking_aabb.position[i] + baking_aabb.size[i];
+		}
+	}
+
+	// The tile grid is anchored to the origin, so a tile keeps its coordinates when the geometry elsewhere changes.
+	const int tile_cells = MAX(1, (int)Math::ceil(p_nav_mesh->get_tile_size() / data.cfg.cs));
+	const float tile_world_size = tile_cells * data.cfg.cs;
+	const float border = (data.cfg.walkableRadius + 3) * data.cfg.cs;
+
+	const Vector2i tile_min = Vector2i(Math::floor(bmin[0] / tile_world_size), Math::floor(bmin[2] / tile_world_size));
+	const Vector2i tile_max = Vector2i(Math::floor(bmax[0] / tile_world_size), Math::floor(bmax[2] / tile_world_size));
+	const Vector2i tile_count = tile_max - tile_min + Vector2i(1, 1);
+	ERR_FAIL_COND_MSG((int64_t)tile_count.x * tile_count.y > 1000000, "Too many navigation mesh tiles, increase the tile size.");
+
+	// Sort the triangles into the tiles they overlap, including the border of the tiles.
+	LocalVector<LocalVector<int>> tile_triangles;
+	tile_triangles.resize(tile_count.x * tile_count.y);
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &data.verts[data.tris[i * 3 + 0] * 3];
+		const float *v1 = &data.verts[data.tris[i * 3 + 1] * 3];
+		const float *v2 = &data.verts[data.tris[i * 3 + 2] * 3];
+		const float min_x = MIN(v0[0], MIN(v1[0], v2[0])) - border;
+		const float max_x = MAX(v0[0], MAX(v1[0], v2[0])) + border;
+		const float min_z = MIN(v0[2], MIN(v1[2], v2[2])) - border;
+		const float max_z = MAX(v0[2], MAX(v1[2], v2[2])) + border;
+
+		const int from_x = MAX(tile_min.x, (int)Math::floor(min_x / tile_world_size));
+		const int to_x = MIN(tile_max.x, (int)Math::floor(max_x / tile_world_size));
+		const int from_z = MAX(tile_min.y, (int)Math::floor(min_z / tile_world_size));
+		const int to_z = MIN(tile_max.y, (int)Math::floor(max_z / tile_world_size));
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				tile_triangles[(z - tile_min.y) * tile_count.x + (x - tile_min.x)].push_back(i);
+			}
+		}
+	}
+
+	TileCache cache;
+	const uint32_t settings_hash = _get_bake_settings_hash(p_nav_mesh);
+	{
+		MutexLock lock(tile_cache_mutex);
+
+		// Drop the caches of the navigation meshes freed since.
+		LocalVector<ObjectID> freed;
+		for (const KeyValue<ObjectID, TileCache> &E : tile_caches) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed.push_back(E.key);
+			}
+		}
+		for (uint32_t i = 0; i < freed.size(); i++) {
+			tile_caches.erase(freed[i]);
+		}
+
+		HashMap<ObjectID, TileCache>::Iterator E = tile_caches.find(p_nav_mesh->get_instance_id());
+		if (E && E->value.settings_hash == settings_hash) {
+			cache = E->value;
+		}
+	}
+	cache.settings_hash = settings_hash;
+
+	HashMap<Vector2i, BakeTile> tiles;
+	for (int z = 0; z < tile_count.y; z++) {
+		for (int x = 0; x < tile_count.x; x++) {
+			const LocalVector<int> &triangles = tile_triangles[z * tile_count.x + x];
+			if (triangles.is_empty()) {
+				continue;
+			}
+
+			// The height of a tile only depends on its own triangles, so it isn't affected by changes in other tiles.
+			float tile_bmin_y = bmax[1];
+			float tile_bmax_y = bmin[1];
+			for (uint32_t i = 0; i < triangles.size(); i++) {
+				for (int j = 0; j < 3; j++) {
+					const float y = data.verts[data.tris[triangles[i] * 3 + j] * 3 + 1];
+					tile_bmin_y = MIN(tile_bmin_y, y);
+					tile_bmax_y = MAX(tile_bmax_y, y);
+				}
+			}
+			// Snapped to the cell height so the spans of all the tiles share the same vertical grid.
+			tile_bmin_y = MAX(Math::floor(tile_bmin_y / data.cfg.ch) * data.cfg.ch, bmin[1]);
+			tile_bmax_y = MIN(tile_bmax_y, bmax[1]);
+			if (tile_bmin_y > tile_bmax_y) {
+				continue;
+			}
+
+			const Vector2i coords = tile_min + Vector2i(x, z);
+			AABB bounds;
+			bounds.position = Vector3(coords.x * tile_world_size, tile_bmin_y, coords.y * tile_world_size);
+			bounds.size = Vector3(tile_world_size, tile_bmax_y - tile_bmin_y, tile_world_size);
+			bounds.position.x = MAX(bounds.position.x, bmin[0]);
+			bounds.position.z = MAX(bounds.position.z, bmin[2]);
+			bounds.size.x = MIN((coords.x + 1) * tile_world_size, bmax[0]) - bounds.position.x;
+			bounds.size.z = MIN((coords.y + 1) * tile_world_size, bmax[2]) - bounds.position.z;
+
+			uint32_t geometry_hash = hash_murmur3_buffer(&bounds, sizeof(AABB));
+			for (uint32_t i = 0; i < triangles.size(); i++) {
+				for (int j = 0; j < 3; j++) {
+					geometry_hash = hash_murmur3_buffer(&data.verts[data.tris[triangles[i] * 3 + j] * 3], sizeof(float) * 3, geometry_hash);
+				}
+			}
+
+			HashMap<Vector2i, BakeTile>::Iterator cached = cache.tiles.find(coords);
+			if (cached && cached->value.geometry_hash == geometry_hash) {
+				tiles.insert(coords, cached->value);
+				continue;
+			}
+
+			data.coords.push_back(coords);
+			data.bounds.push_back(bounds);
+			data.triangles.push_back(triangles);
+
+			BakeTile tile;
+			tile.geometry_hash = geometry_hash;
+			data.results.push_back(tile);
+		}
+	}
+
+	if (!data.coords.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshGenerator::_bake_tile, &data, data.coords.size(), -1, true, SNAME("NavigationMeshBakeTiles"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < data.coords.size(); i++) {
+			tiles.insert(data.coords[i], data.results[i]);
+		}
+	}
+
+	cache.tiles = tiles;
+	{
+		MutexLock lock(tile_cache_mutex);
+		tile_caches[p_nav_mesh->get_instance_id()] = cache;
+	}
+
+	// Merge the tiles, welding the vertices shared by neighbouring tiles.
+	Vector<Vector3> nav_vertices;
+	HashMap<Vector3i, int> vertex_map;
+	for (const KeyValue<Vector2i, BakeTile> &E : tiles) {
+		const BakeTile &tile = E.value;
+		LocalVector<int> remap;
+		remap.resize(tile.vertices.size());
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			const Vector3 &v = tile.vertices[i];
+			const Vector3i key = Vector3i(Math::round(v.x / data.cfg.cs), Math::round(v.y / data.cfg.ch), Math::round(v.z / data.cfg.cs));
+			HashMap<Vector3i, int>::Iterator V = vertex_map.find(key);
+			if (V) {
+				remap[i] = V->value;
+			} else {
+				remap[i] = nav_vertices.size();
+				vertex_map.insert(key, remap[i]);
+				nav_vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < tile.triangles.size(); i += 3) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			nav_indices.write[0] = remap[tile.triangles[i + 0]];
+			nav_indices.write[1] = remap[tile.triangles[i + 1]];
+			nav_indices.write[2] = remap[tile.triangles[i + 2]];
+			if (nav_indices[0] == nav_indices[1] || nav_indices[1] == nav_indices[2] || nav_indices[0] == nav_indices[2]) {
+				// Collapsed by the welding.
+				continue;
+			}
+			p_nav_mesh->add_polygon(nav_indices);
+		}
+	}
+	p_nav_mesh->set_vertices(nav_vertices);
+}
+
 NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
 	return singleton;
 }
@@ -681,7 +1008,9 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 		_parse_geometry(navmesh_xform, E, vertices, indices, geometry_type, collision_mask, recurse_children);
 	}
 
-	if (vertices.size() > 0 && indices.size() > 0) {
+	if (vertices.size() > 0 && indices.size() > 0 && p_nav_mesh->get_tile_size() > 0) {
+		_build_tiled_navigation_mesh(p_nav_mesh, vertices, indices);
+	} else if (vertices.size() > 0 && indices.size() > 0) {
 		rcHeightfield *hf = nullptr;
 		rcCompactHeightfield *chf = nullptr;
 		rcContourSet *cset = nullptr;
@@ -732,6 +1061,9 @@ void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
 		p_nav_mesh->set_vertices(Vector<Vector3>());
+
+		MutexLock lock(tile_cache_mutex);
+		tile_caches.erase(p_nav_mesh->get_instance_id());
 	}
 }
 
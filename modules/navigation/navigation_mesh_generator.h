@@ -33,6 +33,9 @@
 
 #ifndef _3D_DISABLED
 
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "scene/3d/navigation_region_3d.h"
 
 #include <Recast.h>
@@ -46,6 +49,39 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	// Result of the bake of one tile, kept to skip the tile in the next bake if its geometry didn't change.
+	struct BakeTile {
+		uint32_t geometry_hash = 0;
+		Vector<Vector3> vertices;
+		Vector<int> triangles;
+	};
+
+	struct TileCache {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, BakeTile> tiles;
+	};
+
+	struct TileBakeData {
+		rcConfig cfg;
+		NavigationMesh::SamplePartitionType partition_type = NavigationMesh::SAMPLE_PARTITION_WATERSHED;
+		bool filter_low_hanging_obstacles = false;
+		bool filter_ledge_spans = false;
+		bool filter_walkable_low_height_spans = false;
+		const float *verts = nullptr;
+		int nverts = 0;
+		const int *tris = nullptr;
+		LocalVector<Vector2i> coords;
+		LocalVector<AABB> bounds;
+		LocalVector<LocalVector<int>> triangles;
+		LocalVector<BakeTile> results;
+	};
+
+	Mutex tile_cache_mutex;
+	HashMap<ObjectID, TileCache> tile_caches;
+
+	void _bake_tile(uint32_t p_index, TileBakeData *p_data);
+	void _build_tiled_navigation_mesh(Ref<NavigationMesh> p_nav_mesh, const Vector<float> &p_vertices, const Vector<int> &p_indices);
+
 protected:
 	static void _bind_methods();
 
@@ -55,6 +91,8 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
 	static void _parse_geometry(const Transform3D &p_navmesh_transform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, NavigationMesh::ParsedGeometryType p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
+	static void _setup_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+	static uint32_t _get_bake_settings_hash(Ref<NavigationMesh> p_nav_mesh);
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
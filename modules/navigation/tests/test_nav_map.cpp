@@ -0,0 +1,219 @@
+/*************************************************************************/
+/*  test_nav_map.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_nav_map.h"
+
+#include "modules/navigation/nav_map.h"
+#include "modules/navigation/nav_region.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavMap {
+
+Ref<NavigationMesh> make_grid_mesh(int p_size, const Vector<Vector2i> &p_holes) {
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+
+	Ref<NavigationMesh> mesh;
+	mesh.instantiate();
+	mesh->set_vertices(vertices);
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			if (p_holes.has(Vector2i(x, z))) {
+				continue;
+			}
+			int i = z * (p_size + 1) + x;
+			mesh->add_polygon(Vector<int>{ i, i + 1, i + p_size + 2, i + p_size + 1 });
+		}
+	}
+	return mesh;
+}
+
+void add_region(NavMap &p_map, NavRegion &p_region, const Ref<NavigationMesh> &p_mesh, const Vector3 &p_origin) {
+	p_region.set_mesh(p_mesh);
+	p_region.set_transform(Transform3D(Basis(), p_origin));
+	p_region.set_map(&p_map);
+	p_map.add_region(&p_region);
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+// Lists the edge connections of the given regions, in an order that doesn't depend on
+// the order of the regions in the map nor on the order the connections were made in.
+static Vector<String> get_connections(const LocalVector<NavRegion *> &p_regions) {
+	Vector<String> connections;
+	for (uint32_t r = 0; r < p_regions.size(); r++) {
+		const LocalVector<gd::Polygon> &polygons = p_regions[r]->get_polygons();
+		for (uint32_t p = 0; p < polygons.size(); p++) {
+			for (uint32_t e = 0; e < polygons[p].edges.size(); e++) {
+				const Vector<gd::Edge::Connection> &edge_connections = polygons[p].edges[e].connections;
+				for (int c = 0; c < edge_connections.size(); c++) {
+					const gd::Edge::Connection &connection = edge_connections[c];
+					const NavRegion *other_region = connection.polygon->owner;
+					connections.push_back(vformat("%d:%d:%d -> ", r, p, e) +
+							vformat("%d:%d:%d ", p_regions.find(connection.polygon->owner), int(connection.polygon - other_region->get_polygons().ptr()), connection.edge) +
+							String(connection.pathway_start) + " " + String(connection.pathway_end));
+				}
+			}
+		}
+		connections.push_back(vformat("%d: %d region connections", r, p_regions[r]->get_connections_count()));
+	}
+	connections.sort();
+	return connections;
+}
+
+void test_incremental_sync() {
+	Ref<NavigationMesh> grid = make_grid_mesh(4);
+	Ref<NavigationMesh> grid_with_holes = make_grid_mesh(4, { Vector2i(1, 1), Vector2i(2, 1), Vector2i(2, 2) });
+
+	NavMap map;
+	// Large enough to connect the regions 0.3 apart.
+	map.set_edge_connection_margin(0.5);
+
+	NavRegion regions[5];
+	add_region(map, regions[0], grid, Vector3(0, 0, 0));
+	// Shares its edges with the first region.
+	add_region(map, regions[1], grid, Vector3(4, 0, 0));
+	// Connected to the first region through near edges.
+	add_region(map, regions[2], grid, Vector3(0, 0, 4.3));
+	add_region(map, regions[3], grid_with_holes, Vector3(4, 0, 4));
+	map.sync();
+	REQUIRE(map.get_polygon_count() == 16 * 3 + 13);
+
+	// Move a region away from the others, then replace another one.
+	regions[3].set_transform(Transform3D(Basis(), Vector3(8, 0, 0)));
+	map.sync();
+
+	map.remove_region(&regions[1]);
+	regions[1].set_map(nullptr);
+	add_region(map, regions[4], grid_with_holes, Vector3(4, 0, 0));
+	map.sync();
+
+	NavMap rebuilt_map;
+	rebuilt_map.set_edge_connection_margin(0.5);
+
+	NavRegion rebuilt_regions[4];
+	add_region(rebuilt_map, rebuilt_regions[0], grid, Vector3(0, 0, 0));
+	add_region(rebuilt_map, rebuilt_regions[1], grid, Vector3(0, 0, 4.3));
+	add_region(rebuilt_map, rebuilt_regions[2], grid_with_holes, Vector3(8, 0, 0));
+	add_region(rebuilt_map, rebuilt_regions[3], grid_with_holes, Vector3(4, 0, 0));
+	rebuilt_map.sync();
+
+	CHECK(map.get_polygon_count() == rebuilt_map.get_polygon_count());
+	CHECK(map.get_edge_connection_count() == rebuilt_map.get_edge_connection_count());
+
+	LocalVector<NavRegion *> synced_list;
+	synced_list.push_back(&regions[0]);
+	synced_list.push_back(&regions[2]);
+	synced_list.push_back(&regions[3]);
+	synced_list.push_back(&regions[4]);
+	LocalVector<NavRegion *> rebuilt_list;
+	for (int i = 0; i < 4; i++) {
+		rebuilt_list.push_back(&rebuilt_regions[i]);
+	}
+	Vector<String> synced_connections = get_connections(synced_list);
+	CHECK(synced_connections.size() > 0);
+	CHECK(synced_connections == get_connections(rebuilt_list));
+
+	// Across the shared edges, the holes and the near edges.
+	const Vector3 from = Vector3(11.5, 0, 0.5);
+	const Vector3 to = Vector3(0.5, 0, 7.5);
+	Vector<Vector3> synced_path = map.get_path(from, to, true);
+	Vector<Vector3> rebuilt_path = rebuilt_map.get_path(from, to, true);
+	REQUIRE(synced_path.size() >= 2);
+	CHECK(synced_path[synced_path.size() - 1].is_equal_approx(to));
+	CHECK(Math::is_equal_approx(get_path_length(synced_path), get_path_length(rebuilt_path)));
+}
+
+void test_hierarchical_paths() {
+	const int columns = 5;
+	const int rows = 3;
+
+	// Walls inside the regions, so the portal costs aren't just straight lines.
+	Ref<NavigationMesh> grid = make_grid_mesh(4);
+	Ref<NavigationMesh> wall_grid = make_grid_mesh(4, { Vector2i(1, 0), Vector2i(1, 1), Vector2i(1, 2) });
+
+	NavMap map;
+	NavRegion regions[columns * rows];
+	for (int z = 0; z < rows; z++) {
+		for (int x = 0; x < columns; x++) {
+			NavRegion &region = regions[z * columns + x];
+			region.set_self(RID::from_uint64(z * columns + x + 1));
+			add_region(map, region, (x + z) % 2 ? wall_grid : grid, Vector3(x * 4, 0, z * 4));
+		}
+	}
+	map.sync();
+
+	const Vector3 queries[][2] = {
+		{ Vector3(0.5, 0, 0.5), Vector3(19.5, 0, 11.5) },
+		{ Vector3(19.5, 0, 0.5), Vector3(0.5, 0, 11.5) },
+		{ Vector3(2.5, 0, 6.5), Vector3(18.5, 0, 5.5) },
+		// Neighbour regions, the corridor is too short to be used.
+		{ Vector3(1.5, 0, 1.5), Vector3(6.5, 0, 1.5) },
+	};
+
+	for (const Vector3 *query : queries) {
+		map.set_use_hierarchical_paths(false);
+		Vector<Vector3> flat_path = map.get_path(query[0], query[1], true);
+		map.set_use_hierarchical_paths(true);
+		Vector<Vector3> hierarchical_path = map.get_path(query[0], query[1], true);
+
+		REQUIRE(flat_path.size() >= 2);
+		REQUIRE(hierarchical_path.size() >= 2);
+		CHECK(hierarchical_path[0].is_equal_approx(flat_path[0]));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+
+		// The portal costs are estimates, so the hierarchical path can be a little longer.
+		const real_t flat_length = get_path_length(flat_path);
+		const real_t hierarchical_length = get_path_length(hierarchical_path);
+		CHECK(hierarchical_length >= query[0].distance_to(query[1]) - CMP_EPSILON);
+		CHECK(hierarchical_length <= flat_length * 1.25);
+
+		Vector<RID> corridor = map.get_region_corridor(query[0], query[1], 1);
+		REQUIRE(corridor.size() >= 2);
+		CHECK(corridor[0] == map.get_closest_point_owner(query[0]));
+		CHECK(corridor[corridor.size() - 1] == map.get_closest_point_owner(query[1]));
+		if (corridor.size() == 2) {
+			CHECK(hierarchical_path == flat_path);
+		}
+	}
+}
+
+} // namespace TestNavMap
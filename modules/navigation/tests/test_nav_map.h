@@ -0,0 +1,61 @@
+/*************************************************************************/
+/*  test_nav_map.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NAV_MAP_H
+#define TEST_NAV_MAP_H
+
+#include "scene/resources/navigation_mesh.h"
+
+#include "tests/test_macros.h"
+
+class NavMap;
+class NavRegion;
+
+namespace TestNavMap {
+
+// A flat grid of p_size by p_size square polygons of one unit, without the cells in p_holes.
+Ref<NavigationMesh> make_grid_mesh(int p_size, const Vector<Vector2i> &p_holes = Vector<Vector2i>());
+void add_region(NavMap &p_map, NavRegion &p_region, const Ref<NavigationMesh> &p_mesh, const Vector3 &p_origin);
+
+void test_incremental_sync();
+
+TEST_CASE("[NavMap] Incremental sync gives the same result as a full rebuild") {
+	test_incremental_sync();
+}
+
+void test_hierarchical_paths();
+
+TEST_CASE("[NavMap] Hierarchical paths agree with the flat search") {
+	test_hierarchical_paths();
+}
+
+} // namespace TestNavMap
+
+#endif // TEST_NAV_MAP_H
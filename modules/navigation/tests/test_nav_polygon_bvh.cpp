@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  test_nav_polygon_bvh.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_nav_polygon_bvh.h"
+
+#include "test_nav_map.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/math/random_pcg.h"
+#include "modules/navigation/nav_map.h"
+#include "modules/navigation/nav_region.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavPolygonBVH {
+
+static real_t get_closest_point_distance_squared(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
+	real_t closest = 1e20;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			closest = MIN(closest, f.get_closest_point_to(p_point).distance_squared_to(p_point));
+		}
+	}
+	return closest;
+}
+
+static bool intersect_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, real_t &r_distance) {
+	bool found = false;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			Vector3 inters;
+			if (f.intersects_segment(p_from, p_to, &inters) && p_from.distance_to(inters) < r_distance) {
+				r_distance = p_from.distance_to(inters);
+				found = true;
+			}
+		}
+	}
+	return found;
+}
+
+static real_t get_closest_edge_distance(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to) {
+	real_t closest = 1e20;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		for (uint32_t point_id = 0; point_id < p.points.size(); point_id++) {
+			Vector3 a, b;
+			Geometry3D::get_closest_points_between_segments(p_from, p_to, p.points[point_id].pos, p.points[(point_id + 1) % p.points.size()].pos, a, b);
+			closest = MIN(closest, a.distance_to(b));
+		}
+	}
+	return closest;
+}
+
+void test_brute_force_queries() {
+	// A bumpy grid with holes, so the polygons aren't all in the same plane.
+	Vector<Vector2i> holes;
+	for (int i = 0; i < 40; i++) {
+		holes.push_back(Vector2i((i * 7) % 16, (i * 11) % 16));
+	}
+	Ref<NavigationMesh> mesh = TestNavMap::make_grid_mesh(16, holes);
+	Vector<Vector3> vertices = mesh->get_vertices();
+	for (int i = 0; i < vertices.size(); i++) {
+		vertices.write[i].y = Math::sin(vertices[i].x * 0.7) * Math::cos(vertices[i].z * 0.4);
+	}
+	mesh->set_vertices(vertices);
+
+	NavMap map;
+	NavRegion region;
+	TestNavMap::add_region(map, region, mesh, Vector3(-8, 0, -8));
+	map.sync();
+
+	const LocalVector<gd::Polygon> &polygons = region.get_polygons();
+	const NavPolygonBVH &bvh = region.get_polygon_bvh();
+	REQUIRE(polygons.size() > 200);
+
+	RandomPCG rng(4321);
+	for (int i = 0; i < 200; i++) {
+		const Vector3 point(rng.random(-12.0f, 12.0f), rng.random(-3.0f, 3.0f), rng.random(-12.0f, 12.0f));
+
+		real_t distance_squared = 1e20;
+		Vector3 closest_point;
+		Vector3 normal;
+		const gd::Polygon *closest_polygon = nullptr;
+		CHECK(bvh.get_closest_point(point, distance_squared, closest_point, normal, closest_polygon));
+		CHECK(closest_polygon != nullptr);
+		CHECK(Math::is_equal_approx(distance_squared, get_closest_point_distance_squared(polygons, point)));
+		CHECK(Math::is_equal_approx(closest_point.distance_squared_to(point), distance_squared));
+
+		const Vector3 to(rng.random(-12.0f, 12.0f), rng.random(-3.0f, 3.0f), rng.random(-12.0f, 12.0f));
+
+		real_t intersection_distance = 1e20;
+		Vector3 intersection;
+		real_t expected_intersection_distance = 1e20;
+		bool intersects = bvh.intersect_segment(point, to, intersection_distance, intersection);
+		CHECK(intersects == intersect_segment(polygons, point, to, expected_intersection_distance));
+		if (intersects) {
+			CHECK(Math::is_equal_approx(intersection_distance, expected_intersection_distance));
+		}
+
+		real_t edge_distance = 1e20;
+		Vector3 edge_point;
+		CHECK(bvh.get_closest_point_to_segment(point, to, edge_distance, edge_point));
+		CHECK(Math::is_equal_approx(edge_distance, get_closest_edge_distance(polygons, point, to)));
+	}
+
+	// Results closer than anything in the tree are kept, so the queries can be chained over the regions.
+	real_t distance_squared = 0.0;
+	Vector3 closest_point;
+	Vector3 normal;
+	const gd::Polygon *closest_polygon = nullptr;
+	CHECK_FALSE(bvh.get_closest_point(Vector3(0, 10, 0), distance_squared, closest_point, normal, closest_polygon));
+	CHECK(closest_polygon == nullptr);
+}
+
+} // namespace TestNavPolygonBVH
@@ -0,0 +1,129 @@
+/*************************************************************************/
+/*  test_navigation_mesh_generator.cpp                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_navigation_mesh_generator.h"
+
+#ifndef _3D_DISABLED
+
+#include "modules/navigation/nav_map.h"
+#include "modules/navigation/nav_region.h"
+#include "modules/navigation/navigation_mesh_generator.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavigationMeshGenerator {
+
+static real_t get_area(Ref<NavigationMesh> p_mesh) {
+	const Vector<Vector3> vertices = p_mesh->get_vertices();
+	real_t area = 0.0;
+	for (int i = 0; i < p_mesh->get_polygon_count(); i++) {
+		const Vector<int> polygon = p_mesh->get_polygon(i);
+		for (int j = 2; j < polygon.size(); j++) {
+			area += (vertices[polygon[j - 1]] - vertices[polygon[0]]).cross(vertices[polygon[j]] - vertices[polygon[0]]).length() * 0.5;
+		}
+	}
+	return area;
+}
+
+void test_tile_seams() {
+	// A 20x20 floor, cut in tiles of 4 units.
+	Node3D *parent = memnew(Node3D);
+	MeshInstance3D *floor = memnew(MeshInstance3D);
+	Ref<PlaneMesh> plane;
+	plane.instantiate();
+	plane->set_size(Size2(20, 20));
+	floor->set_mesh(plane);
+	parent->add_child(floor);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	Ref<NavigationMesh> tiled_mesh;
+	tiled_mesh.instantiate();
+	tiled_mesh->set_tile_size(4.0);
+	NavigationMeshGenerator::get_singleton()->bake(tiled_mesh, parent);
+
+	Ref<NavigationMesh> single_mesh;
+	single_mesh.instantiate();
+	NavigationMeshGenerator::get_singleton()->bake(single_mesh, parent);
+
+	REQUIRE(tiled_mesh->get_polygon_count() > 0);
+	REQUIRE(single_mesh->get_polygon_count() > 0);
+
+	// The tiles cover the same walkable area as a single bake, without gaps or overlaps.
+	CHECK(get_area(tiled_mesh) == doctest::Approx(get_area(single_mesh)).epsilon(0.02));
+
+	NavMap map;
+	NavRegion region;
+	region.set_mesh(tiled_mesh);
+	region.set_map(&map);
+	map.add_region(&region);
+	map.sync();
+
+	// The polygon edges along the tile borders are shared with the polygons of the
+	// next tile, so the only edges left free are on the outline of the floor.
+	const LocalVector<gd::Edge::Connection> &free_edges = region.get_free_edges();
+	CHECK(free_edges.size() > 0);
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::Polygon *polygon = free_edges[i].polygon;
+		const int edge = free_edges[i].edge;
+		const Vector3 middle = (polygon->points[edge].pos + polygon->points[(edge + 1) % polygon->points.size()].pos) * 0.5;
+		CHECK_MESSAGE(MAX(Math::abs(middle.x), Math::abs(middle.z)) > 9.0, vformat("Free edge inside the floor at %s.", middle));
+	}
+
+	// On a flat floor, paths go straight across the tiles.
+	const Vector3 from = Vector3(-8.3, 0, -7.1);
+	const Vector3 to = Vector3(7.9, 0, 8.6);
+	Vector<Vector3> path = map.get_path(from, to, true);
+	REQUIRE(path.size() >= 2);
+	real_t length = 0.0;
+	for (int i = 1; i < path.size(); i++) {
+		length += path[i - 1].distance_to(path[i]);
+	}
+	CHECK(length == doctest::Approx(path[0].distance_to(path[path.size() - 1])));
+
+	// Baking again reuses the cached tiles and gives the same mesh.
+	const int polygon_count = tiled_mesh->get_polygon_count();
+	const Vector<Vector3> vertices = tiled_mesh->get_vertices();
+	tiled_mesh->clear_polygons();
+	NavigationMeshGenerator::get_singleton()->bake(tiled_mesh, parent);
+	CHECK(tiled_mesh->get_polygon_count() == polygon_count);
+	CHECK(tiled_mesh->get_vertices() == vertices);
+
+	map.remove_region(&region);
+	region.set_map(nullptr);
+
+	memdelete(parent);
+}
+
+} // namespace TestNavigationMeshGenerator
+
+#endif // _3D_DISABLED
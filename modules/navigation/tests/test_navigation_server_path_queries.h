@@ -0,0 +1,158 @@
+/*************************************************************************/
+/*  test_navigation_server_path_queries.h                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NAVIGATION_SERVER_PATH_QUERIES_H
+#define TEST_NAVIGATION_SERVER_PATH_QUERIES_H
+
+#include "servers/navigation_server_3d.h"
+#include "test_nav_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavigationServerPathQueries {
+
+class PathQueryReceiver : public Object {
+public:
+	Vector<Array> results;
+
+	void receive(const Array &p_paths) {
+		results.push_back(p_paths);
+	}
+};
+
+struct PathQueryMap {
+	RID map;
+	RID region;
+	Vector<Vector3> origins;
+	Vector<Vector3> destinations;
+
+	PathQueryMap() {
+		NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+		map = server->map_create();
+		server->map_set_active(map, true);
+		region = server->region_create();
+		server->region_set_map(region, map);
+		server->region_set_navmesh(region, TestNavMap::make_grid_mesh(8, { Vector2i(3, 2), Vector2i(3, 3), Vector2i(3, 4), Vector2i(3, 5) }));
+		server->map_force_update(map);
+
+		for (int i = 0; i < 8; i++) {
+			origins.push_back(Vector3(0.5, 0, 0.5 + i));
+			destinations.push_back(Vector3(7.5, 0, 7.5 - i));
+		}
+	}
+
+	~PathQueryMap() {
+		NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+		if (region.is_valid()) {
+			server->free(region);
+		}
+		if (map.is_valid()) {
+			server->free(map);
+		}
+		server->process(0.0);
+	}
+};
+
+TEST_CASE("[SceneTree][NavigationServer3D] Batched path queries give the same paths as map_get_path") {
+	NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+	PathQueryMap query_map;
+	PathQueryReceiver receiver;
+
+	server->map_request_paths(query_map.map, query_map.origins, query_map.destinations, true, 1, callable_mp(&receiver, &PathQueryReceiver::receive));
+	server->process(0.0);
+	CHECK_MESSAGE(receiver.results.is_empty(), "The paths should be resolved during the frame they're requested in, not delivered yet.");
+	server->process(0.0);
+	REQUIRE_MESSAGE(receiver.results.size() == 1, "The callback should be called once, on the next process.");
+
+	const Array &paths = receiver.results[0];
+	REQUIRE(paths.size() == query_map.origins.size());
+	bool all_equal = true;
+	for (int i = 0; i < paths.size(); i++) {
+		Vector<Vector3> expected = server->map_get_path(query_map.map, query_map.origins[i], query_map.destinations[i], true);
+		all_equal = all_equal && !expected.is_empty() && Vector<Vector3>(paths[i]) == expected;
+	}
+	CHECK_MESSAGE(all_equal, "Each path should be the same as the one returned by map_get_path, in the order of the requests.");
+
+	// While the server is inactive, the maps aren't synchronized but paths are still delivered.
+	server->set_active(false);
+	receiver.results.clear();
+	server->map_request_paths(query_map.map, query_map.origins, query_map.destinations, true, 1, callable_mp(&receiver, &PathQueryReceiver::receive));
+	server->process(0.0);
+	server->process(0.0);
+	server->set_active(true);
+	REQUIRE_MESSAGE(receiver.results.size() == 1, "Paths requested while the server is inactive should still be delivered.");
+	CHECK(Array(receiver.results[0]) == paths);
+}
+
+TEST_CASE("[SceneTree][NavigationServer3D] Batched path queries on a freed map") {
+	NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+	PathQueryReceiver receiver;
+
+	SUBCASE("Freed before the paths are resolved") {
+		PathQueryMap query_map;
+		server->map_request_paths(query_map.map, query_map.origins, query_map.destinations, true, 1, callable_mp(&receiver, &PathQueryReceiver::receive));
+		server->free(query_map.region);
+		server->free(query_map.map);
+		query_map.region = RID();
+		query_map.map = RID();
+		server->process(0.0);
+		server->process(0.0);
+
+		REQUIRE_MESSAGE(receiver.results.size() == 1, "The callback should still be called for a map freed while its paths were pending.");
+		const Array &paths = receiver.results[0];
+		REQUIRE(paths.size() == query_map.origins.size());
+		bool all_empty = true;
+		for (int i = 0; i < paths.size(); i++) {
+			all_empty = all_empty && Vector<Vector3>(paths[i]).is_empty();
+		}
+		CHECK_MESSAGE(all_empty, "The paths on a freed map should be empty.");
+	}
+
+	SUBCASE("Freed while the paths are resolved") {
+		PathQueryMap query_map;
+		server->map_request_paths(query_map.map, query_map.origins, query_map.destinations, true, 1, callable_mp(&receiver, &PathQueryReceiver::receive));
+		server->process(0.0);
+		// Only freed on the next process, once the running queries are done with the map.
+		server->free(query_map.region);
+		server->free(query_map.map);
+		query_map.region = RID();
+		query_map.map = RID();
+		server->process(0.0);
+
+		REQUIRE(receiver.results.size() == 1);
+		const Array &paths = receiver.results[0];
+		REQUIRE(paths.size() == query_map.origins.size());
+		CHECK_MESSAGE(!Vector<Vector3>(paths[0]).is_empty(), "Paths resolved before the map was freed should be delivered.");
+	}
+}
+
+} // namespace TestNavigationServerPathQueries
+
+#endif // TEST_NAVIGATION_SERVER_PATH_QUERIES_H
@@ -46,6 +46,7 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::InternalMode);
 
 int Node::orphan_node_count = 0;
@@ -76,6 +77,13 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+				data.process_thread_group_owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+			} else {
+				data.process_thread_group_owner = this;
+				data.process_group = get_tree()->_add_process_group(this);
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -114,6 +122,13 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.process_owner = nullptr;
+
+			if (data.process_group) {
+				get_tree()->_remove_process_group(data.process_group);
+				data.process_group = nullptr;
+			}
+			data.process_thread_group_owner = nullptr;
+
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
@@ -205,6 +220,8 @@ void Node::_propagate_enter_tree() {
 	}
 
 	data.inside_tree = true;
+	// Process thread groups are sorted by tree position, which may have changed.
+	data.tree->process_groups_dirty = true;
 
 	for (KeyValue<StringName, GroupData> &E : data.grouped) {
 		E.value.group = data.tree->add_to_group(E.key, this);
@@ -313,6 +330,7 @@ void Node::_propagate_exit_tree() {
 	data.viewport = nullptr;
 
 	if (data.tree) {
+		data.tree->process_groups_dirty = true;
 		data.tree->tree_changed();
 	}
 
@@ -371,6 +389,7 @@ void Node::_move_child(Node *p_child, int p_pos, bool p_ignore_end) {
 	data.children.insert(p_pos, p_child);
 
 	if (data.tree) {
+		data.tree->process_groups_dirty = true;
 		data.tree->tree_changed();
 	}
 
@@ -560,6 +579,252 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
+	if (data.process_thread_group == p_mode) {
+		return;
+	}
+
+	if (!is_inside_tree()) {
+		data.process_thread_group = p_mode;
+		return;
+	}
+
+	ERR_FAIL_COND_MSG(Thread::get_caller_id() != Thread::get_main_id(), "The process thread group of a node inside the tree can only be changed from the main thread.");
+
+	if (data.process_group) {
+		data.tree->_remove_process_group(data.process_group);
+		data.process_group = nullptr;
+	}
+
+	data.process_thread_group = p_mode;
+
+	Node *owner = nullptr;
+	if (p_mode == PROCESS_THREAD_GROUP_INHERIT) {
+		if (data.parent) {
+			owner = data.parent->data.process_thread_group_owner;
+		}
+	} else {
+		owner = this;
+		data.process_group = data.tree->_add_process_group(this);
+	}
+
+	_propagate_process_thread_group_owner(owner);
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+void Node::set_process_thread_group_order(int p_order) {
+	if (data.process_thread_group_order == p_order) {
+		return;
+	}
+
+	data.process_thread_group_order = p_order;
+
+	if (data.process_group) {
+		data.tree->_update_process_group(data.process_group);
+	}
+}
+
+int Node::get_process_thread_group_order() const {
+	return data.process_thread_group_order;
+}
+
+void Node::_propagate_process_thread_group_owner(Node *p_owner) {
+	data.process_thread_group_owner = p_owner;
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *c = data.children[i];
+		if (c->data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+			c->_propagate_process_thread_group_owner(p_owner);
+		}
+	}
+}
+
+SceneTree::ProcessGroup *Node::_get_process_group() const {
+	if (data.process_thread_group_owner) {
+		return data.process_thread_group_owner->data.process_group;
+	}
+	return &data.tree->default_process_group;
+}
+
+bool Node::_is_accessible_from_caller_thread() const {
+	if (!data.inside_tree) {
+		return true; // Nodes outside the tree belong to whoever holds them.
+	}
+
+	SceneTree::ProcessGroup *current = SceneTree::current_process_group;
+	if (!current) {
+		return Thread::get_caller_id() == Thread::get_main_id();
+	}
+
+	SceneTree::ProcessGroup *pg = _get_process_group();
+	if (pg == current) {
+		return true;
+	}
+
+	// Main thread groups may access each other, but not sub-thread groups that could be running right now.
+	return !current->sub_thread && !pg->sub_thread;
+}
+
+void Node::call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount) {
+	ERR_FAIL_COND_MSG(!is_inside_tree(), "Node must be inside the tree to use thread group calls.");
+
+	SceneTree::ProcessGroup *pg = _get_process_group();
+	if (!pg->sub_thread) {
+		// Main thread groups are processed on the main thread anyway.
+		MessageQueue::get_singleton()->push_callp(this, p_method, p_args, p_argcount, true);
+		return;
+	}
+
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_CALL;
+	call.callable = Callable(this, p_method);
+	call.args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		call.args.write[i] = *p_args[i];
+	}
+	data.tree->_push_process_group_call(pg, false, call);
+}
+
+void Node::set_deferred_thread_group(const StringName &p_property, const Variant &p_value) {
+	ERR_FAIL_COND_MSG(!is_inside_tree(), "Node must be inside the tree to use thread group calls.");
+
+	SceneTree::ProcessGroup *pg = _get_process_group();
+	if (!pg->sub_thread) {
+		MessageQueue::get_singleton()->push_set(this, p_property, p_value);
+		return;
+	}
+
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_SET;
+	call.callable = Callable(this, p_property);
+	call.args.push_back(p_value);
+	data.tree->_push_process_group_call(pg, false, call);
+}
+
+void Node::notify_deferred_thread_group(int p_notification) {
+	ERR_FAIL_COND_MSG(!is_inside_tree(), "Node must be inside the tree to use thread group calls.");
+
+	SceneTree::ProcessGroup *pg = _get_process_group();
+	if (!pg->sub_thread) {
+		MessageQueue::get_singleton()->push_notification(this, p_notification);
+		return;
+	}
+
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_NOTIFICATION;
+	call.callable = Callable(this, CoreStringNames::get_singleton()->notification);
+	call.notification = p_notification;
+	data.tree->_push_process_group_call(pg, false, call);
+}
+
+void Node::call_thread_safep(const StringName &p_method, const Variant **p_args, int p_argcount) {
+	if (_is_accessible_from_caller_thread()) {
+		Callable::CallError ce;
+		callp(p_method, p_args, p_argcount, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling method from 'call_thread_safe': " + Variant::get_call_error_text(this, p_method, p_args, p_argcount, ce) + ".");
+		}
+		return;
+	}
+
+	SceneTree::ProcessGroup *current = SceneTree::current_process_group;
+	if (!current) {
+		MessageQueue::get_singleton()->push_callp(this, p_method, p_args, p_argcount, true);
+		return;
+	}
+
+	// Called from within a group, run it at the merge point so the order is deterministic.
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_CALL;
+	call.callable = Callable(this, p_method);
+	call.args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		call.args.write[i] = *p_args[i];
+	}
+	data.tree->_push_process_group_call(current, true, call);
+}
+
+void Node::set_thread_safe(const StringName &p_property, const Variant &p_value) {
+	if (_is_accessible_from_caller_thread()) {
+		set(p_property, p_value);
+		return;
+	}
+
+	SceneTree::ProcessGroup *current = SceneTree::current_process_group;
+	if (!current) {
+		MessageQueue::get_singleton()->push_set(this, p_property, p_value);
+		return;
+	}
+
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_SET;
+	call.callable = Callable(this, p_property);
+	call.args.push_back(p_value);
+	data.tree->_push_process_group_call(current, true, call);
+}
+
+void Node::notify_thread_safe(int p_notification) {
+	if (_is_accessible_from_caller_thread()) {
+		notification(p_notification);
+		return;
+	}
+
+	SceneTree::ProcessGroup *current = SceneTree::current_process_group;
+	if (!current) {
+		MessageQueue::get_singleton()->push_notification(this, p_notification);
+		return;
+	}
+
+	SceneTree::ProcessGroupCall call;
+	call.type = SceneTree::ProcessGroupCall::TYPE_NOTIFICATION;
+	call.callable = Callable(this, CoreStringNames::get_singleton()->notification);
+	call.notification = p_notification;
+	data.tree->_push_process_group_call(current, true, call);
+}
+
+Variant Node::_call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 0;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING_NAME && p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return Variant();
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	call_deferred_thread_groupp(*p_args[0], &p_args[1], p_argcount - 1);
+	return Variant();
+}
+
+Variant Node::_call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 0;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING_NAME && p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return Variant();
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	call_thread_safep(*p_args[0], &p_args[1], p_argcount - 1);
+	return Variant();
+}
+
 void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	data.multiplayer_authority = p_peer_id;
 
@@ -2859,6 +3124,10 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_processing_unhandled_key_input"), &Node::is_processing_unhandled_key_input);
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group_order", "order"), &Node::set_process_thread_group_order);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group_order"), &Node::get_process_thread_group_order);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
 	ClassDB::bind_method(D_METHOD("print_orphan_nodes"), &Node::_print_orphan_nodes);
 
@@ -2925,6 +3194,22 @@ void Node::_bind_methods() {
 		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "rpc_id", &Node::_rpc_id_bind, mi);
 	}
 
+	{
+		MethodInfo mi;
+		mi.arguments.push_back(PropertyInfo(Variant::STRING_NAME, "method"));
+
+		mi.name = "call_deferred_thread_group";
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_deferred_thread_group", &Node::_call_deferred_thread_group_bind, mi, varray(), false);
+
+		mi.name = "call_thread_safe";
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_thread_safe", &Node::_call_thread_safe_bind, mi, varray(), false);
+	}
+
+	ClassDB::bind_method(D_METHOD("set_deferred_thread_group", "property", "value"), &Node::set_deferred_thread_group);
+	ClassDB::bind_method(D_METHOD("notify_deferred_thread_group", "what"), &Node::notify_deferred_thread_group);
+	ClassDB::bind_method(D_METHOD("set_thread_safe", "property", "value"), &Node::set_thread_safe);
+	ClassDB::bind_method(D_METHOD("notify_thread_safe", "what"), &Node::notify_thread_safe);
+
 	ClassDB::bind_method(D_METHOD("update_configuration_warnings"), &Node::update_configuration_warnings);
 
 	BIND_CONSTANT(NOTIFICATION_ENTER_TREE);
@@ -2977,6 +3262,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -3004,6 +3293,10 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
 
+	ADD_SUBGROUP("Thread Group", "process_thread");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
+
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT), "set_editor_description", "get_editor_description");
 
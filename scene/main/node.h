@@ -53,6 +53,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT, // same as parent node
+		PROCESS_THREAD_GROUP_MAIN_THREAD, // own group, processed on the main thread
+		PROCESS_THREAD_GROUP_SUB_THREAD, // own group, processed on a WorkerThreadPool thread
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -126,6 +132,11 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		Node *process_thread_group_owner = nullptr;
+		SceneTree::ProcessGroup *process_group = nullptr; // Only set on the node owning the group.
+		int process_thread_group_order = 0;
+
 		int multiplayer_authority = 1; // Server by default.
 		Variant rpc_config;
 
@@ -174,6 +185,9 @@ private:
 	void _propagate_after_exit_tree();
 	void _print_orphan_nodes();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_process_thread_group_owner(Node *p_owner);
+	SceneTree::ProcessGroup *_get_process_group() const;
+	bool _is_accessible_from_caller_thread() const;
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
@@ -184,6 +198,8 @@ private:
 	Array _get_groups() const;
 
 	Error _rpc_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Error _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	_FORCE_INLINE_ bool _is_internal_front() const { return data.parent && data.pos < data.parent->data.internal_children_front; }
@@ -452,6 +468,42 @@ public:
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
 
+	void set_process_thread_group(ProcessThreadGroup p_mode);
+	ProcessThreadGroup get_process_thread_group() const;
+
+	void set_process_thread_group_order(int p_order);
+	int get_process_thread_group_order() const;
+
+	/* THREAD GROUP CALLS */
+
+	// Deferred until the node's process thread group runs next, on the thread processing it.
+	void call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount);
+	template <typename... VarArgs>
+	void call_deferred_thread_group(const StringName &p_method, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		call_deferred_thread_groupp(p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+	void set_deferred_thread_group(const StringName &p_property, const Variant &p_value);
+	void notify_deferred_thread_group(int p_notification);
+
+	// Immediate when the node is accessible from the caller thread, deferred to the main thread otherwise.
+	void call_thread_safep(const StringName &p_method, const Variant **p_args, int p_argcount);
+	template <typename... VarArgs>
+	void call_thread_safe(const StringName &p_method, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		call_thread_safep(p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+	void set_thread_safe(const StringName &p_property, const Variant &p_value);
+	void notify_thread_safe(int p_notification);
+
 	void request_ready();
 
 	static void print_orphan_nodes();
@@ -38,6 +38,7 @@
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
@@ -50,6 +51,7 @@
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/packed_scene.h"
+#include "scene/resources/residency_manager.h"
 #include "scene/resources/world_2d.h"
 #include "scene/resources/world_3d.h"
 #include "scene/scene_string_names.h"
@@ -499,6 +501,10 @@ bool SceneTree::process(double p_time) {
 
 	_call_idle_callbacks();
 
+	if (ResidencyManager::get_singleton()) {
+		ResidencyManager::get_singleton()->update();
+	}
+
 #ifdef TOOLS_ENABLED
 #ifndef _3D_DISABLED
 	if (Engine::get_singleton()->is_editor_hint()) {
@@ -888,8 +894,60 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	call_lock++;
 
-	for (int i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
+	if (process_groups_in_sub_thread > 0) {
+		_notify_process_groups(nodes, node_count, p_notification);
+	} else {
+		for (int i = 0; i < node_count; i++) {
+			Node *n = nodes[i];
+			if (call_lock && call_skip.has(n)) {
+				continue;
+			}
+
+			if (!n->can_process()) {
+				continue;
+			}
+			if (!n->can_process_notification(p_notification)) {
+				continue;
+			}
+
+			n->notification(p_notification);
+			//ERR_FAIL_COND(node_count != g.nodes.size());
+		}
+	}
+
+	call_lock--;
+	if (call_lock == 0) {
+		call_skip.clear();
+	}
+}
+
+thread_local SceneTree::ProcessGroup *SceneTree::current_process_group = nullptr;
+
+bool SceneTree::ProcessGroupSort::operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const {
+	if (p_left->order != p_right->order) {
+		return p_left->order < p_right->order;
+	}
+	if (!p_left->owner || !p_right->owner) {
+		// The default group goes first among groups of the same order.
+		return p_left->owner == nullptr && p_right->owner != nullptr;
+	}
+	return p_right->owner->is_greater_than(p_left->owner);
+}
+
+void SceneTree::_notify_process_groups(Node **p_nodes, int p_node_count, int p_notification) {
+	if (process_groups_dirty) {
+		process_groups.sort_custom<ProcessGroupSort>();
+		process_groups_dirty = false;
+	}
+
+	// Filter and distribute the nodes on the main thread, so process priority is kept inside each group
+	// and threads never need to look at the call skip list.
+	for (uint32_t i = 0; i < process_groups.size(); i++) {
+		process_groups[i]->nodes.clear();
+	}
+
+	for (int i = 0; i < p_node_count; i++) {
+		Node *n = p_nodes[i];
 		if (call_lock && call_skip.has(n)) {
 			continue;
 		}
@@ -901,13 +959,204 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 			continue;
 		}
 
+		Node *owner = n->data.process_thread_group_owner;
+		ProcessGroup *pg = owner ? owner->data.process_group : &default_process_group;
+		pg->nodes.push_back(n);
+	}
+
+	processing_thread_groups = true;
+
+	// Sub-thread groups sharing the same order run concurrently in the WorkerThreadPool. Main thread
+	// groups of that order run before them, so they can't free or remove nodes a sub-thread group is
+	// processing. The end of each order is a merge point where everything queued for the main thread
+	// is flushed in group order, so the outcome does not depend on thread scheduling.
+	uint32_t from = 0;
+	while (from < process_groups.size()) {
+		int order = process_groups[from]->order;
+		uint32_t to = from;
+		while (to < process_groups.size() && process_groups[to]->order == order) {
+			to++;
+		}
+
+		for (uint32_t i = from; i < to; i++) {
+			ProcessGroup *pg = process_groups[i];
+			if (!pg->sub_thread && !pg->removed) {
+				_process_group(pg, p_notification);
+			}
+		}
+
+		process_group_dispatch.clear();
+		for (uint32_t i = from; i < to; i++) {
+			ProcessGroup *pg = process_groups[i];
+			if (!pg->sub_thread || pg->removed) {
+				continue;
+			}
+			if (call_skip.size()) {
+				// Nodes removed by earlier groups in this pass, including the main thread groups above.
+				for (uint32_t j = 0; j < pg->nodes.size(); j++) {
+					if (call_skip.has(pg->nodes[j])) {
+						pg->nodes.remove_at(j);
+						j--;
+					}
+				}
+			}
+			if (!pg->nodes.is_empty() || !pg->group_calls.is_empty()) {
+				process_group_dispatch.push_back(pg);
+			}
+		}
+
+		if (process_group_dispatch.size() > 0) {
+			WorkerThreadPool::GroupID task_group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_group_task, p_notification, process_group_dispatch.size(), -1, true, "Process thread groups");
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(task_group);
+		}
+
+		for (uint32_t i = from; i < to; i++) {
+			if (!process_groups[i]->removed) {
+				_flush_process_group_calls(process_groups[i], &ProcessGroup::main_thread_calls);
+			}
+		}
+
+		from = to;
+	}
+
+	processing_thread_groups = false;
+
+	_apply_process_group_changes();
+}
+
+void SceneTree::_process_group(ProcessGroup *p_group, int p_notification) {
+	current_process_group = p_group;
+
+	_flush_process_group_calls(p_group, &ProcessGroup::group_calls);
+
+	for (uint32_t i = 0; i < p_group->nodes.size(); i++) {
+		Node *n = p_group->nodes[i];
+		if (!p_group->sub_thread && call_skip.has(n)) {
+			continue; // Removed while processing this group, only possible on the main thread.
+		}
 		n->notification(p_notification);
-		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
 
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+	current_process_group = nullptr;
+}
+
+void SceneTree::_process_group_task(uint32_t p_index, int p_notification) {
+	_process_group(process_group_dispatch[p_index], p_notification);
+}
+
+void SceneTree::_flush_process_group_calls(ProcessGroup *p_group, LocalVector<ProcessGroupCall> ProcessGroup::*p_queue) {
+	p_group->call_mutex.lock();
+	if ((p_group->*p_queue).is_empty()) {
+		p_group->call_mutex.unlock();
+		return;
+	}
+	LocalVector<ProcessGroupCall> calls = p_group->*p_queue;
+	(p_group->*p_queue).clear();
+	p_group->call_mutex.unlock();
+
+	for (uint32_t i = 0; i < calls.size(); i++) {
+		const ProcessGroupCall &call = calls[i];
+		Object *target = call.callable.get_object();
+		if (!target) {
+			continue;
+		}
+
+		switch (call.type) {
+			case ProcessGroupCall::TYPE_CALL: {
+				const Variant **argptrs = nullptr;
+				int argcount = call.args.size();
+				if (argcount) {
+					argptrs = (const Variant **)alloca(sizeof(Variant *) * argcount);
+					for (int j = 0; j < argcount; j++) {
+						argptrs[j] = &call.args[j];
+					}
+				}
+
+				Callable::CallError ce;
+				Variant ret;
+				call.callable.callp(argptrs, argcount, ret, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					ERR_PRINT("Error calling deferred thread group method: " + Variant::get_callable_error_text(call.callable, argptrs, argcount, ce) + ".");
+				}
+			} break;
+			case ProcessGroupCall::TYPE_SET: {
+				target->set(call.callable.get_method(), call.args[0]);
+			} break;
+			case ProcessGroupCall::TYPE_NOTIFICATION: {
+				target->notification(call.notification);
+			} break;
+		}
+	}
+}
+
+void SceneTree::_push_process_group_call(ProcessGroup *p_group, bool p_main_thread, ProcessGroupCall &p_call) {
+	MutexLock lock(p_group->call_mutex);
+	if (p_main_thread) {
+		p_group->main_thread_calls.push_back(p_call);
+	} else {
+		p_group->group_calls.push_back(p_call);
+	}
+}
+
+SceneTree::ProcessGroup *SceneTree::_add_process_group(Node *p_owner) {
+	ProcessGroup *pg = memnew(ProcessGroup);
+	pg->owner = p_owner;
+	pg->order = p_owner->data.process_thread_group_order;
+	pg->sub_thread = p_owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD;
+	if (pg->sub_thread) {
+		process_groups_in_sub_thread++;
+	}
+
+	if (processing_thread_groups) {
+		process_groups_added.push_back(pg);
+	} else {
+		process_groups.push_back(pg);
+		process_groups_dirty = true;
+	}
+	return pg;
+}
+
+void SceneTree::_remove_process_group(ProcessGroup *p_group) {
+	ERR_FAIL_COND(p_group == &default_process_group);
+
+	if (p_group->sub_thread) {
+		process_groups_in_sub_thread--;
+	}
+
+	p_group->owner = nullptr;
+	p_group->removed = true;
+
+	if (processing_thread_groups) {
+		// Still referenced by the pass in progress, so only free it after the pass.
+		process_groups_removed.push_back(p_group);
+	} else {
+		process_groups.erase(p_group);
+		process_groups_added.erase(p_group);
+		memdelete(p_group);
+	}
+}
+
+void SceneTree::_update_process_group(ProcessGroup *p_group) {
+	ERR_FAIL_COND_MSG(processing_thread_groups, "Can't change the order of a process thread group while groups are being processed.");
+	p_group->order = p_group->owner->data.process_thread_group_order;
+	process_groups_dirty = true;
+}
+
+void SceneTree::_apply_process_group_changes() {
+	for (uint32_t i = 0; i < process_groups_removed.size(); i++) {
+		ProcessGroup *pg = process_groups_removed[i];
+		process_groups.erase(pg);
+		process_groups_added.erase(pg);
+		memdelete(pg);
+	}
+	process_groups_removed.clear();
+
+	if (process_groups_added.size()) {
+		for (uint32_t i = 0; i < process_groups_added.size(); i++) {
+			process_groups.push_back(process_groups_added[i]);
+		}
+		process_groups_added.clear();
+		process_groups_dirty = true;
 	}
 }
 
@@ -1385,6 +1634,7 @@ SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
 	}
+	process_groups.push_back(&default_process_group);
 	debug_collisions_color = GLOBAL_DEF("debug/shapes/collision/shape_color", Color(0.0, 0.6, 0.7, 0.42));
 	debug_collision_contact_color = GLOBAL_DEF("debug/shapes/collision/contact_color", Color(1.0, 0.2, 0.1, 0.8));
 	debug_paths_color = GLOBAL_DEF("debug/shapes/paths/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
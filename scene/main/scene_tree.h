@@ -33,6 +33,7 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
 
@@ -87,6 +88,35 @@ private:
 		bool changed = false;
 	};
 
+	// Deferred work queued against a process thread group, see Node::call_deferred_thread_group() and Node::call_thread_safe().
+	struct ProcessGroupCall {
+		enum Type {
+			TYPE_CALL,
+			TYPE_SET,
+			TYPE_NOTIFICATION,
+		};
+
+		Type type = TYPE_CALL;
+		Callable callable;
+		Vector<Variant> args; // Call arguments, or the value for sets.
+		int notification = 0;
+	};
+
+	struct ProcessGroup {
+		Node *owner = nullptr; // nullptr for the default group, which always runs on the main thread.
+		int order = 0;
+		bool sub_thread = false;
+		bool removed = false;
+		Mutex call_mutex;
+		LocalVector<ProcessGroupCall> group_calls; // Run on the thread processing the group, before it processes.
+		LocalVector<ProcessGroupCall> main_thread_calls; // Run on the main thread at the merge point, in group order.
+		LocalVector<Node *> nodes; // Nodes being processed in the current pass.
+	};
+
+	struct ProcessGroupSort {
+		bool operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const;
+	};
+
 	Window *root = nullptr;
 
 	uint64_t tree_version = 1;
@@ -105,6 +135,16 @@ private:
 
 	HashMap<StringName, Group> group_map;
 	bool _quit = false;
+
+	ProcessGroup default_process_group;
+	LocalVector<ProcessGroup *> process_groups; // Sorted by order, includes the default group.
+	LocalVector<ProcessGroup *> process_group_dispatch; // Sub-thread groups being processed in the current pass.
+	LocalVector<ProcessGroup *> process_groups_added; // Groups added or removed while processing, applied after the pass.
+	LocalVector<ProcessGroup *> process_groups_removed;
+	bool process_groups_dirty = true;
+	int process_groups_in_sub_thread = 0;
+	bool processing_thread_groups = false;
+	static thread_local ProcessGroup *current_process_group;
 	bool initialized = false;
 
 	StringName tree_changed_name = "tree_changed";
@@ -183,6 +223,16 @@ private:
 	void make_group_changed(const StringName &p_group);
 
 	void _notify_group_pause(const StringName &p_group, int p_notification);
+	void _notify_process_groups(Node **p_nodes, int p_node_count, int p_notification);
+	void _process_group(ProcessGroup *p_group, int p_notification);
+	void _process_group_task(uint32_t p_index, int p_notification);
+	void _flush_process_group_calls(ProcessGroup *p_group, LocalVector<ProcessGroupCall> ProcessGroup::*p_queue);
+
+	ProcessGroup *_add_process_group(Node *p_owner);
+	void _remove_process_group(ProcessGroup *p_group);
+	void _update_process_group(ProcessGroup *p_group);
+	void _apply_process_group_changes();
+	void _push_process_group_call(ProcessGroup *p_group, bool p_main_thread, ProcessGroupCall &p_call);
 	void _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	void _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
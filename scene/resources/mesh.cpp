@@ -34,6 +34,7 @@
 #include "core/templates/pair.h"
 #include "scene/resources/concave_polygon_shape_3d.h"
 #include "scene/resources/convex_polygon_shape_3d.h"
+#include "scene/resources/residency_manager.h"
 #include "surface_tool.h"
 
 #include <stdlib.h>
@@ -1387,7 +1388,7 @@ Array ArrayMesh::_get_surfaces() const {
 
 	Array ret;
 	for (int i = 0; i < surfaces.size(); i++) {
-		RenderingServer::SurfaceData surface = RS::get_singleton()->mesh_get_surface(mesh, i);
+		RenderingServer::SurfaceData surface = stream_surfaces.is_empty() ? RS::get_singleton()->mesh_get_surface(mesh, i) : stream_surfaces[i];
 		Dictionary data;
 		data["format"] = surface.format;
 		data["primitive"] = surface.primitive;
@@ -1445,6 +1446,18 @@ Array ArrayMesh::_get_surfaces() const {
 	return ret;
 }
 
+// Surface with the finer LODs left out, the finest one remaining becomes the main index buffer.
+static RS::SurfaceData _get_streaming_surface(const RS::SurfaceData &p_surface, int p_level) {
+	RS::SurfaceData surface = p_surface;
+	int lod = MIN(p_level, p_surface.lods.size());
+	if (lod > 0) {
+		surface.index_data = p_surface.lods[lod - 1].index_data;
+		surface.index_count = surface.index_data.size() / (p_surface.vertex_count <= 65536 ? 2 : 4);
+		surface.lods = p_surface.lods.slice(lod);
+	}
+	return surface;
+}
+
 void ArrayMesh::_create_if_empty() const {
 	if (!mesh.is_valid()) {
 		mesh = RS::get_singleton()->mesh_create();
@@ -1531,16 +1544,33 @@ void ArrayMesh::_set_surfaces(const Array &p_surfaces) {
 		surface_2d.push_back(_2d);
 	}
 
+	// When streaming, meshes with LODs start with only the coarsest ones resident.
+	Vector<RS::SurfaceData> resident_surface_data = surface_data;
+	ResidencyManager *residency_manager = ResidencyManager::get_singleton();
+	stream_surfaces.clear();
+	stream_level = 0;
+	if (residency_manager && residency_manager->is_enabled()) {
+		for (int i = 0; i < surface_data.size(); i++) {
+			stream_level = MAX(stream_level, surface_data[i].lods.size());
+		}
+		if (stream_level > 0) {
+			stream_surfaces = surface_data;
+			for (int i = 0; i < surface_data.size(); i++) {
+				resident_surface_data.write[i] = _get_streaming_surface(surface_data[i], stream_level);
+			}
+		}
+	}
+
 	if (mesh.is_valid()) {
 		//if mesh exists, it needs to be updated
 		RS::get_singleton()->mesh_clear(mesh);
-		for (int i = 0; i < surface_data.size(); i++) {
-			RS::get_singleton()->mesh_add_surface(mesh, surface_data[i]);
+		for (int i = 0; i < resident_surface_data.size(); i++) {
+			RS::get_singleton()->mesh_add_surface(mesh, resident_surface_data[i]);
 		}
 	} else {
 		// if mesh does not exist (first time this is loaded, most likely),
 		// we can create it with a single call, which is a lot more efficient and thread friendly
-		mesh = RS::get_singleton()->mesh_create_from_surfaces(surface_data, blend_shapes.size());
+		mesh = RS::get_singleton()->mesh_create_from_surfaces(resident_surface_data, blend_shapes.size());
 		RS::get_singleton()->mesh_set_blend_shape_mode(mesh, (RS::BlendShapeMode)blend_shape_mode);
 	}
 
@@ -1567,6 +1597,14 @@ void ArrayMesh::_set_surfaces(const Array &p_surfaces) {
 
 		surfaces.push_back(s);
 	}
+
+	if (residency_manager) {
+		if (stream_level > 0) {
+			residency_manager->register_mesh(this);
+		} else {
+			residency_manager->unregister(this);
+		}
+	}
 }
 
 bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
@@ -1634,6 +1672,7 @@ void ArrayMesh::_recompute_aabb() {
 #endif
 void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const Vector<uint8_t> &p_array, const Vector<uint8_t> &p_attribute_array, const Vector<uint8_t> &p_skin_array, int p_vertex_count, const Vector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<uint8_t> &p_blend_shape_data, const Vector<AABB> &p_bone_aabbs, const Vector<RS::SurfaceData::LOD> &p_lods) {
 	_create_if_empty();
+	_stop_streaming();
 
 	Surface s;
 	s.aabb = p_aabb;
@@ -1690,6 +1729,9 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &
 
 Array ArrayMesh::surface_get_arrays(int p_surface) const {
 	ERR_FAIL_INDEX_V(p_surface, surfaces.size(), Array());
+	if (!stream_surfaces.is_empty()) {
+		return RenderingServer::get_singleton()->mesh_create_arrays_from_surface_data(stream_surfaces[p_surface]);
+	}
 	return RenderingServer::get_singleton()->mesh_surface_get_arrays(mesh, p_surface);
 }
 
@@ -1827,18 +1869,21 @@ String ArrayMesh::surface_get_name(int p_idx) const {
 
 void ArrayMesh::surface_update_vertex_region(int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
 	ERR_FAIL_INDEX(p_surface, surfaces.size());
+	_stop_streaming();
 	RS::get_singleton()->mesh_surface_update_vertex_region(mesh, p_surface, p_offset, p_data);
 	emit_changed();
 }
 
 void ArrayMesh::surface_update_attribute_region(int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
 	ERR_FAIL_INDEX(p_surface, surfaces.size());
+	_stop_streaming();
 	RS::get_singleton()->mesh_surface_update_attribute_region(mesh, p_surface, p_offset, p_data);
 	emit_changed();
 }
 
 void ArrayMesh::surface_update_skin_region(int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
 	ERR_FAIL_INDEX(p_surface, surfaces.size());
+	_stop_streaming();
 	RS::get_singleton()->mesh_surface_update_skin_region(mesh, p_surface, p_offset, p_data);
 	emit_changed();
 }
@@ -1871,6 +1916,14 @@ void ArrayMesh::clear_surfaces() {
 	RS::get_singleton()->mesh_clear(mesh);
 	surfaces.clear();
 	aabb = AABB();
+
+	if (!stream_surfaces.is_empty()) {
+		stream_surfaces.clear();
+		stream_level = 0;
+		if (ResidencyManager::get_singleton()) {
+			ResidencyManager::get_singleton()->unregister(this);
+		}
+	}
 }
 
 void ArrayMesh::set_custom_aabb(const AABB &p_custom) {
@@ -2180,6 +2233,13 @@ void ArrayMesh::_bind_methods() {
 void ArrayMesh::reload_from_file() {
 	RenderingServer::get_singleton()->mesh_clear(mesh);
 	surfaces.clear();
+	if (!stream_surfaces.is_empty()) {
+		stream_surfaces.clear();
+		stream_level = 0;
+		if (ResidencyManager::get_singleton()) {
+			ResidencyManager::get_singleton()->unregister(this);
+		}
+	}
 	clear_blend_shapes();
 	clear_cache();
 
@@ -2193,7 +2253,85 @@ ArrayMesh::ArrayMesh() {
 	//mesh = RenderingServer::get_singleton()->mesh_create();
 }
 
+void ArrayMesh::_stop_streaming() {
+	if (stream_surfaces.is_empty()) {
+		return;
+	}
+	// Changes made from now on could not be reapplied when switching levels.
+	set_streaming_level(0);
+	stream_surfaces.clear();
+	if (ResidencyManager::get_singleton()) {
+		ResidencyManager::get_singleton()->unregister(this);
+	}
+}
+
+int ArrayMesh::get_streaming_level() const {
+	return stream_level;
+}
+
+uint64_t ArrayMesh::get_streaming_level_size(int p_level) const {
+	uint64_t size = 0;
+	for (int i = 0; i < stream_surfaces.size(); i++) {
+		const RS::SurfaceData &surface = stream_surfaces[i];
+		size += surface.vertex_data.size() + surface.attribute_data.size() + surface.skin_data.size() + surface.blend_shape_data.size();
+
+		int lod = MIN(p_level, surface.lods.size());
+		size += lod > 0 ? surface.lods[lod - 1].index_data.size() : surface.index_data.size();
+		for (int j = lod; j < surface.lods.size(); j++) {
+			size += surface.lods[j].index_data.size();
+		}
+	}
+	return size;
+}
+
+int ArrayMesh::get_streaming_level_for_screen_size(float p_screen_size, float p_lod_threshold) const {
+	float mesh_size = aabb.get_longest_axis_size();
+	if (stream_surfaces.is_empty() || mesh_size <= 0.0) {
+		return 0;
+	}
+
+	// Like the renderer, a LOD can be used as long as its edges stay under the threshold on screen.
+	float pixels_per_unit = p_screen_size / mesh_size;
+	int level = -1;
+	for (int i = 0; i < stream_surfaces.size(); i++) {
+		const Vector<RS::SurfaceData::LOD> &lods = stream_surfaces[i].lods;
+		if (lods.is_empty()) {
+			continue;
+		}
+		int usable = 0;
+		while (usable < lods.size() && lods[usable].edge_length * pixels_per_unit <= p_lod_threshold) {
+			usable++;
+		}
+		level = level < 0 ? usable : MIN(level, usable);
+	}
+	return MAX(level, 0);
+}
+
+void ArrayMesh::set_streaming_level(int p_level) {
+	ERR_FAIL_COND(stream_surfaces.size() != surfaces.size());
+	if (p_level == stream_level) {
+		return;
+	}
+
+	// Only the index buffers of the LODs that appear or disappear change, the vertex data stays as is.
+	for (int i = 0; i < stream_surfaces.size(); i++) {
+		const RS::SurfaceData &surface = stream_surfaces[i];
+		int from = MIN(stream_level, surface.lods.size());
+		int to = MIN(p_level, surface.lods.size());
+		if (to > from) {
+			RS::get_singleton()->mesh_surface_remove_finest_lods(mesh, i, to - from);
+		} else if (to < from) {
+			const Vector<uint8_t> &index_data = to > 0 ? surface.lods[to - 1].index_data : surface.index_data;
+			RS::get_singleton()->mesh_surface_add_finer_lods(mesh, i, index_data, surface.lods.slice(to, from - 1), surface.lods[from - 1].edge_length);
+		}
+	}
+	stream_level = p_level;
+}
+
 ArrayMesh::~ArrayMesh() {
+	if (!stream_surfaces.is_empty() && ResidencyManager::get_singleton()) {
+		ResidencyManager::get_singleton()->unregister(this);
+	}
 	if (mesh.is_valid()) {
 		RenderingServer::get_singleton()->free(mesh);
 	}
@@ -250,8 +250,15 @@ private:
 	Vector<StringName> blend_shapes;
 	AABB custom_aabb;
 
+	// Streaming, all the surface data is kept so finer LODs can be uploaded again
+	// once the mesh is large enough on screen. Vertex data is shared by all LODs,
+	// so only the index buffers are ever left out.
+	Vector<RS::SurfaceData> stream_surfaces;
+	int stream_level = 0; // Number of finer LODs not resident, 0 is full detail.
+
 	_FORCE_INLINE_ void _create_if_empty() const;
 	void _recompute_aabb();
+	void _stop_streaming();
 
 protected:
 	virtual bool _is_generated() const { return false; }
@@ -269,6 +276,11 @@ public:
 
 	void add_surface(uint32_t p_format, PrimitiveType p_primitive, const Vector<uint8_t> &p_array, const Vector<uint8_t> &p_attribute_array, const Vector<uint8_t> &p_skin_array, int p_vertex_count, const Vector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<uint8_t> &p_blend_shape_data = Vector<uint8_t>(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Vector<RS::SurfaceData::LOD> &p_lods = Vector<RS::SurfaceData::LOD>());
 
+	int get_streaming_level() const;
+	uint64_t get_streaming_level_size(int p_level) const;
+	int get_streaming_level_for_screen_size(float p_screen_size, float p_lod_threshold) const;
+	void set_streaming_level(int p_level);
+
 	Array surface_get_arrays(int p_surface) const override;
 	Array surface_get_blend_shape_arrays(int p_surface) const override;
 	Dictionary surface_get_lods(int p_surface) const override;
@@ -120,6 +120,8 @@ protected:
 	AABB filter_baking_aabb;
 	Vector3 filter_baking_aabb_offset;
 
+	float tile_size = 0.0f;
+
 public:
 	// Recast settings
 	void set_sample_partition_type(SamplePartitionType p_value);
@@ -194,6 +196,9 @@ public:
 	void set_filter_baking_aabb_offset(const Vector3 &p_aabb_offset);
 	Vector3 get_filter_baking_aabb_offset() const;
 
+	void set_tile_size(float p_value);
+	float get_tile_size() const;
+
 	void create_from_mesh(const Ref<Mesh> &p_mesh);
 
 	void set_vertices(const Vector<Vector3> &p_vertices);
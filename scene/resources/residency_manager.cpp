@@ -0,0 +1,365 @@
+/*************************************************************************/
+/*  residency_manager.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "residency_manager.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "scene/resources/mesh.h"
+#include "scene/resources/texture.h"
+#include "servers/rendering_server.h"
+
+ResidencyManager *ResidencyManager::singleton = nullptr;
+
+ResidencyManager *ResidencyManager::get_singleton() {
+	return singleton;
+}
+
+void ResidencyManager::_register(Resource *p_resource, Type p_type, RID p_rid, int p_level) {
+	MutexLock lock(mutex);
+
+	Entry &entry = entries[p_resource->get_instance_id()];
+	entry.type = p_type;
+	entry.resource = p_resource;
+	entry.rid = p_rid;
+	entry.level = p_level;
+	entry.max_level = p_level;
+	entry.loading_level = -1;
+	entry.last_visible_frame = 0;
+
+	RS::get_singleton()->streaming_feedback_set_enabled(p_rid, true);
+}
+
+void ResidencyManager::register_texture(CompressedTexture2D *p_texture) {
+	ERR_FAIL_COND(!enabled);
+	_register(p_texture, TYPE_TEXTURE, p_texture->get_rid(), p_texture->get_streaming_level());
+}
+
+void ResidencyManager::register_mesh(ArrayMesh *p_mesh) {
+	ERR_FAIL_COND(!enabled);
+	_register(p_mesh, TYPE_MESH, p_mesh->get_rid(), p_mesh->get_streaming_level());
+}
+
+void ResidencyManager::unregister(Resource *p_resource) {
+	MutexLock lock(mutex);
+
+	HashMap<ObjectID, Entry>::Iterator E = entries.find(p_resource->get_instance_id());
+	if (!E) {
+		return;
+	}
+	RS::get_singleton()->streaming_feedback_set_enabled(E->value.rid, false);
+	entries.remove(E);
+}
+
+uint64_t ResidencyManager::_get_level_size(const Entry &p_entry, int p_level) const {
+	if (p_entry.type == TYPE_TEXTURE) {
+		return static_cast<const CompressedTexture2D *>(p_entry.resource)->get_streaming_level_size(p_level);
+	}
+	return static_cast<const ArrayMesh *>(p_entry.resource)->get_streaming_level_size(p_level);
+}
+
+int ResidencyManager::_get_level_for_screen_size(const Entry &p_entry, float p_screen_size) const {
+	int level;
+	if (p_entry.type == TYPE_TEXTURE) {
+		level = static_cast<const CompressedTexture2D *>(p_entry.resource)->get_streaming_level_for_screen_size(p_screen_size);
+	} else {
+		level = static_cast<const ArrayMesh *>(p_entry.resource)->get_streaming_level_for_screen_size(p_screen_size, mesh_lod_threshold);
+	}
+	return MIN(level, p_entry.max_level);
+}
+
+bool ResidencyManager::_change_level(ObjectID p_id, Entry &p_entry, int p_level, LocalVector<LevelChange> &r_changes) {
+	// Fails if the resource is being freed, it will unregister itself right after.
+	LevelChange change;
+	change.resource = Ref<Resource>(p_entry.resource);
+	if (change.resource.is_null()) {
+		return false;
+	}
+	change.id = p_id;
+	change.type = p_entry.type;
+	change.level = p_level;
+	r_changes.push_back(change);
+
+	// Textures need their mipmaps read again, meshes switch right away.
+	if (p_entry.type == TYPE_TEXTURE) {
+		p_entry.loading_level = p_level;
+	} else {
+		p_entry.level = p_level;
+	}
+	return true;
+}
+
+void ResidencyManager::_load_texture(TextureLoad *p_load) {
+	p_load->image = static_cast<CompressedTexture2D *>(p_load->texture.ptr())->load_streaming_level(p_load->level);
+}
+
+void ResidencyManager::_finish_texture_loads(bool p_wait) {
+	for (uint32_t i = 0; i < texture_loads.size(); i++) {
+		TextureLoad *load = texture_loads[i];
+		if (!p_wait && !WorkerThreadPool::get_singleton()->is_task_completed(load->task_id)) {
+			continue;
+		}
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(load->task_id);
+		texture_loads.remove_at_unordered(i);
+		i--;
+
+		bool apply = false;
+		{
+			MutexLock lock(mutex);
+			// The texture may have been loaded again in the meantime.
+			Entry *entry = entries.getptr(load->id);
+			if (entry && entry->loading_level == load->level) {
+				entry->loading_level = -1;
+				if (load->image.is_valid()) {
+					entry->level = load->level;
+					apply = !p_wait;
+				}
+			}
+		}
+		if (apply) {
+			static_cast<CompressedTexture2D *>(load->texture.ptr())->set_streaming_level(load->level, load->image);
+		}
+
+		memdelete(load);
+	}
+}
+
+struct _ResidencyStreamIn {
+	uint32_t request = 0;
+	float screen_size = 0.0f;
+
+	// Largest on screen first.
+	bool operator<(const _ResidencyStreamIn &p_other) const { return screen_size > p_other.screen_size; }
+};
+
+struct _ResidencyEviction {
+	uint32_t request = 0;
+	uint64_t last_visible_frame = 0;
+
+	// Least recently seen first.
+	bool operator<(const _ResidencyEviction &p_other) const { return last_visible_frame < p_other.last_visible_frame; }
+};
+
+uint64_t ResidencyManager::select_levels(const LocalVector<LevelRequest> &p_requests, uint64_t p_memory, uint64_t p_memory_budget, uint32_t p_max_loads, LocalVector<LevelSelection> &r_selections) {
+	LocalVector<_ResidencyStreamIn> stream_in;
+	LocalVector<_ResidencyEviction> evictions;
+
+	for (uint32_t i = 0; i < p_requests.size(); i++) {
+		const LevelRequest &request = p_requests[i];
+		ERR_CONTINUE((uint32_t)MAX(request.level, request.wanted_level) >= request.level_sizes.size());
+
+		if (request.wanted_level < request.level) {
+			_ResidencyStreamIn candidate;
+			candidate.request = i;
+			candidate.screen_size = request.screen_size;
+			stream_in.push_back(candidate);
+		} else if (request.wanted_level > request.level) {
+			// Detail not needed anymore is kept until its memory is needed.
+			_ResidencyEviction candidate;
+			candidate.request = i;
+			candidate.last_visible_frame = request.last_visible_frame;
+			evictions.push_back(candidate);
+		}
+	}
+
+	stream_in.sort();
+	evictions.sort();
+	uint32_t eviction_index = 0;
+
+#define EVICT_NEXT()                                                                                                                \
+	{                                                                                                                               \
+		const uint32_t evicted = evictions[eviction_index++].request;                                                               \
+		const LevelRequest &evicted_request = p_requests[evicted];                                                                  \
+		p_memory -= evicted_request.level_sizes[evicted_request.level] - evicted_request.level_sizes[evicted_request.wanted_level]; \
+		LevelSelection selection;                                                                                                   \
+		selection.request = evicted;                                                                                                \
+		selection.level = evicted_request.wanted_level;                                                                             \
+		selection.eviction = true;                                                                                                  \
+		r_selections.push_back(selection);                                                                                          \
+	}
+
+	uint32_t loads = 0;
+	for (uint32_t i = 0; i < stream_in.size() && loads < p_max_loads; i++) {
+		const LevelRequest &request = p_requests[stream_in[i].request];
+		uint64_t current_size = request.level_sizes[request.level];
+
+		int level = request.wanted_level;
+		while (p_memory - current_size + request.level_sizes[level] > p_memory_budget && eviction_index < evictions.size()) {
+			EVICT_NEXT();
+		}
+		// Settle for less detail when there is still no room.
+		while (level < request.level && p_memory - current_size + request.level_sizes[level] > p_memory_budget) {
+			level++;
+		}
+		if (level == request.level) {
+			continue;
+		}
+
+		LevelSelection selection;
+		selection.request = stream_in[i].request;
+		selection.level = level;
+		r_selections.push_back(selection);
+		p_memory += request.level_sizes[level] - current_size;
+		loads++;
+	}
+
+	// The budget may still be exceeded, e.g. if it was lowered.
+	while (p_memory > p_memory_budget && eviction_index < evictions.size()) {
+		EVICT_NEXT();
+	}
+
+#undef EVICT_NEXT
+
+	return p_memory;
+}
+
+void ResidencyManager::update() {
+	if (!enabled) {
+		return;
+	}
+
+	_finish_texture_loads(false);
+
+	uint64_t frame = Engine::get_singleton()->get_process_frames();
+	LocalVector<LevelChange> changes;
+
+	{
+		MutexLock lock(mutex);
+
+		LocalVector<LevelRequest> requests;
+		LocalVector<ObjectID> request_ids;
+
+		// What is resident once the pending loads are done.
+		uint64_t projected_memory = 0;
+		resident_memory = 0;
+		full_memory = 0;
+
+		for (KeyValue<ObjectID, Entry> &E : entries) {
+			Entry &entry = E.value;
+			float screen_size = RS::get_singleton()->streaming_feedback_get_screen_size(entry.rid);
+			if (screen_size > 0.0f) {
+				entry.last_visible_frame = frame;
+			}
+
+			resident_memory += _get_level_size(entry, entry.level);
+			full_memory += _get_level_size(entry, 0);
+			if (entry.loading_level >= 0) {
+				projected_memory += _get_level_size(entry, entry.loading_level);
+				continue;
+			}
+			projected_memory += _get_level_size(entry, entry.level);
+
+			int wanted = screen_size > 0.0f ? _get_level_for_screen_size(entry, screen_size) : entry.max_level;
+			if (wanted == entry.level) {
+				continue;
+			}
+
+			LevelRequest request;
+			request.level = entry.level;
+			request.wanted_level = wanted;
+			request.screen_size = screen_size;
+			request.last_visible_frame = entry.last_visible_frame;
+			request.level_sizes.resize(MAX(entry.level, wanted) + 1);
+			for (uint32_t i = 0; i < request.level_sizes.size(); i++) {
+				request.level_sizes[i] = _get_level_size(entry, i);
+			}
+			requests.push_back(request);
+			request_ids.push_back(E.key);
+		}
+
+		LocalVector<LevelSelection> selections;
+		select_levels(requests, projected_memory, memory_budget, max_loads_per_frame, selections);
+
+		for (uint32_t i = 0; i < selections.size(); i++) {
+			const ObjectID id = request_ids[selections[i].request];
+			if (_change_level(id, *entries.getptr(id), selections[i].level, changes) && selections[i].eviction) {
+				eviction_count++;
+			}
+		}
+	}
+
+	// Applied without the lock, as releasing the last reference to a resource unregisters it.
+	for (uint32_t i = 0; i < changes.size(); i++) {
+		LevelChange &change = changes[i];
+		if (change.type == TYPE_MESH) {
+			static_cast<ArrayMesh *>(change.resource.ptr())->set_streaming_level(change.level);
+			continue;
+		}
+
+		TextureLoad *load = memnew(TextureLoad);
+		load->id = change.id;
+		load->texture = change.resource;
+		load->level = change.level;
+		load->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &ResidencyManager::_load_texture, load, false, "Stream texture");
+		texture_loads.push_back(load);
+	}
+}
+
+uint64_t ResidencyManager::get_memory_budget() const {
+	return enabled ? memory_budget : 0;
+}
+
+uint64_t ResidencyManager::get_resident_memory() const {
+	return resident_memory;
+}
+
+uint64_t ResidencyManager::get_full_memory() const {
+	return full_memory;
+}
+
+uint32_t ResidencyManager::get_resource_count() const {
+	return entries.size();
+}
+
+uint32_t ResidencyManager::get_pending_load_count() const {
+	return texture_loads.size();
+}
+
+uint64_t ResidencyManager::get_eviction_count() const {
+	return eviction_count;
+}
+
+ResidencyManager::ResidencyManager() {
+	singleton = this;
+
+	// Streaming only makes sense when running the project, the editor needs the full resources.
+	enabled = GLOBAL_DEF("rendering/streaming/enabled", false) && !Engine::get_singleton()->is_editor_hint();
+	memory_budget = uint64_t(int(GLOBAL_DEF("rendering/streaming/memory_budget_mb", 512))) * 1024 * 1024;
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/streaming/memory_budget_mb", PropertyInfo(Variant::INT, "rendering/streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "1,65536,1,or_greater,suffix:MiB"));
+	texture_initial_size = GLOBAL_DEF("rendering/streaming/texture_initial_size", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/streaming/texture_initial_size", PropertyInfo(Variant::INT, "rendering/streaming/texture_initial_size", PROPERTY_HINT_RANGE, "1,4096,1,suffix:px"));
+	max_loads_per_frame = MAX(int(GLOBAL_DEF("rendering/streaming/max_loads_per_frame", 4)), 1);
+	mesh_lod_threshold = GLOBAL_DEF("rendering/mesh_lod/lod_change/threshold_pixels", 1.0);
+}
+
+ResidencyManager::~ResidencyManager() {
+	_finish_texture_loads(true);
+	singleton = nullptr;
+}
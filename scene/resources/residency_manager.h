@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  residency_manager.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RESIDENCY_MANAGER_H
+#define RESIDENCY_MANAGER_H
+
+#include "core/io/image.h"
+#include "core/io/resource.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class ArrayMesh;
+class CompressedTexture2D;
+
+// Keeps resident only the detail of streamed resources that is actually seen:
+// the top mipmaps of CompressedTexture2D and the finer LODs of ArrayMesh.
+// They are loaded at their coarsest level, finer levels are streamed in from
+// the size on screen reported by the RenderingServer, and dropped again from
+// the resources seen least recently when going over the memory budget.
+class ResidencyManager {
+	enum Type {
+		TYPE_TEXTURE,
+		TYPE_MESH,
+	};
+
+	struct Entry {
+		Type type = TYPE_TEXTURE;
+		Resource *resource = nullptr;
+		RID rid;
+		int level = 0; // Resident level, 0 is full detail.
+		int max_level = 0; // Coarsest level, always resident.
+		int loading_level = -1;
+		uint64_t last_visible_frame = 0;
+	};
+
+	struct TextureLoad {
+		ObjectID id;
+		Ref<Resource> texture;
+		int level = 0;
+		Ref<Image> image;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	struct LevelChange {
+		ObjectID id;
+		Ref<Resource> resource;
+		Type type = TYPE_TEXTURE;
+		int level = 0;
+	};
+
+	static ResidencyManager *singleton;
+
+	bool enabled = false;
+	uint64_t memory_budget = 0;
+	int texture_initial_size = 0;
+	uint32_t max_loads_per_frame = 0;
+	float mesh_lod_threshold = 1.0;
+
+	Mutex mutex;
+	HashMap<ObjectID, Entry> entries;
+	LocalVector<TextureLoad *> texture_loads;
+
+	uint64_t resident_memory = 0;
+	uint64_t full_memory = 0;
+	uint64_t eviction_count = 0;
+
+	void _register(Resource *p_resource, Type p_type, RID p_rid, int p_level);
+	uint64_t _get_level_size(const Entry &p_entry, int p_level) const;
+	int _get_level_for_screen_size(const Entry &p_entry, float p_screen_size) const;
+	bool _change_level(ObjectID p_id, Entry &p_entry, int p_level, LocalVector<LevelChange> &r_changes);
+	void _load_texture(TextureLoad *p_load);
+	void _finish_texture_loads(bool p_wait);
+
+public:
+	// A resource that wants another level, for select_levels().
+	struct LevelRequest {
+		int level = 0; // Resident level.
+		int wanted_level = 0;
+		float screen_size = 0.0f;
+		uint64_t last_visible_frame = 0;
+		LocalVector<uint64_t> level_sizes; // Memory used at each level, at least up to the resident and wanted levels.
+	};
+
+	struct LevelSelection {
+		uint32_t request = 0; // Index in the requests.
+		int level = 0;
+		bool eviction = false;
+	};
+
+	// Picks the level changes to make this frame. The largest resources on screen
+	// get more detail first, up to p_max_loads of them, making room by reducing the
+	// resources seen least recently. Returns the memory used once they're made.
+	static uint64_t select_levels(const LocalVector<LevelRequest> &p_requests, uint64_t p_memory, uint64_t p_memory_budget, uint32_t p_max_loads, LocalVector<LevelSelection> &r_selections);
+
+	static ResidencyManager *get_singleton();
+
+	_FORCE_INLINE_ bool is_enabled() const { return enabled; }
+	// Largest mipmap streamed textures are loaded with, 0 when streaming is disabled.
+	_FORCE_INLINE_ int get_texture_initial_size() const { return enabled ? texture_initial_size : 0; }
+
+	void register_texture(CompressedTexture2D *p_texture);
+	void register_mesh(ArrayMesh *p_mesh);
+	void unregister(Resource *p_resource);
+
+	void update();
+
+	uint64_t get_memory_budget() const;
+	uint64_t get_resident_memory() const;
+	uint64_t get_full_memory() const;
+	uint32_t get_resource_count() const;
+	uint32_t get_pending_load_count() const;
+	uint64_t get_eviction_count() const;
+
+	ResidencyManager();
+	~ResidencyManager();
+};
+
+#endif // RESIDENCY_MANAGER_H
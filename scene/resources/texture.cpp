@@ -37,6 +37,7 @@
 #include "core/os/os.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
+#include "scene/resources/residency_manager.h"
 #include "servers/camera/camera_feed.h"
 int Texture2D::get_width() const {
 	int ret;
@@ -666,7 +667,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -739,7 +740,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
@@ -750,13 +751,14 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			if (ofs) {
+				f->seek(f->get_position() + ofs);
+			}
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -861,6 +863,15 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 		p_size_limit = 0;
 	}
 
+	// Remember where the mipmaps are, so the missing ones can be streamed in later.
+	stream_data_offset = f->get_position();
+	f->get_32(); // Data format.
+	stream_width = f->get_16();
+	stream_height = f->get_16();
+	uint32_t mipmaps = f->get_32();
+	stream_mipmaps = (df & FORMAT_BIT_STREAM) ? mipmaps : 0;
+	f->seek(stream_data_offset);
+
 	image = load_image_from_file(f, p_size_limit);
 
 	if (image.is_null() || image->is_empty()) {
@@ -880,11 +891,19 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_roughness;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	ResidencyManager *residency_manager = ResidencyManager::get_singleton();
+	int size_limit = residency_manager ? residency_manager->get_texture_initial_size() : 0;
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, size_limit);
 	if (err) {
 		return err;
 	}
 
+	stream_level = 0;
+	while (stream_level < stream_mipmaps && (MAX(stream_width >> stream_level, 1) != image->get_width() || MAX(stream_height >> stream_level, 1) != image->get_height())) {
+		stream_level++;
+	}
+
 	if (texture.is_valid()) {
 		RID new_texture = RS::get_singleton()->texture_2d_create(image);
 		RS::get_singleton()->texture_replace(texture, new_texture);
@@ -932,6 +951,14 @@ Error CompressedTexture2D::load(const String &p_path) {
 	}
 
 #endif
+	if (residency_manager) {
+		if (stream_level > 0) {
+			residency_manager->register_texture(this);
+		} else {
+			residency_manager->unregister(this);
+		}
+	}
+
 	notify_property_list_changed();
 	emit_changed();
 	return OK;
@@ -1023,6 +1050,49 @@ bool CompressedTexture2D::is_pixel_opaque(int p_x, int p_y) const {
 	return true;
 }
 
+int CompressedTexture2D::get_streaming_level() const {
+	return stream_level;
+}
+
+uint64_t CompressedTexture2D::get_streaming_level_size(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, stream_mipmaps + 1, 0);
+	return Image::get_image_data_size(MAX(stream_width >> p_level, 1), MAX(stream_height >> p_level, 1), format, p_level < stream_mipmaps);
+}
+
+int CompressedTexture2D::get_streaming_level_for_screen_size(float p_screen_size) const {
+	// The largest mipmap sampled is about as big as the area covered on screen.
+	int level = 0;
+	while (level < stream_mipmaps && MAX(stream_width >> (level + 1), stream_height >> (level + 1)) >= p_screen_size) {
+		level++;
+	}
+	return level;
+}
+
+Ref<Image> CompressedTexture2D::load_streaming_level(int p_level) const {
+	ERR_FAIL_INDEX_V(p_level, stream_mipmaps + 1, Ref<Image>());
+
+	Ref<FileAccess> f = FileAccess::open(path_to_file, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), Ref<Image>(), vformat("Unable to open file: %s.", path_to_file));
+
+	// The header was already validated when the texture was loaded.
+	f->seek(stream_data_offset);
+	int size_limit = MAX(MAX(stream_width >> p_level, stream_height >> p_level), 1);
+	return load_image_from_file(f, size_limit);
+}
+
+void CompressedTexture2D::set_streaming_level(int p_level, const Ref<Image> &p_image) {
+	ERR_FAIL_INDEX(p_level, stream_mipmaps + 1);
+	ERR_FAIL_COND(p_image.is_null() || p_image->is_empty() || !texture.is_valid());
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	RS::get_singleton()->texture_set_path(texture, get_path().is_empty() ? path_to_file : get_path());
+
+	stream_level = p_level;
+	alpha_cache.unref();
+}
+
 void CompressedTexture2D::reload_from_file() {
 	String path = get_path();
 	if (!path.is_resource_file()) {
@@ -1051,6 +1121,9 @@ void CompressedTexture2D::_bind_methods() {
 CompressedTexture2D::CompressedTexture2D() {}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	if (ResidencyManager::get_singleton()) {
+		ResidencyManager::get_singleton()->unregister(this);
+	}
 	if (texture.is_valid()) {
 		RS::get_singleton()->free(texture);
 	}
@@ -243,6 +243,13 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
+	// Streaming, the top mipmaps are only resident once the texture is large enough on screen.
+	uint64_t stream_data_offset = 0;
+	int stream_width = 0; // Size of the largest mipmap stored.
+	int stream_height = 0;
+	int stream_mipmaps = 0; // Zero if the texture can't be streamed.
+	int stream_level = 0; // Number of top mipmaps not resident.
+
 	virtual void reload_from_file() override;
 
 	static void _requested_3d(void *p_ud);
@@ -282,6 +289,12 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	int get_streaming_level() const;
+	uint64_t get_streaming_level_size(int p_level) const;
+	int get_streaming_level_for_screen_size(float p_screen_size) const;
+	Ref<Image> load_streaming_level(int p_level) const;
+	void set_streaming_level(int p_level, const Ref<Image> &p_image);
+
 	CompressedTexture2D();
 	~CompressedTexture2D();
 };
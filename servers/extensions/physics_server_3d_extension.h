@@ -242,6 +242,9 @@ public:
 
 	EXBIND1R(PhysicsDirectSpaceState3D *, space_get_direct_state, RID)
 
+	EXBIND1RC(PackedByteArray, space_save_state, RID)
+	EXBIND2R(Error, space_restore_state, RID, const PackedByteArray &)
+
 	EXBIND2(space_set_debug_contacts, RID, int)
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
@@ -169,6 +169,10 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_set_edge_connection_margin", "map", "margin"), &NavigationServer2D::map_set_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer2D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer2D::map_get_path, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_paths", "map", "enabled"), &NavigationServer2D::map_set_use_hierarchical_paths);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_paths", "map"), &NavigationServer2D::map_get_use_hierarchical_paths);
+	ClassDB::bind_method(D_METHOD("map_get_region_corridor", "map", "origin", "destination", "navigation_layers"), &NavigationServer2D::map_get_region_corridor, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("map_get_partial_path", "map", "origin", "destination", "optimize", "navigation_layers", "max_regions"), &NavigationServer2D::map_get_partial_path, DEFVAL(1), DEFVAL(2));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer2D::map_get_closest_point);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_owner", "map", "to_point"), &NavigationServer2D::map_get_closest_point_owner);
 
@@ -250,6 +254,14 @@ real_t FORWARD_1_C(map_get_edge_connection_margin, RID, p_map, rid_to_rid);
 
 Vector<Vector2> FORWARD_5_R_C(vector_v3_to_v2, map_get_path, RID, p_map, Vector2, p_origin, Vector2, p_destination, bool, p_optimize, uint32_t, p_layers, rid_to_rid, v2_to_v3, v2_to_v3, bool_to_bool, uint32_to_uint32);
 
+void FORWARD_2_C(map_set_use_hierarchical_paths, RID, p_map, bool, p_enabled, rid_to_rid, bool_to_bool);
+bool FORWARD_1_C(map_get_use_hierarchical_paths, RID, p_map, rid_to_rid);
+Array FORWARD_4_C(map_get_region_corridor, RID, p_map, Vector2, p_origin, Vector2, p_destination, uint32_t, p_layers, rid_to_rid, v2_to_v3, v2_to_v3, uint32_to_uint32);
+
+Vector<Vector2> NavigationServer2D::map_get_partial_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers, int p_max_regions) const {
+	return vector_v3_to_v2(NavigationServer3D::get_singleton()->map_get_partial_path(p_map, v2_to_v3(p_origin), v2_to_v3(p_destination), p_optimize, p_navigation_layers, p_max_regions));
+}
+
 Vector2 FORWARD_2_R_C(v3_to_v2, map_get_closest_point, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
 RID FORWARD_2_C(map_get_closest_point_owner, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
 
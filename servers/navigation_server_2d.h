@@ -79,6 +79,18 @@ public:
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
 
+	/// Set if the paths crossing several regions are planned on the graph of the region portals first.
+	virtual void map_set_use_hierarchical_paths(RID p_map, bool p_enabled) const;
+
+	/// Returns true if the paths crossing several regions are planned on the graph of the region portals first.
+	virtual bool map_get_use_hierarchical_paths(RID p_map) const;
+
+	/// Returns the regions to cross to reach the destination from the origin.
+	virtual Array map_get_region_corridor(RID p_map, Vector2 p_origin, Vector2 p_destination, uint32_t p_navigation_layers = 1) const;
+
+	/// Returns the navigation path toward the destination, going through at most the given number of regions.
+	virtual Vector<Vector2> map_get_partial_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1, int p_max_regions = 2) const;
+
 	virtual Vector2 map_get_closest_point(RID p_map, const Vector2 &p_point) const;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector2 &p_point) const;
 
@@ -49,6 +49,11 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_set_edge_connection_margin", "map", "margin"), &NavigationServer3D::map_set_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer3D::map_get_path, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("map_request_paths", "map", "origins", "destinations", "optimize", "navigation_layers", "callback"), &NavigationServer3D::map_request_paths);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_paths", "map", "enabled"), &NavigationServer3D::map_set_use_hierarchical_paths);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_paths", "map"), &NavigationServer3D::map_get_use_hierarchical_paths);
+	ClassDB::bind_method(D_METHOD("map_get_region_corridor", "map", "origin", "destination", "navigation_layers"), &NavigationServer3D::map_get_region_corridor, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("map_get_partial_path", "map", "origin", "destination", "optimize", "navigation_layers", "max_regions"), &NavigationServer3D::map_get_partial_path, DEFVAL(1), DEFVAL(2));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_to_segment", "map", "start", "end", "use_collision"), &NavigationServer3D::map_get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer3D::map_get_closest_point);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_normal", "map", "to_point"), &NavigationServer3D::map_get_closest_point_normal);
@@ -95,6 +100,14 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &NavigationServer3D::set_active);
 	ClassDB::bind_method(D_METHOD("process", "delta_time"), &NavigationServer3D::process);
 
+	ClassDB::bind_method(D_METHOD("get_process_info", "process_info"), &NavigationServer3D::get_process_info);
+
+	BIND_ENUM_CONSTANT(INFO_ACTIVE_MAPS);
+	BIND_ENUM_CONSTANT(INFO_REGION_COUNT);
+	BIND_ENUM_CONSTANT(INFO_POLYGON_COUNT);
+	BIND_ENUM_CONSTANT(INFO_EDGE_CONNECTION_COUNT);
+	BIND_ENUM_CONSTANT(INFO_SYNC_TIME);
+
 	ADD_SIGNAL(MethodInfo("map_changed", PropertyInfo(Variant::RID, "map")));
 
 	ADD_SIGNAL(MethodInfo("navigation_debug_changed"));
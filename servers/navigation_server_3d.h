@@ -88,6 +88,22 @@ public:
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
+	/// Queue a batch of path queries, resolved on the worker threads after the next sync.
+	/// The callback receives an `Array` with a path per origin/destination pair during the following process.
+	virtual void map_request_paths(RID p_map, const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers, const Callable &p_callback) const = 0;
+
+	/// Set if the paths crossing several regions are planned on the graph of the region portals first.
+	virtual void map_set_use_hierarchical_paths(RID p_map, bool p_enabled) const = 0;
+
+	/// Returns true if the paths crossing several regions are planned on the graph of the region portals first.
+	virtual bool map_get_use_hierarchical_paths(RID p_map) const = 0;
+
+	/// Returns the regions to cross to reach the destination from the origin.
+	virtual Array map_get_region_corridor(RID p_map, Vector3 p_origin, Vector3 p_destination, uint32_t p_navigation_layers = 1) const = 0;
+
+	/// Returns the navigation path toward the destination, going through at most the given number of regions.
+	virtual Vector<Vector3> map_get_partial_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1, int p_max_regions = 2) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -205,6 +221,17 @@ public:
 	/// Note: This function is not thread safe.
 	virtual void process(real_t delta_time) = 0;
 
+	enum ProcessInfo {
+		INFO_ACTIVE_MAPS,
+		INFO_REGION_COUNT,
+		INFO_POLYGON_COUNT,
+		INFO_EDGE_CONNECTION_COUNT,
+		INFO_SYNC_TIME,
+	};
+
+	/// Stats of the last `process`, the sync time is in microseconds.
+	virtual int get_process_info(ProcessInfo p_info) const = 0;
+
 	NavigationServer3D();
 	virtual ~NavigationServer3D();
 
@@ -282,4 +309,6 @@ public:
 	static NavigationServer3D *new_default_server();
 };
 
+VARIANT_ENUM_CAST(NavigationServer3D::ProcessInfo);
+
 #endif // NAVIGATION_SERVER_3D_H
@@ -604,7 +604,8 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		integration_updates |= INTEGRATION_UPDATE_SHAPES_WITH_MOTION;
+		integration_motion = motion;
 	}
 
 	contact_count = 0;
@@ -616,14 +617,14 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	}
 
 	if (fi_callback_data || body_state_callback) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		integration_updates |= INTEGRATION_UPDATE_STATE_QUERY;
 	}
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			integration_updates |= INTEGRATION_UPDATE_DEACTIVATE; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -640,16 +641,56 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	Transform2D xform(angle, pos);
+
+	real_t fixed_point_step = get_space()->get_fixed_point_step();
+	if (fixed_point_step > 0.0) {
+		// Keep the state on the fixed-point grid, so what is carried over to the next
+		// step doesn't depend on rounding differences in the float math.
+		Vector2 snap(fixed_point_step, fixed_point_step);
+		xform.columns[0] = xform.columns[0].snapped(snap);
+		xform.columns[1] = xform.columns[1].snapped(snap);
+		xform.columns[2] = xform.columns[2].snapped(snap);
+		linear_velocity = linear_velocity.snapped(snap);
+		angular_velocity = Math::snapped(angular_velocity, fixed_point_step);
+	}
+
+	_set_transform(xform, false);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
 		new_transform = get_transform();
+	} else {
+		integration_updates |= INTEGRATION_UPDATE_SHAPES;
 	}
 
 	_update_transform_dependent();
 }
 
+void GodotBody2D::apply_integration() {
+	if (!integration_updates) {
+		return;
+	}
+
+	if (integration_updates & INTEGRATION_UPDATE_SHAPES_WITH_MOTION) {
+		_update_shapes_with_motion(integration_motion);
+	}
+
+	if (integration_updates & INTEGRATION_UPDATE_SHAPES) {
+		_set_transform(get_transform());
+	}
+
+	if (integration_updates & INTEGRATION_UPDATE_STATE_QUERY) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (integration_updates & INTEGRATION_UPDATE_DEACTIVATE) {
+		set_active(false);
+	}
+
+	integration_updates = 0;
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -713,6 +754,32 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::save_state(State &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody2D::restore_state(const State &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.transform.affine_inverse());
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	integration_updates = 0;
+
+	_update_transform_dependent();
+	set_active(p_state.active);
+}
+
 void GodotBody2D::set_state_sync_callback(void *p_instance, PhysicsServer2D::BodyStateCallback p_callback) {
 	body_state_callback_instance = p_instance;
 	body_state_callback = p_callback;
@@ -112,7 +112,12 @@ class GodotBody2D : public GodotCollisionObject2D {
 		GodotArea2D *area = nullptr;
 		int refCount = 0;
 		_FORCE_INLINE_ bool operator==(const AreaCMP &p_cmp) const { return area->get_self() == p_cmp.area->get_self(); }
-		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const { return area->get_priority() < p_cmp.area->get_priority(); }
+		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const {
+			if (area->get_priority() == p_cmp.area->get_priority()) {
+				return area->get_space_order() < p_cmp.area->get_space_order();
+			}
+			return area->get_priority() < p_cmp.area->get_priority();
+		}
 		_FORCE_INLINE_ AreaCMP() {}
 		_FORCE_INLINE_ AreaCMP(GodotArea2D *p_area) {
 			area = p_area;
@@ -151,6 +156,18 @@ class GodotBody2D : public GodotCollisionObject2D {
 
 	uint64_t island_step = 0;
 
+	// Integration runs on worker threads, so the parts of it that touch the
+	// broadphase or the space lists are recorded here and done in apply_integration().
+	enum IntegrationUpdate {
+		INTEGRATION_UPDATE_SHAPES = 1,
+		INTEGRATION_UPDATE_SHAPES_WITH_MOTION = 2,
+		INTEGRATION_UPDATE_STATE_QUERY = 4,
+		INTEGRATION_UPDATE_DEACTIVATE = 8,
+	};
+
+	uint32_t integration_updates = 0;
+	Vector2 integration_motion;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
@@ -314,8 +331,10 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Thread-safe for different bodies, must be followed by apply_integration().
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_integration();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -335,6 +354,21 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state, as saved in space snapshots.
+	struct State {
+		Transform2D transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	GodotBody2D();
 	~GodotBody2D();
 };
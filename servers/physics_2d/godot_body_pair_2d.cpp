@@ -571,8 +571,50 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::save_state(State &r_state) const {
+	r_state.sep_axis = sep_axis;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	r_state.oneway_disabled = oneway_disabled;
+
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		const Contact &c = contacts[i];
+		State::ContactState &cs = r_state.contacts[i];
+		cs.normal = c.normal;
+		cs.local_A = c.local_A;
+		cs.local_B = c.local_B;
+		cs.acc_normal_impulse = c.acc_normal_impulse;
+		cs.acc_tangent_impulse = c.acc_tangent_impulse;
+		cs.acc_bias_impulse = c.acc_bias_impulse;
+		cs.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		cs.used = c.used;
+	}
+}
+
+void GodotBodyPair2D::restore_state(const State &p_state) {
+	sep_axis = p_state.sep_axis;
+	contact_count = CLAMP(p_state.contact_count, 0, (int)MAX_CONTACTS);
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		const State::ContactState &cs = p_state.contacts[i];
+		Contact &c = contacts[i];
+		c = Contact();
+		c.normal = cs.normal;
+		c.local_A = cs.local_A;
+		c.local_B = cs.local_B;
+		c.acc_normal_impulse = cs.acc_normal_impulse;
+		c.acc_tangent_impulse = cs.acc_tangent_impulse;
+		c.acc_bias_impulse = cs.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = cs.acc_bias_impulse_center_of_mass;
+		c.used = cs.used;
+	}
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
-		GodotConstraint2D(_arr, 2) {
+		GodotConstraint2D(_arr, 2),
+		body_pair_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -580,9 +622,13 @@ GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+
+	space->body_pair_add(&body_pair_list);
 }
 
 GodotBodyPair2D::~GodotBodyPair2D() {
 	A->remove_constraint(this, 0);
 	B->remove_constraint(this, 1);
+
+	space->body_pair_remove(&body_pair_list);
 }
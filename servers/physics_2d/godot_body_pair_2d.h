@@ -35,9 +35,12 @@
 #include "godot_constraint_2d.h"
 
 class GodotBodyPair2D : public GodotConstraint2D {
+public:
 	enum {
 		MAX_CONTACTS = 2
 	};
+
+private:
 	union {
 		struct {
 			GodotBody2D *A;
@@ -54,6 +57,7 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool collide_B = false;
 
 	GodotSpace2D *space = nullptr;
+	SelfList<GodotBodyPair2D> body_pair_list;
 
 	struct Contact {
 		Vector2 position;
@@ -89,6 +93,35 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Contact state carried over between steps, as saved in space snapshots.
+	struct State {
+		struct ContactState {
+			Vector2 normal;
+			Vector2 local_A, local_B;
+			real_t acc_normal_impulse = 0.0;
+			real_t acc_tangent_impulse = 0.0;
+			real_t acc_bias_impulse = 0.0;
+			real_t acc_bias_impulse_center_of_mass = 0.0;
+			bool used = false;
+		};
+
+		Vector2 sep_axis;
+		ContactState contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+		bool oneway_disabled = false;
+	};
+
+	_FORCE_INLINE_ GodotBody2D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
+	virtual uint64_t get_order_subkey() const override { return ((uint64_t)shape_A << 32) | (uint32_t)shape_B; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -63,6 +63,10 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
+	// Margin added around objects when testing for pairs, so that objects moving a little
+	// don't need pairing tests every step. With zero margin, pairs only depend on current bounds.
+	virtual void set_pairing_expansion(real_t p_expansion) = 0;
+
 	virtual void update() = 0;
 
 	virtual ~GodotBroadPhase2D();
@@ -109,6 +109,10 @@ void GodotBroadPhase2DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void GodotBroadPhase2DBVH::set_pairing_expansion(real_t p_expansion) {
+	bvh.params_set_pairing_expansion(p_expansion);
+}
+
 void GodotBroadPhase2DBVH::update() {
 	bvh.update();
 }
@@ -120,4 +124,5 @@ GodotBroadPhase2D *GodotBroadPhase2DBVH::_create() {
 GodotBroadPhase2DBVH::GodotBroadPhase2DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.params_set_threaded_pairing(true);
 }
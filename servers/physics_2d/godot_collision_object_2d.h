@@ -66,6 +66,7 @@ private:
 
 	Vector<Shape> shapes;
 	GodotSpace2D *space = nullptr;
+	uint64_t space_order = 0;
 	Transform2D transform;
 	Transform2D inv_transform;
 	uint32_t collision_mask = 1;
@@ -133,6 +134,11 @@ public:
 	_FORCE_INLINE_ const Transform2D &get_inv_transform() const { return inv_transform; }
 	_FORCE_INLINE_ GodotSpace2D *get_space() const { return space; }
 
+	// Order in which the object was added to its space, used instead of addresses
+	// or RIDs to sort objects when the space is deterministic.
+	_FORCE_INLINE_ void set_space_order(uint64_t p_order) { space_order = p_order; }
+	_FORCE_INLINE_ uint64_t get_space_order() const { return space_order; }
+
 	void set_shape_disabled(int p_idx, bool p_disabled);
 	_FORCE_INLINE_ bool is_shape_disabled(int p_idx) const {
 		ERR_FAIL_INDEX_V(p_idx, shapes.size(), false);
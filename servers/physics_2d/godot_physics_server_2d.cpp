@@ -284,6 +284,22 @@ PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer2D::space_save_state(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+Error GodotPhysicsServer2D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), ERR_LOCKED, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer2D::area_create() {
 	GodotArea2D *area = memnew(GodotArea2D);
 	RID rid = area_owner.make_rid(area);
@@ -1245,6 +1261,8 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 		return;
 	}
 
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+
 	_update_shapes();
 
 	island_count = 0;
@@ -119,6 +119,9 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
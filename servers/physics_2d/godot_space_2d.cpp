@@ -64,20 +64,20 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	aabb.position = p_parameters.position - Vector2(0.00001, 0.00001);
 	aabb.size = Vector2(0.00002, 0.00002);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	int cc = 0;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(space->intersection_query.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
 
 		if (p_parameters.pick_point && !col_obj->is_pickable()) {
 			continue;
@@ -87,7 +87,7 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 
 		GodotShape2D *shape = col_obj->get_shape(shape_idx);
 
@@ -123,7 +123,7 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -134,17 +134,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(space->intersection_query.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -215,7 +215,7 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	int cc = 0;
 
@@ -224,16 +224,16 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(space->intersection_query.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 
 		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
@@ -260,22 +260,22 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(space->intersection_query.results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
@@ -347,7 +347,7 @@ bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_para
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	bool collided = false;
 	r_result_count = 0;
@@ -362,17 +362,17 @@ bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_para
 	GodotPhysicsServer2D::CollCbkData *cbkptr = &cbk;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
 
 		if (p_parameters.exclude.has(col_obj->get_self())) {
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 
 		cbk.valid_dir = Vector2();
 		cbk.valid_depth = 0;
@@ -446,7 +446,7 @@ bool GodotPhysicsDirectSpaceState2D::rest_info(const ShapeParameters &p_paramete
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query.results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query.subindex_results);
 
 	_RestCallbackData2D rcd;
 
@@ -456,17 +456,17 @@ bool GodotPhysicsDirectSpaceState2D::rest_info(const ShapeParameters &p_paramete
 	rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(space->intersection_query.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = space->intersection_query.results[i];
 
 		if (p_parameters.exclude.has(col_obj->get_self())) {
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = space->intersection_query.subindex_results[i];
 
 		rcd.valid_dir = Vector2();
 		rcd.object = col_obj;
@@ -501,26 +501,28 @@ bool GodotPhysicsDirectSpaceState2D::rest_info(const ShapeParameters &p_paramete
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+thread_local GodotSpace2D::IntersectionQuery GodotSpace2D::intersection_query;
+
 int GodotSpace2D::_cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	int amount = broadphase->cull_aabb(p_aabb, intersection_query.results, INTERSECTION_QUERY_MAX, intersection_query.subindex_results);
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
 
-		if (intersection_query_results[i] == p_body) {
+		if (intersection_query.results[i] == p_body) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject2D::TYPE_AREA) {
+		} else if (intersection_query.results[i]->get_type() == GodotCollisionObject2D::TYPE_AREA) {
 			keep = false;
-		} else if (!p_body->collides_with(static_cast<GodotBody2D *>(intersection_query_results[i]))) {
+		} else if (!p_body->collides_with(static_cast<GodotBody2D *>(intersection_query.results[i]))) {
 			keep = false;
-		} else if (static_cast<GodotBody2D *>(intersection_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query_results[i]->get_self())) {
+		} else if (static_cast<GodotBody2D *>(intersection_query.results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query.results[i]->get_self())) {
 			keep = false;
 		}
 
 		if (!keep) {
 			if (i < amount - 1) {
-				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
-				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+				SWAP(intersection_query.results[i], intersection_query.results[amount - 1]);
+				SWAP(intersection_query.subindex_results[i], intersection_query.subindex_results[amount - 1]);
 			}
 
 			amount--;
@@ -620,7 +622,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 				Transform2D body_shape_xform = body_transform * p_body->get_shape_transform(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject2D *col_obj = intersection_query_results[i];
+					const GodotCollisionObject2D *col_obj = intersection_query.results[i];
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -628,7 +630,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
+					int shape_idx = intersection_query.subindex_results[i];
 
 					Transform2D col_obj_shape_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 
@@ -755,7 +757,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject2D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject2D *col_obj = intersection_query.results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -763,7 +765,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 					continue;
 				}
 
-				int col_shape_idx = intersection_query_subindex_results[i];
+				int col_shape_idx = intersection_query.subindex_results[i];
 				GodotShape2D *against_shape = col_obj->get_shape(col_shape_idx);
 
 				bool excluded = false;
@@ -903,7 +905,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 			GodotShape2D *body_shape = p_body->get_shape(j);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject2D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject2D *col_obj = intersection_query.results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -911,7 +913,7 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = intersection_query.subindex_results[i];
 
 				GodotShape2D *against_shape = col_obj->get_shape(shape_idx);
 
@@ -1059,6 +1061,22 @@ void GodotSpace2D::body_remove_from_mass_properties_update_list(SelfList<GodotBo
 	mass_properties_update_list.remove(p_body);
 }
 
+void GodotSpace2D::body_pair_add(SelfList<GodotBodyPair2D> *p_pair) {
+	body_pair_list.add(p_pair);
+
+	if (!restored_pair_states.is_empty()) {
+		HashMap<BodyPairKey, GodotBodyPair2D::State, BodyPairKey>::Iterator E = restored_pair_states.find(BodyPairKey(p_pair->self()));
+		if (E) {
+			p_pair->self()->restore_state(E->value);
+			restored_pair_states.remove(E);
+		}
+	}
+}
+
+void GodotSpace2D::body_pair_remove(SelfList<GodotBodyPair2D> *p_pair) {
+	body_pair_list.remove(p_pair);
+}
+
 GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 	return broadphase;
 }
@@ -1066,6 +1084,7 @@ GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 void GodotSpace2D::add_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	p_object->set_space_order(++object_order);
 }
 
 void GodotSpace2D::remove_object(GodotCollisionObject2D *p_object) {
@@ -1130,6 +1149,9 @@ void GodotSpace2D::setup() {
 
 void GodotSpace2D::update() {
 	broadphase->update();
+
+	// The pairs that exist now are the ones a restored snapshot can still apply to.
+	restored_pair_states.clear();
 }
 
 void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
@@ -1204,6 +1226,184 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
 
+#define SPACE_STATE_MAGIC 0x53443247 // "G2DS"
+
+#define SPACE_STATE_BODY_SIZE (sizeof(uint64_t) + 19 * sizeof(real_t) + sizeof(uint32_t))
+#define SPACE_STATE_CONTACT_SIZE (10 * sizeof(real_t) + sizeof(uint32_t))
+#define SPACE_STATE_PAIR_SIZE (2 * sizeof(uint64_t) + 4 * sizeof(uint32_t) + 2 * sizeof(real_t) + GodotBodyPair2D::MAX_CONTACTS * SPACE_STATE_CONTACT_SIZE)
+
+struct _SpaceStateBodyOrder {
+	_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+		return p_a->get_space_order() < p_b->get_space_order();
+	}
+};
+
+struct _SpaceStatePairOrder {
+	_FORCE_INLINE_ bool operator()(const GodotBodyPair2D *p_a, const GodotBodyPair2D *p_b) const {
+		if (p_a->get_body_a() != p_b->get_body_a()) {
+			return p_a->get_body_a()->get_space_order() < p_b->get_body_a()->get_space_order();
+		}
+		if (p_a->get_body_b() != p_b->get_body_b()) {
+			return p_a->get_body_b()->get_space_order() < p_b->get_body_b()->get_space_order();
+		}
+		return p_a->get_order_subkey() < p_b->get_order_subkey();
+	}
+};
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	LocalVector<GodotBody2D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody2D *>(E));
+		}
+	}
+	bodies.sort_custom<_SpaceStateBodyOrder>();
+
+	LocalVector<GodotBodyPair2D *> pairs;
+	for (const SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		pairs.push_back(E->self());
+	}
+	pairs.sort_custom<_SpaceStatePairOrder>();
+
+	Vector<uint8_t> state;
+	state.resize(PhysicsSpaceState::HEADER_SIZE + bodies.size() * SPACE_STATE_BODY_SIZE + pairs.size() * SPACE_STATE_PAIR_SIZE);
+	uint8_t *w = state.ptrw();
+
+	PhysicsSpaceState::put_header(w, SPACE_STATE_MAGIC, bodies.size(), pairs.size());
+
+	GodotBody2D::State body_state;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		bodies[i]->save_state(body_state);
+
+		PhysicsSpaceState::put_u64(w, bodies[i]->get_self().get_id());
+		PhysicsSpaceState::put_transform(w, body_state.transform);
+		PhysicsSpaceState::put_transform(w, body_state.new_transform);
+		PhysicsSpaceState::put_vector2(w, body_state.linear_velocity);
+		PhysicsSpaceState::put_real(w, body_state.angular_velocity);
+		PhysicsSpaceState::put_vector2(w, body_state.applied_force);
+		PhysicsSpaceState::put_real(w, body_state.applied_torque);
+		PhysicsSpaceState::put_real(w, body_state.still_time);
+		PhysicsSpaceState::put_u32(w, body_state.active ? 1 : 0);
+	}
+
+	GodotBodyPair2D::State pair_state;
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		pairs[i]->save_state(pair_state);
+		BodyPairKey key(pairs[i]);
+
+		PhysicsSpaceState::put_u64(w, key.body_A);
+		PhysicsSpaceState::put_u64(w, key.body_B);
+		PhysicsSpaceState::put_u32(w, key.shape_A);
+		PhysicsSpaceState::put_u32(w, key.shape_B);
+		PhysicsSpaceState::put_u32(w, pair_state.contact_count);
+		PhysicsSpaceState::put_u32(w, (pair_state.collided ? 1 : 0) | (pair_state.oneway_disabled ? 2 : 0));
+		PhysicsSpaceState::put_vector2(w, pair_state.sep_axis);
+
+		for (int j = 0; j < GodotBodyPair2D::MAX_CONTACTS; j++) {
+			const GodotBodyPair2D::State::ContactState &c = pair_state.contacts[j];
+			PhysicsSpaceState::put_vector2(w, c.normal);
+			PhysicsSpaceState::put_vector2(w, c.local_A);
+			PhysicsSpaceState::put_vector2(w, c.local_B);
+			PhysicsSpaceState::put_real(w, c.acc_normal_impulse);
+			PhysicsSpaceState::put_real(w, c.acc_tangent_impulse);
+			PhysicsSpaceState::put_real(w, c.acc_bias_impulse);
+			PhysicsSpaceState::put_real(w, c.acc_bias_impulse_center_of_mass);
+			PhysicsSpaceState::put_u32(w, c.used ? 1 : 0);
+		}
+	}
+
+	DEV_ASSERT(w == state.ptrw() + state.size());
+
+	return state;
+}
+
+Error GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Space state can't be restored while the space is being stepped.");
+
+	const uint8_t *r = p_state.ptr();
+
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+	Error err = PhysicsSpaceState::get_header(r, p_state.size(), SPACE_STATE_MAGIC, body_count, pair_count);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V((uint64_t)p_state.size() != PhysicsSpaceState::HEADER_SIZE + body_count * (uint64_t)SPACE_STATE_BODY_SIZE + pair_count * (uint64_t)SPACE_STATE_PAIR_SIZE, ERR_INVALID_DATA);
+
+	HashMap<uint64_t, GodotBody2D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(E->get_self().get_id(), static_cast<GodotBody2D *>(E));
+		}
+	}
+
+	// Bodies created after the state was saved are left as they are, and the ones
+	// that were freed since are skipped.
+	GodotBody2D::State body_state;
+	for (uint32_t i = 0; i < body_count; i++) {
+		uint64_t id = PhysicsSpaceState::get_u64(r);
+		body_state.transform = PhysicsSpaceState::get_transform_2d(r);
+		body_state.new_transform = PhysicsSpaceState::get_transform_2d(r);
+		body_state.linear_velocity = PhysicsSpaceState::get_vector2(r);
+		body_state.angular_velocity = PhysicsSpaceState::get_real(r);
+		body_state.applied_force = PhysicsSpaceState::get_vector2(r);
+		body_state.applied_torque = PhysicsSpaceState::get_real(r);
+		body_state.still_time = PhysicsSpaceState::get_real(r);
+		body_state.active = PhysicsSpaceState::get_u32(r) & 1;
+
+		HashMap<uint64_t, GodotBody2D *>::Iterator E = bodies.find(id);
+		if (E) {
+			E->value->restore_state(body_state);
+		}
+	}
+
+	restored_pair_states.clear();
+	restored_pair_states.reserve(pair_count);
+
+	GodotBodyPair2D::State pair_state;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		BodyPairKey key;
+		key.body_A = PhysicsSpaceState::get_u64(r);
+		key.body_B = PhysicsSpaceState::get_u64(r);
+		key.shape_A = PhysicsSpaceState::get_u32(r);
+		key.shape_B = PhysicsSpaceState::get_u32(r);
+		pair_state.contact_count = PhysicsSpaceState::get_u32(r);
+		uint32_t flags = PhysicsSpaceState::get_u32(r);
+		pair_state.collided = flags & 1;
+		pair_state.oneway_disabled = flags & 2;
+		pair_state.sep_axis = PhysicsSpaceState::get_vector2(r);
+
+		for (int j = 0; j < GodotBodyPair2D::MAX_CONTACTS; j++) {
+			GodotBodyPair2D::State::ContactState &c = pair_state.contacts[j];
+			c.normal = PhysicsSpaceState::get_vector2(r);
+			c.local_A = PhysicsSpaceState::get_vector2(r);
+			c.local_B = PhysicsSpaceState::get_vector2(r);
+			c.acc_normal_impulse = PhysicsSpaceState::get_real(r);
+			c.acc_tangent_impulse = PhysicsSpaceState::get_real(r);
+			c.acc_bias_impulse = PhysicsSpaceState::get_real(r);
+			c.acc_bias_impulse_center_of_mass = PhysicsSpaceState::get_real(r);
+			c.used = PhysicsSpaceState::get_u32(r) & 1;
+		}
+
+		restored_pair_states.insert(key, pair_state);
+	}
+
+	// Existing pairs get their saved contacts, or start over if they didn't exist.
+	// Pairs the broadphase creates on the next update pick theirs from restored_pair_states.
+	for (SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		GodotBodyPair2D *pair = E->self();
+		HashMap<BodyPairKey, GodotBodyPair2D::State, BodyPairKey>::Iterator F = restored_pair_states.find(BodyPairKey(pair));
+		if (F) {
+			pair->restore_state(F->value);
+			restored_pair_states.remove(F);
+		} else {
+			pair->restore_state(GodotBodyPair2D::State());
+		}
+	}
+
+	return OK;
+}
+
 GodotSpace2D::GodotSpace2D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_DEF("physics/2d/sleep_threshold_linear", 2.0);
 	body_angular_velocity_sleep_threshold = GLOBAL_DEF("physics/2d/sleep_threshold_angular", Math::deg2rad(8.0));
@@ -1228,9 +1428,21 @@ GodotSpace2D::GodotSpace2D() {
 	constraint_bias = GLOBAL_DEF("physics/2d/solver/default_constraint_bias", 0.2);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/solver/default_constraint_bias", PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_constraint_bias", PROPERTY_HINT_RANGE, "0,1,0.01"));
 
+	deterministic = GLOBAL_DEF("physics/2d/determinism/enabled", false);
+
+	int fixed_point_fraction_bits = GLOBAL_DEF("physics/2d/determinism/fixed_point_fraction_bits", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/determinism/fixed_point_fraction_bits", PropertyInfo(Variant::INT, "physics/2d/determinism/fixed_point_fraction_bits", PROPERTY_HINT_RANGE, "0,24,1"));
+	if (deterministic && fixed_point_fraction_bits > 0) {
+		fixed_point_step = 1.0 / (real_t)(1 << MIN(fixed_point_fraction_bits, 24));
+	}
+
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
+	if (deterministic) {
+		// Otherwise pairs also depend on how objects moved in previous steps.
+		broadphase->set_pairing_expansion(0.0);
+	}
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState2D);
 	direct_access->space = this;
@@ -41,6 +41,7 @@
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
 #include "core/typedefs.h"
+#include "servers/physics_space_state.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
@@ -88,6 +89,17 @@ private:
 	SelfList<GodotBody2D>::List state_query_list;
 	SelfList<GodotArea2D>::List monitor_query_list;
 	SelfList<GodotArea2D>::List area_moved_list;
+	SelfList<GodotBodyPair2D>::List body_pair_list;
+
+	uint64_t object_order = 0;
+	bool deterministic = false;
+	real_t fixed_point_step = 0.0;
+
+	typedef PhysicsSpaceState::BodyPairKey BodyPairKey;
+
+	// Contact states from the last restored snapshot, for the pairs that the
+	// broadphase hasn't created again yet. Cleared on the next update.
+	HashMap<BodyPairKey, GodotBodyPair2D::State, BodyPairKey> restored_pair_states;
 
 	static void *_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -108,8 +120,18 @@ private:
 		INTERSECTION_QUERY_MAX = 2048
 	};
 
-	GodotCollisionObject2D *intersection_query_results[INTERSECTION_QUERY_MAX];
-	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
+	// Broadphase results of the query being run. They are kept per thread rather
+	// than per space, so direct space state queries can run on several threads at once.
+	// This stays safe when islands solved in parallel share static bodies: a query fills
+	// and consumes these within a single call on its own thread, and they only hold
+	// pointers to the objects found. Static bodies are read, never written, by queries and
+	// by the island solver alike, so a thread never sees the results of another one.
+	struct IntersectionQuery {
+		GodotCollisionObject2D *results[INTERSECTION_QUERY_MAX];
+		int subindex_results[INTERSECTION_QUERY_MAX];
+	};
+
+	static thread_local IntersectionQuery intersection_query;
 
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
@@ -152,6 +174,9 @@ public:
 	void area_add_to_monitor_query_list(SelfList<GodotArea2D> *p_area);
 	void area_remove_from_monitor_query_list(SelfList<GodotArea2D> *p_area);
 
+	void body_pair_add(SelfList<GodotBodyPair2D> *p_pair);
+	void body_pair_remove(SelfList<GodotBodyPair2D> *p_pair);
+
 	GodotBroadPhase2D *get_broadphase();
 
 	void add_object(GodotCollisionObject2D *p_object);
@@ -168,6 +193,12 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 
+	// In deterministic spaces, bodies and constraints are processed in an order that
+	// only depends on the order in which objects were added, and not on memory layout.
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+	// When non-zero, the body state is rounded to multiples of this after each step.
+	_FORCE_INLINE_ real_t get_fixed_point_step() const { return fixed_point_step; }
+
 	void update();
 	void setup();
 	void call_queries();
@@ -207,6 +238,11 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
+	// Full simulation state of the bodies in the space and their contacts.
+	// Bodies are identified by RID, so a state can only be restored in the space it was saved from.
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+
 	GodotSpace2D();
 	~GodotSpace2D();
 };
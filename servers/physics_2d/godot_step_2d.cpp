@@ -38,6 +38,21 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+bool GodotStep2D::single_threaded = false;
+
+template <class M>
+void GodotStep2D::_run_group_task(M p_method, uint32_t p_count, const String &p_description) {
+	if (single_threaded) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, -1, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -71,6 +86,64 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+struct _BodyOrder2D {
+	_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+		return p_a->get_space_order() < p_b->get_space_order();
+	}
+};
+
+struct _ConstraintOrder2D {
+	static _FORCE_INLINE_ uint64_t _get_body_order(const GodotConstraint2D *p_constraint, int p_index) {
+		if (p_index >= p_constraint->get_body_count() || !p_constraint->get_body_ptr()[p_index]) {
+			return 0;
+		}
+		return p_constraint->get_body_ptr()[p_index]->get_space_order();
+	}
+
+	_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+		for (int i = 0; i < 2; i++) {
+			uint64_t order_a = _get_body_order(p_a, i);
+			uint64_t order_b = _get_body_order(p_b, i);
+			if (order_a != order_b) {
+				return order_a < order_b;
+			}
+		}
+		return p_a->get_order_subkey() < p_b->get_order_subkey();
+	}
+};
+
+void GodotStep2D::_fill_active_bodies(const SelfList<GodotBody2D>::List *p_body_list) {
+	active_bodies.clear();
+
+	const SelfList<GodotBody2D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	if (deterministic) {
+		// The active list order depends on when bodies were woken up.
+		active_bodies.sort_custom<_BodyOrder2D>();
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_apply_integration() {
+	// Done in list order, so the broadphase and the space lists are updated
+	// the same way as if integration was serial.
+	uint32_t body_count = active_bodies.size();
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->apply_integration();
+	}
+}
+
 void GodotStep2D::_setup_contraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -100,26 +173,33 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_check_suspend(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_apply_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
@@ -133,6 +213,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
@@ -141,16 +222,13 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_active_bodies(body_list);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
-	}
+	_run_group_task(&GodotStep2D::_integrate_forces, active_bodies.size(), "Physics2DIntegrateForces");
+
+	_apply_integration();
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -191,12 +269,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	_fill_active_bodies(body_list);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	for (uint32_t body_index = 0; body_index < active_bodies.size(); ++body_index) {
+		GodotBody2D *body = active_bodies[body_index];
 
 		if (body->get_island_step() != _step) {
 			++body_island_count;
@@ -223,9 +301,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				// Islands are built following the constraint lists of the bodies,
+				// which are in pairing order.
+				constraint_island.sort_custom<_ConstraintOrder2D>();
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,8 +320,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_contraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_group_task(&GodotStep2D::_setup_contraint, total_contraint_count, "Physics2DConstraintSetup");
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -259,8 +339,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_group_task(&GodotStep2D::_solve_island, island_count, "Physics2DConstraintSolveIslands");
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -270,17 +349,23 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
-	}
+	// Bodies can have been woken up by the constraints, so the list is gathered again.
+	_fill_active_bodies(body_list);
+
+	_run_group_task(&GodotStep2D::_integrate_velocities, active_bodies.size(), "Physics2DIntegrateVelocities");
+
+	_apply_integration();
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	if (body_island_can_sleep.size() < body_island_count) {
+		body_island_can_sleep.resize(body_island_count);
+	}
+
+	_run_group_task(&GodotStep2D::_check_suspend, body_island_count, "Physics2DCheckSuspend");
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_apply_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
@@ -290,6 +375,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_bodies.clear();
 
 	p_space->unlock();
 	_step++;
@@ -37,22 +37,40 @@
 #include "core/templates/local_vector.h"
 
 class GodotStep2D {
+	static bool single_threaded;
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool deterministic = false;
 
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotBody2D *> active_bodies;
+	LocalVector<bool> body_island_can_sleep;
 
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
+	void _fill_active_bodies(const SelfList<GodotBody2D>::List *p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _apply_integration();
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _check_suspend(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _apply_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const;
+
+	template <class M>
+	void _run_group_task(M p_method, uint32_t p_count, const String &p_description);
 
 public:
+	// Runs every phase on the calling thread instead of the WorkerThreadPool.
+	// The results are the same, this is used to check it.
+	static void set_single_threaded(bool p_enable) { single_threaded = p_enable; }
+	static bool is_single_threaded() { return single_threaded; }
+
 	void step(GodotSpace2D *p_space, real_t p_delta);
 	GodotStep2D();
 	~GodotStep2D();
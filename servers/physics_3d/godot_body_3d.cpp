@@ -792,6 +792,31 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_state(State &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::restore_state(const State &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.transform.affine_inverse());
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+
+	_update_transform_dependent();
+	set_active(p_state.active);
+}
+
 void GodotBody3D::set_state_sync_callback(void *p_instance, PhysicsServer3D::BodyStateCallback p_callback) {
 	body_state_callback_instance = p_instance;
 	body_state_callback = p_callback;
@@ -342,6 +342,21 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state, as saved in space snapshots.
+	struct State {
+		Transform3D transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	GodotBody3D();
 	~GodotBody3D();
 };
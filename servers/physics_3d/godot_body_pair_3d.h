@@ -70,10 +70,13 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+public:
 	enum {
 		MAX_CONTACTS = 4
 	};
 
+private:
+
 	union {
 		struct {
 			GodotBody3D *A;
@@ -96,6 +99,8 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	SelfList<GodotBodyPair3D> body_pair_list;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B);
@@ -104,6 +109,33 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Contact state carried over between steps, as saved in space snapshots.
+	struct State {
+		struct ContactState {
+			Vector3 normal;
+			Vector3 local_A, local_B;
+			int index_A = 0, index_B = 0;
+			real_t acc_normal_impulse = 0.0;
+			Vector3 acc_tangent_impulse;
+			real_t acc_bias_impulse = 0.0;
+			real_t acc_bias_impulse_center_of_mass = 0.0;
+			bool used = false;
+		};
+
+		Vector3 sep_axis;
+		ContactState contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
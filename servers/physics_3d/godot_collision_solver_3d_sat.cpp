@@ -31,6 +31,7 @@
 #include "godot_collision_solver_3d_sat.h"
 
 #include "gjk_epa.h"
+#include "godot_collision_solver_3d_sat_batch.h"
 
 #include "core/math/geometry_3d.h"
 
@@ -639,6 +640,26 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
+		return test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Tests axes whose shape projections were computed in batch, stopping at the first separating one.
+	_FORCE_INLINE_ bool test_axes(const GodotSATBatch3D::Axes &p_axes, const GodotSATBatch3D::Ranges &p_ranges_A, const GodotSATBatch3D::Ranges &p_ranges_B) {
+		for (int i = 0; i < p_axes.count; i++) {
+			if (!test_axis_range(p_axes.get(i), p_ranges_A.min[i], p_ranges_A.max[i], p_ranges_B.min[i], p_ranges_B.max[i])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	_FORCE_INLINE_ bool test_axis_range(const Vector3 &p_axis, real_t p_min_A, real_t p_max_A, real_t p_min_B, real_t p_max_B) {
+		real_t min_A = p_min_A;
+		real_t max_A = p_max_A;
+		real_t min_B = p_min_B;
+		real_t max_B = p_max_B;
+
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -653,7 +674,7 @@ public:
 		max_B -= (min_A + max_A) * 0.5;
 
 		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
+			separator_axis = p_axis;
 			return false; // doesn't contain 0
 		}
 
@@ -666,12 +687,12 @@ public:
 		if (max_B < min_B) {
 			if (max_B < best_depth) {
 				best_depth = max_B;
-				best_axis = axis;
+				best_axis = p_axis;
 			}
 		} else {
 			if (min_B < best_depth) {
 				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+				best_axis = -p_axis; // keep it as A axis
 			}
 		}
 
@@ -1049,6 +1070,33 @@ static void _collision_sphere_face(const GodotShape3D *p_a, const Transform3D &p
 	separator.generate_contacts();
 }
 
+// Axes added to a batch go through the same sanitizing as in SeparatorAxisTest::test_axis().
+static _FORCE_INLINE_ void _add_separator_axis(GodotSATBatch3D::Axes &r_axes, const Vector3 &p_axis) {
+	if (p_axis.is_equal_approx(Vector3())) {
+		// strange case, try an upwards separator
+		r_axes.add(Vector3(0.0, 1.0, 0.0));
+	} else {
+		r_axes.add(p_axis);
+	}
+}
+
+// Tests and clears the pending axes of a batch, with both shapes given as transformed vertices.
+template <class S>
+static _FORCE_INLINE_ bool _test_separator_axes(S &r_separator, GodotSATBatch3D::Axes &r_axes, const LocalVector<Vector3> &p_vertices_A, const LocalVector<Vector3> &p_vertices_B) {
+	if (!r_axes.count) {
+		return true;
+	}
+
+	GodotSATBatch3D::Ranges ranges_A;
+	GodotSATBatch3D::Ranges ranges_B;
+	GodotSATBatch3D::project_points(r_axes, p_vertices_A.ptr(), p_vertices_A.size(), ranges_A);
+	GodotSATBatch3D::project_points(r_axes, p_vertices_B.ptr(), p_vertices_B.size(), ranges_B);
+
+	bool result = r_separator.test_axes(r_axes, ranges_A, ranges_B);
+	r_axes.clear();
+	return result;
+}
+
 template <bool withMargin>
 static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotBoxShape3D *box_A = static_cast<const GodotBoxShape3D *>(p_a);
@@ -1060,24 +1108,19 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	// The (at most 15) face and edge axes are projected all at once.
+	GodotSATBatch3D::Axes axes;
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		_add_separator_axis(axes, p_transform_a.basis.get_column(i).normalized());
 	}
 
 	// test faces of B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		_add_separator_axis(axes, p_transform_b.basis.get_column(i).normalized());
 	}
 
 	// test combined edges
@@ -1090,12 +1133,19 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			_add_separator_axis(axes, axis);
 		}
 	}
 
+	GodotSATBatch3D::Ranges ranges_A;
+	GodotSATBatch3D::Ranges ranges_B;
+	GodotSATBatch3D::project_box(axes, p_transform_a, box_A->get_half_extents(), ranges_A);
+	GodotSATBatch3D::project_box(axes, p_transform_b, box_B->get_half_extents(), ranges_B);
+
+	if (!separator.test_axes(axes, ranges_A, ranges_B)) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -2104,14 +2154,30 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	const Vector3 *vertices_B = mesh_B.vertices.ptr();
 	int vertex_count_B = mesh_B.vertices.size();
 
+	// Transform the vertices once, instead of on every projection.
+	// Pairs are set up on several threads, so each one has its own buffers.
+	static thread_local LocalVector<Vector3> world_vertices_A;
+	static thread_local LocalVector<Vector3> world_vertices_B;
+	world_vertices_A.resize(vertex_count_A);
+	for (int i = 0; i < vertex_count_A; i++) {
+		world_vertices_A[i] = p_transform_a.xform(vertices_A[i]);
+	}
+	world_vertices_B.resize(vertex_count_B);
+	for (int i = 0; i < vertex_count_B; i++) {
+		world_vertices_B[i] = p_transform_b.xform(vertices_B[i]);
+	}
+
+	// Axes are projected in batches, but still tested in the same order.
+	GodotSATBatch3D::Axes axes;
+
 	// Precalculating this makes the transforms faster.
-	Basis a_xform_normal = p_transform_b.basis.inverse().transposed();
+	Basis a_xform_normal = p_transform_a.basis.inverse().transposed();
 
 	// faces of A
 	for (int i = 0; i < face_count_A; i++) {
-		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
+		_add_separator_axis(axes, a_xform_normal.xform(faces_A[i].plane.normal).normalized());
 
-		if (!separator.test_axis(axis)) {
+		if (axes.is_full() && !_test_separator_axes(separator, axes, world_vertices_A, world_vertices_B)) {
 			return;
 		}
 	}
@@ -2121,9 +2187,9 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	// faces of B
 	for (int i = 0; i < face_count_B; i++) {
-		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
+		_add_separator_axis(axes, b_xform_normal.xform(faces_B[i].plane.normal).normalized());
 
-		if (!separator.test_axis(axis)) {
+		if (axes.is_full() && !_test_separator_axes(separator, axes, world_vertices_A, world_vertices_B)) {
 			return;
 		}
 	}
@@ -2135,14 +2201,18 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 		for (int j = 0; j < edge_count_B; j++) {
 			Vector3 e2 = p_transform_b.basis.xform(vertices_B[edges_B[j].a]) - p_transform_b.basis.xform(vertices_B[edges_B[j].b]);
 
-			Vector3 axis = e1.cross(e2).normalized();
+			_add_separator_axis(axes, e1.cross(e2).normalized());
 
-			if (!separator.test_axis(axis)) {
+			if (axes.is_full() && !_test_separator_axes(separator, axes, world_vertices_A, world_vertices_B)) {
 				return;
 			}
 		}
 	}
 
+	if (!_test_separator_axes(separator, axes, world_vertices_A, world_vertices_B)) {
+		return;
+	}
+
 	if (withMargin) {
 		//vertex-vertex
 		for (int i = 0; i < vertex_count_A; i++) {
@@ -0,0 +1,336 @@
+/*************************************************************************/
+/*  godot_collision_solver_3d_sat_batch.cpp                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "godot_collision_solver_3d_sat_batch.h"
+
+#include "core/variant/variant.h"
+
+// The SIMD kernels work on 32-bit floats.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__x86_64__) || defined(_M_X64)
+// SSE2 is part of the x86-64 baseline, AVX has to be detected at runtime.
+#define SAT_BATCH_SSE2_ENABLED
+#define SAT_BATCH_AVX_ENABLED
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define SAT_BATCH_TARGET_AVX __attribute__((target("avx")))
+#else
+#include <intrin.h>
+#define SAT_BATCH_TARGET_AVX
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+// NEON is part of the ARMv8-A baseline.
+#define SAT_BATCH_NEON_ENABLED
+#include <arm_neon.h>
+#endif
+#endif
+
+GodotSATBatch3D::Implementation GodotSATBatch3D::implementation = GodotSATBatch3D::IMPLEMENTATION_SCALAR;
+
+/********** SCALAR *************/
+
+static void _project_box_scalar(const GodotSATBatch3D::Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, GodotSATBatch3D::Ranges &r_ranges) {
+	for (int i = 0; i < p_axes.count; i++) {
+		Vector3 axis = p_axes.get(i);
+
+		Vector3 local_axis = p_transform.basis.xform_inv(axis);
+		real_t length = local_axis.abs().dot(p_half_extents);
+		real_t distance = axis.dot(p_transform.origin);
+
+		r_ranges.min[i] = distance - length;
+		r_ranges.max[i] = distance + length;
+	}
+}
+
+static void _project_points_scalar(const GodotSATBatch3D::Axes &p_axes, const Vector3 *p_points, int p_point_count, GodotSATBatch3D::Ranges &r_ranges) {
+	for (int i = 0; i < p_axes.count; i++) {
+		Vector3 axis = p_axes.get(i);
+
+		real_t min = 0.0;
+		real_t max = 0.0;
+		for (int j = 0; j < p_point_count; j++) {
+			real_t d = axis.dot(p_points[j]);
+			if (j == 0 || d > max) {
+				max = d;
+			}
+			if (j == 0 || d < min) {
+				min = d;
+			}
+		}
+
+		r_ranges.min[i] = min;
+		r_ranges.max[i] = max;
+	}
+}
+
+/********** SSE2 *************/
+
+#ifdef SAT_BATCH_SSE2_ENABLED
+
+static void _project_box_sse2(const GodotSATBatch3D::Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, GodotSATBatch3D::Ranges &r_ranges) {
+	const Basis &b = p_transform.basis;
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+	for (int i = 0; i < p_axes.count; i += 4) {
+		__m128 ax = _mm_load_ps(p_axes.x + i);
+		__m128 ay = _mm_load_ps(p_axes.y + i);
+		__m128 az = _mm_load_ps(p_axes.z + i);
+
+		// Same operation order as Basis::xform_inv(), so results match the scalar code.
+		__m128 lx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][0]), ax), _mm_mul_ps(_mm_set1_ps(b.rows[1][0]), ay)), _mm_mul_ps(_mm_set1_ps(b.rows[2][0]), az));
+		__m128 ly = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][1]), ax), _mm_mul_ps(_mm_set1_ps(b.rows[1][1]), ay)), _mm_mul_ps(_mm_set1_ps(b.rows[2][1]), az));
+		__m128 lz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][2]), ax), _mm_mul_ps(_mm_set1_ps(b.rows[1][2]), ay)), _mm_mul_ps(_mm_set1_ps(b.rows[2][2]), az));
+
+		__m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, lx), _mm_set1_ps(p_half_extents.x)), _mm_mul_ps(_mm_andnot_ps(sign_mask, ly), _mm_set1_ps(p_half_extents.y))), _mm_mul_ps(_mm_andnot_ps(sign_mask, lz), _mm_set1_ps(p_half_extents.z)));
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, _mm_set1_ps(p_transform.origin.x)), _mm_mul_ps(ay, _mm_set1_ps(p_transform.origin.y))), _mm_mul_ps(az, _mm_set1_ps(p_transform.origin.z)));
+
+		_mm_store_ps(r_ranges.min + i, _mm_sub_ps(distance, length));
+		_mm_store_ps(r_ranges.max + i, _mm_add_ps(distance, length));
+	}
+}
+
+static void _project_points_sse2(const GodotSATBatch3D::Axes &p_axes, const Vector3 *p_points, int p_point_count, GodotSATBatch3D::Ranges &r_ranges) {
+	for (int i = 0; i < p_axes.count; i += 4) {
+		__m128 ax = _mm_load_ps(p_axes.x + i);
+		__m128 ay = _mm_load_ps(p_axes.y + i);
+		__m128 az = _mm_load_ps(p_axes.z + i);
+
+		__m128 min = _mm_setzero_ps();
+		__m128 max = _mm_setzero_ps();
+		for (int j = 0; j < p_point_count; j++) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, _mm_set1_ps(p_points[j].x)), _mm_mul_ps(ay, _mm_set1_ps(p_points[j].y))), _mm_mul_ps(az, _mm_set1_ps(p_points[j].z)));
+			if (j == 0) {
+				min = d;
+				max = d;
+			} else {
+				min = _mm_min_ps(min, d);
+				max = _mm_max_ps(max, d);
+			}
+		}
+
+		_mm_store_ps(r_ranges.min + i, min);
+		_mm_store_ps(r_ranges.max + i, max);
+	}
+}
+
+#endif // SAT_BATCH_SSE2_ENABLED
+
+/********** AVX *************/
+
+#ifdef SAT_BATCH_AVX_ENABLED
+
+SAT_BATCH_TARGET_AVX static void _project_box_avx(const GodotSATBatch3D::Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, GodotSATBatch3D::Ranges &r_ranges) {
+	const Basis &b = p_transform.basis;
+	const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+
+	for (int i = 0; i < p_axes.count; i += 8) {
+		__m256 ax = _mm256_load_ps(p_axes.x + i);
+		__m256 ay = _mm256_load_ps(p_axes.y + i);
+		__m256 az = _mm256_load_ps(p_axes.z + i);
+
+		__m256 lx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(b.rows[0][0]), ax), _mm256_mul_ps(_mm256_set1_ps(b.rows[1][0]), ay)), _mm256_mul_ps(_mm256_set1_ps(b.rows[2][0]), az));
+		__m256 ly = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(b.rows[0][1]), ax), _mm256_mul_ps(_mm256_set1_ps(b.rows[1][1]), ay)), _mm256_mul_ps(_mm256_set1_ps(b.rows[2][1]), az));
+		__m256 lz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(b.rows[0][2]), ax), _mm256_mul_ps(_mm256_set1_ps(b.rows[1][2]), ay)), _mm256_mul_ps(_mm256_set1_ps(b.rows[2][2]), az));
+
+		__m256 length = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(sign_mask, lx), _mm256_set1_ps(p_half_extents.x)), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, ly), _mm256_set1_ps(p_half_extents.y))), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, lz), _mm256_set1_ps(p_half_extents.z)));
+		__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, _mm256_set1_ps(p_transform.origin.x)), _mm256_mul_ps(ay, _mm256_set1_ps(p_transform.origin.y))), _mm256_mul_ps(az, _mm256_set1_ps(p_transform.origin.z)));
+
+		_mm256_store_ps(r_ranges.min + i, _mm256_sub_ps(distance, length));
+		_mm256_store_ps(r_ranges.max + i, _mm256_add_ps(distance, length));
+	}
+}
+
+SAT_BATCH_TARGET_AVX static void _project_points_avx(const GodotSATBatch3D::Axes &p_axes, const Vector3 *p_points, int p_point_count, GodotSATBatch3D::Ranges &r_ranges) {
+	for (int i = 0; i < p_axes.count; i += 8) {
+		__m256 ax = _mm256_load_ps(p_axes.x + i);
+		__m256 ay = _mm256_load_ps(p_axes.y + i);
+		__m256 az = _mm256_load_ps(p_axes.z + i);
+
+		__m256 min = _mm256_setzero_ps();
+		__m256 max = _mm256_setzero_ps();
+		for (int j = 0; j < p_point_count; j++) {
+			__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, _mm256_set1_ps(p_points[j].x)), _mm256_mul_ps(ay, _mm256_set1_ps(p_points[j].y))), _mm256_mul_ps(az, _mm256_set1_ps(p_points[j].z)));
+			if (j == 0) {
+				min = d;
+				max = d;
+			} else {
+				min = _mm256_min_ps(min, d);
+				max = _mm256_max_ps(max, d);
+			}
+		}
+
+		_mm256_store_ps(r_ranges.min + i, min);
+		_mm256_store_ps(r_ranges.max + i, max);
+	}
+}
+
+static bool _cpu_has_avx() {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx");
+#else
+	int info[4];
+	__cpuid(info, 1);
+	// The CPU must support AVX, and the OS must save the YMM registers on context switches.
+	bool avx = (info[2] & (1 << 28)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	return avx && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#endif
+}
+
+#endif // SAT_BATCH_AVX_ENABLED
+
+/********** NEON *************/
+
+#ifdef SAT_BATCH_NEON_ENABLED
+
+static void _project_box_neon(const GodotSATBatch3D::Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, GodotSATBatch3D::Ranges &r_ranges) {
+	const Basis &b = p_transform.basis;
+
+	for (int i = 0; i < p_axes.count; i += 4) {
+		float32x4_t ax = vld1q_f32(p_axes.x + i);
+		float32x4_t ay = vld1q_f32(p_axes.y + i);
+		float32x4_t az = vld1q_f32(p_axes.z + i);
+
+		// Multiplies and adds are kept separate (no fused multiply-add), so results match the scalar code.
+		float32x4_t lx = vaddq_f32(vaddq_f32(vmulq_n_f32(ax, b.rows[0][0]), vmulq_n_f32(ay, b.rows[1][0])), vmulq_n_f32(az, b.rows[2][0]));
+		float32x4_t ly = vaddq_f32(vaddq_f32(vmulq_n_f32(ax, b.rows[0][1]), vmulq_n_f32(ay, b.rows[1][1])), vmulq_n_f32(az, b.rows[2][1]));
+		float32x4_t lz = vaddq_f32(vaddq_f32(vmulq_n_f32(ax, b.rows[0][2]), vmulq_n_f32(ay, b.rows[1][2])), vmulq_n_f32(az, b.rows[2][2]));
+
+		float32x4_t length = vaddq_f32(vaddq_f32(vmulq_n_f32(vabsq_f32(lx), p_half_extents.x), vmulq_n_f32(vabsq_f32(ly), p_half_extents.y)), vmulq_n_f32(vabsq_f32(lz), p_half_extents.z));
+		float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_n_f32(ax, p_transform.origin.x), vmulq_n_f32(ay, p_transform.origin.y)), vmulq_n_f32(az, p_transform.origin.z));
+
+		vst1q_f32(r_ranges.min + i, vsubq_f32(distance, length));
+		vst1q_f32(r_ranges.max + i, vaddq_f32(distance, length));
+	}
+}
+
+static void _project_points_neon(const GodotSATBatch3D::Axes &p_axes, const Vector3 *p_points, int p_point_count, GodotSATBatch3D::Ranges &r_ranges) {
+	for (int i = 0; i < p_axes.count; i += 4) {
+		float32x4_t ax = vld1q_f32(p_axes.x + i);
+		float32x4_t ay = vld1q_f32(p_axes.y + i);
+		float32x4_t az = vld1q_f32(p_axes.z + i);
+
+		float32x4_t min = vdupq_n_f32(0.0f);
+		float32x4_t max = vdupq_n_f32(0.0f);
+		for (int j = 0; j < p_point_count; j++) {
+			float32x4_t d = vaddq_f32(vaddq_f32(vmulq_n_f32(ax, p_points[j].x), vmulq_n_f32(ay, p_points[j].y)), vmulq_n_f32(az, p_points[j].z));
+			if (j == 0) {
+				min = d;
+				max = d;
+			} else {
+				min = vminq_f32(min, d);
+				max = vmaxq_f32(max, d);
+			}
+		}
+
+		vst1q_f32(r_ranges.min + i, min);
+		vst1q_f32(r_ranges.max + i, max);
+	}
+}
+
+#endif // SAT_BATCH_NEON_ENABLED
+
+GodotSATBatch3D::ProjectBoxFunc GodotSATBatch3D::project_box_func = _project_box_scalar;
+GodotSATBatch3D::ProjectPointsFunc GodotSATBatch3D::project_points_func = _project_points_scalar;
+
+bool GodotSATBatch3D::is_implementation_supported(Implementation p_implementation) {
+	switch (p_implementation) {
+		case IMPLEMENTATION_SCALAR:
+			return true;
+#ifdef SAT_BATCH_SSE2_ENABLED
+		case IMPLEMENTATION_SSE2:
+			return true;
+#endif
+#ifdef SAT_BATCH_AVX_ENABLED
+		case IMPLEMENTATION_AVX:
+			return _cpu_has_avx();
+#endif
+#ifdef SAT_BATCH_NEON_ENABLED
+		case IMPLEMENTATION_NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+void GodotSATBatch3D::set_implementation(Implementation p_implementation) {
+	ERR_FAIL_INDEX(p_implementation, IMPLEMENTATION_MAX);
+	ERR_FAIL_COND_MSG(!is_implementation_supported(p_implementation), vformat("SAT batch implementation '%s' is not supported on this CPU.", get_implementation_name(p_implementation)));
+
+	switch (p_implementation) {
+#ifdef SAT_BATCH_SSE2_ENABLED
+		case IMPLEMENTATION_SSE2: {
+			project_box_func = _project_box_sse2;
+			project_points_func = _project_points_sse2;
+		} break;
+#endif
+#ifdef SAT_BATCH_AVX_ENABLED
+		case IMPLEMENTATION_AVX: {
+			project_box_func = _project_box_avx;
+			project_points_func = _project_points_avx;
+		} break;
+#endif
+#ifdef SAT_BATCH_NEON_ENABLED
+		case IMPLEMENTATION_NEON: {
+			project_box_func = _project_box_neon;
+			project_points_func = _project_points_neon;
+		} break;
+#endif
+		default: {
+			project_box_func = _project_box_scalar;
+			project_points_func = _project_points_scalar;
+		} break;
+	}
+
+	implementation = p_implementation;
+}
+
+const char *GodotSATBatch3D::get_implementation_name(Implementation p_implementation) {
+	static const char *names[IMPLEMENTATION_MAX] = {
+		"Scalar",
+		"SSE2",
+		"AVX",
+		"NEON",
+	};
+	ERR_FAIL_INDEX_V(p_implementation, IMPLEMENTATION_MAX, "");
+	return names[p_implementation];
+}
+
+void GodotSATBatch3D::initialize() {
+	for (int i = IMPLEMENTATION_MAX - 1; i > IMPLEMENTATION_SCALAR; i--) {
+		if (is_implementation_supported(Implementation(i))) {
+			set_implementation(Implementation(i));
+			return;
+		}
+	}
+	set_implementation(IMPLEMENTATION_SCALAR);
+}
@@ -0,0 +1,107 @@
+/*************************************************************************/
+/*  godot_collision_solver_3d_sat_batch.h                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GODOT_COLLISION_SOLVER_3D_SAT_BATCH_H
+#define GODOT_COLLISION_SOLVER_3D_SAT_BATCH_H
+
+#include "core/math/transform_3d.h"
+
+// Projects shapes on several separating axes at once, for the separating axis tests.
+// The kernels process multiple axes per instruction with the widest SIMD instruction
+// set available on the running CPU (detected at runtime), and fall back to scalar code
+// otherwise, or when building with double precision.
+class GodotSATBatch3D {
+public:
+	enum Implementation {
+		IMPLEMENTATION_SCALAR,
+		IMPLEMENTATION_SSE2,
+		IMPLEMENTATION_AVX,
+		IMPLEMENTATION_NEON,
+		IMPLEMENTATION_MAX,
+	};
+
+	// Must be a multiple of the widest SIMD register (8 lanes).
+	static const int MAX_AXES = 16;
+
+	// Axes in structure of arrays layout. The kernels always work on full registers,
+	// so lanes past count may hold stale axes from before clear(). Their results are
+	// computed but never read.
+	struct Axes {
+		alignas(32) real_t x[MAX_AXES] = {};
+		alignas(32) real_t y[MAX_AXES] = {};
+		alignas(32) real_t z[MAX_AXES] = {};
+		int count = 0;
+
+		_FORCE_INLINE_ void add(const Vector3 &p_axis) {
+			x[count] = p_axis.x;
+			y[count] = p_axis.y;
+			z[count] = p_axis.z;
+			count++;
+		}
+		_FORCE_INLINE_ Vector3 get(int p_index) const { return Vector3(x[p_index], y[p_index], z[p_index]); }
+		_FORCE_INLINE_ bool is_full() const { return count == MAX_AXES; }
+		_FORCE_INLINE_ void clear() { count = 0; }
+	};
+
+	struct Ranges {
+		alignas(32) real_t min[MAX_AXES];
+		alignas(32) real_t max[MAX_AXES];
+	};
+
+	typedef void (*ProjectBoxFunc)(const Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, Ranges &r_ranges);
+	typedef void (*ProjectPointsFunc)(const Axes &p_axes, const Vector3 *p_points, int p_point_count, Ranges &r_ranges);
+
+private:
+	static Implementation implementation;
+	static ProjectBoxFunc project_box_func;
+	static ProjectPointsFunc project_points_func;
+
+public:
+	// Same result as GodotBoxShape3D::project_range() for each axis, up to floating point rounding.
+	_FORCE_INLINE_ static void project_box(const Axes &p_axes, const Transform3D &p_transform, const Vector3 &p_half_extents, Ranges &r_ranges) {
+		project_box_func(p_axes, p_transform, p_half_extents, r_ranges);
+	}
+
+	// Same result as GodotConvexPolygonShape3D::project_range() for each axis, up to floating
+	// point rounding, with the points already transformed.
+	_FORCE_INLINE_ static void project_points(const Axes &p_axes, const Vector3 *p_points, int p_point_count, Ranges &r_ranges) {
+		project_points_func(p_axes, p_points, p_point_count, r_ranges);
+	}
+
+	static bool is_implementation_supported(Implementation p_implementation);
+	static void set_implementation(Implementation p_implementation);
+	static Implementation get_implementation() { return implementation; }
+	static const char *get_implementation_name(Implementation p_implementation);
+
+	// Selects the fastest implementation supported by the CPU.
+	static void initialize();
+};
+
+#endif // GODOT_COLLISION_SOLVER_3D_SAT_BATCH_H
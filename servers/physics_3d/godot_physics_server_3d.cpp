@@ -32,6 +32,7 @@
 
 #include "godot_body_direct_state_3d.h"
 #include "godot_broad_phase_3d_bvh.h"
+#include "godot_collision_solver_3d_sat_batch.h"
 #include "joints/godot_cone_twist_joint_3d.h"
 #include "joints/godot_generic_6dof_joint_3d.h"
 #include "joints/godot_hinge_joint_3d.h"
@@ -196,6 +197,22 @@ PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), PackedByteArray(), "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+Error GodotPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync) || space->is_locked(), ERR_LOCKED, "Space state is inaccessible right now, wait for iteration or physics process notification.");
+
+	return space->restore_state(p_state);
+}
+
 void GodotPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND(!space);
@@ -1606,6 +1623,8 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+
 	_update_shapes();
 
 	island_count = 0;
@@ -1745,6 +1764,7 @@ GodotPhysicsServer3D *GodotPhysicsServer3D::godot_singleton = nullptr;
 GodotPhysicsServer3D::GodotPhysicsServer3D(bool p_using_threads) {
 	godot_singleton = this;
 	GodotBroadPhase3D::create_func = GodotBroadPhase3DBVH::_create;
+	GodotSATBatch3D::initialize();
 
 	using_threads = p_using_threads;
 };
@@ -113,6 +113,9 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
 
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state) override;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
@@ -1082,6 +1082,22 @@ void GodotSpace3D::body_remove_from_mass_properties_update_list(SelfList<GodotBo
 	mass_properties_update_list.remove(p_body);
 }
 
+void GodotSpace3D::body_pair_add(SelfList<GodotBodyPair3D> *p_pair) {
+	body_pair_list.add(p_pair);
+
+	if (!restored_pair_states.is_empty()) {
+		HashMap<BodyPairKey, GodotBodyPair3D::State, BodyPairKey>::Iterator E = restored_pair_states.find(BodyPairKey(p_pair->self()));
+		if (E) {
+			p_pair->self()->restore_state(E->value);
+			restored_pair_states.remove(E);
+		}
+	}
+}
+
+void GodotSpace3D::body_pair_remove(SelfList<GodotBodyPair3D> *p_pair) {
+	body_pair_list.remove(p_pair);
+}
+
 GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 	return broadphase;
 }
@@ -1164,6 +1180,9 @@ void GodotSpace3D::setup() {
 
 void GodotSpace3D::update() {
 	broadphase->update();
+
+	// The pairs that exist now are the ones a restored snapshot can still apply to.
+	restored_pair_states.clear();
 }
 
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
@@ -1233,6 +1252,189 @@ GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
 
+#define SPACE_STATE_MAGIC 0x53443347 // "G3DS"
+
+#define SPACE_STATE_BODY_SIZE (sizeof(uint64_t) + 37 * sizeof(real_t) + sizeof(uint32_t))
+#define SPACE_STATE_CONTACT_SIZE (15 * sizeof(real_t) + 3 * sizeof(uint32_t))
+#define SPACE_STATE_PAIR_SIZE (2 * sizeof(uint64_t) + 4 * sizeof(uint32_t) + 3 * sizeof(real_t) + GodotBodyPair3D::MAX_CONTACTS * SPACE_STATE_CONTACT_SIZE)
+
+struct _SpaceStateBodyOrder {
+	_FORCE_INLINE_ bool operator()(const GodotBody3D *p_a, const GodotBody3D *p_b) const {
+		return p_a->get_self().get_id() < p_b->get_self().get_id();
+	}
+};
+
+struct _SpaceStatePairOrder {
+	_FORCE_INLINE_ bool operator()(const GodotBodyPair3D *p_a, const GodotBodyPair3D *p_b) const {
+		if (p_a->get_body_a() != p_b->get_body_a()) {
+			return p_a->get_body_a()->get_self().get_id() < p_b->get_body_a()->get_self().get_id();
+		}
+		if (p_a->get_body_b() != p_b->get_body_b()) {
+			return p_a->get_body_b()->get_self().get_id() < p_b->get_body_b()->get_self().get_id();
+		}
+		if (p_a->get_shape_a() != p_b->get_shape_a()) {
+			return p_a->get_shape_a() < p_b->get_shape_a();
+		}
+		return p_a->get_shape_b() < p_b->get_shape_b();
+	}
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	LocalVector<GodotBody3D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody3D *>(E));
+		}
+	}
+	bodies.sort_custom<_SpaceStateBodyOrder>();
+
+	LocalVector<GodotBodyPair3D *> pairs;
+	for (const SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		pairs.push_back(E->self());
+	}
+	pairs.sort_custom<_SpaceStatePairOrder>();
+
+	Vector<uint8_t> state;
+	state.resize(PhysicsSpaceState::HEADER_SIZE + bodies.size() * SPACE_STATE_BODY_SIZE + pairs.size() * SPACE_STATE_PAIR_SIZE);
+	uint8_t *w = state.ptrw();
+
+	PhysicsSpaceState::put_header(w, SPACE_STATE_MAGIC, bodies.size(), pairs.size());
+
+	GodotBody3D::State body_state;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		bodies[i]->save_state(body_state);
+
+		PhysicsSpaceState::put_u64(w, bodies[i]->get_self().get_id());
+		PhysicsSpaceState::put_transform(w, body_state.transform);
+		PhysicsSpaceState::put_transform(w, body_state.new_transform);
+		PhysicsSpaceState::put_vector3(w, body_state.linear_velocity);
+		PhysicsSpaceState::put_vector3(w, body_state.angular_velocity);
+		PhysicsSpaceState::put_vector3(w, body_state.applied_force);
+		PhysicsSpaceState::put_vector3(w, body_state.applied_torque);
+		PhysicsSpaceState::put_real(w, body_state.still_time);
+		PhysicsSpaceState::put_u32(w, body_state.active ? 1 : 0);
+	}
+
+	GodotBodyPair3D::State pair_state;
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		pairs[i]->save_state(pair_state);
+		BodyPairKey key(pairs[i]);
+
+		PhysicsSpaceState::put_u64(w, key.body_A);
+		PhysicsSpaceState::put_u64(w, key.body_B);
+		PhysicsSpaceState::put_u32(w, key.shape_A);
+		PhysicsSpaceState::put_u32(w, key.shape_B);
+		PhysicsSpaceState::put_u32(w, pair_state.contact_count);
+		PhysicsSpaceState::put_u32(w, pair_state.collided ? 1 : 0);
+		PhysicsSpaceState::put_vector3(w, pair_state.sep_axis);
+
+		for (int j = 0; j < GodotBodyPair3D::MAX_CONTACTS; j++) {
+			const GodotBodyPair3D::State::ContactState &c = pair_state.contacts[j];
+			PhysicsSpaceState::put_vector3(w, c.normal);
+			PhysicsSpaceState::put_vector3(w, c.local_A);
+			PhysicsSpaceState::put_vector3(w, c.local_B);
+			PhysicsSpaceState::put_u32(w, c.index_A);
+			PhysicsSpaceState::put_u32(w, c.index_B);
+			PhysicsSpaceState::put_real(w, c.acc_normal_impulse);
+			PhysicsSpaceState::put_vector3(w, c.acc_tangent_impulse);
+			PhysicsSpaceState::put_real(w, c.acc_bias_impulse);
+			PhysicsSpaceState::put_real(w, c.acc_bias_impulse_center_of_mass);
+			PhysicsSpaceState::put_u32(w, c.used ? 1 : 0);
+		}
+	}
+
+	DEV_ASSERT(w == state.ptrw() + state.size());
+
+	return state;
+}
+
+Error GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Space state can't be restored while the space is being stepped.");
+
+	const uint8_t *r = p_state.ptr();
+
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+	Error err = PhysicsSpaceState::get_header(r, p_state.size(), SPACE_STATE_MAGIC, body_count, pair_count);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V((uint64_t)p_state.size() != PhysicsSpaceState::HEADER_SIZE + body_count * (uint64_t)SPACE_STATE_BODY_SIZE + pair_count * (uint64_t)SPACE_STATE_PAIR_SIZE, ERR_INVALID_DATA);
+
+	HashMap<uint64_t, GodotBody3D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.insert(E->get_self().get_id(), static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	// Bodies created after the state was saved are left as they are, and the ones
+	// that were freed since are skipped.
+	GodotBody3D::State body_state;
+	for (uint32_t i = 0; i < body_count; i++) {
+		uint64_t id = PhysicsSpaceState::get_u64(r);
+		body_state.transform = PhysicsSpaceState::get_transform_3d(r);
+		body_state.new_transform = PhysicsSpaceState::get_transform_3d(r);
+		body_state.linear_velocity = PhysicsSpaceState::get_vector3(r);
+		body_state.angular_velocity = PhysicsSpaceState::get_vector3(r);
+		body_state.applied_force = PhysicsSpaceState::get_vector3(r);
+		body_state.applied_torque = PhysicsSpaceState::get_vector3(r);
+		body_state.still_time = PhysicsSpaceState::get_real(r);
+		body_state.active = PhysicsSpaceState::get_u32(r) & 1;
+
+		HashMap<uint64_t, GodotBody3D *>::Iterator E = bodies.find(id);
+		if (E) {
+			E->value->restore_state(body_state);
+		}
+	}
+
+	restored_pair_states.clear();
+	restored_pair_states.reserve(pair_count);
+
+	GodotBodyPair3D::State pair_state;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		BodyPairKey key;
+		key.body_A = PhysicsSpaceState::get_u64(r);
+		key.body_B = PhysicsSpaceState::get_u64(r);
+		key.shape_A = PhysicsSpaceState::get_u32(r);
+		key.shape_B = PhysicsSpaceState::get_u32(r);
+		pair_state.contact_count = PhysicsSpaceState::get_u32(r);
+		pair_state.collided = PhysicsSpaceState::get_u32(r) & 1;
+		pair_state.sep_axis = PhysicsSpaceState::get_vector3(r);
+
+		for (int j = 0; j < GodotBodyPair3D::MAX_CONTACTS; j++) {
+			GodotBodyPair3D::State::ContactState &c = pair_state.contacts[j];
+			c.normal = PhysicsSpaceState::get_vector3(r);
+			c.local_A = PhysicsSpaceState::get_vector3(r);
+			c.local_B = PhysicsSpaceState::get_vector3(r);
+			c.index_A = PhysicsSpaceState::get_u32(r);
+			c.index_B = PhysicsSpaceState::get_u32(r);
+			c.acc_normal_impulse = PhysicsSpaceState::get_real(r);
+			c.acc_tangent_impulse = PhysicsSpaceState::get_vector3(r);
+			c.acc_bias_impulse = PhysicsSpaceState::get_real(r);
+			c.acc_bias_impulse_center_of_mass = PhysicsSpaceState::get_real(r);
+			c.used = PhysicsSpaceState::get_u32(r) & 1;
+		}
+
+		restored_pair_states.insert(key, pair_state);
+	}
+
+	// Existing pairs get their saved contacts, or start over if they didn't exist.
+	// Pairs the broadphase creates on the next update pick theirs from restored_pair_states.
+	for (SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		GodotBodyPair3D *pair = E->self();
+		HashMap<BodyPairKey, GodotBodyPair3D::State, BodyPairKey>::Iterator F = restored_pair_states.find(BodyPairKey(pair));
+		if (F) {
+			pair->restore_state(F->value);
+			restored_pair_states.remove(F);
+		} else {
+			pair->restore_state(GodotBodyPair3D::State());
+		}
+	}
+
+	return OK;
+}
+
 GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_DEF("physics/3d/sleep_threshold_linear", 0.1);
 	body_angular_velocity_sleep_threshold = GLOBAL_DEF("physics/3d/sleep_threshold_angular", Math::deg2rad(8.0));
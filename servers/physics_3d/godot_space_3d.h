@@ -42,6 +42,7 @@
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
 #include "core/typedefs.h"
+#include "servers/physics_space_state.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
@@ -85,6 +86,13 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotBodyPair3D>::List body_pair_list;
+
+	typedef PhysicsSpaceState::BodyPairKey BodyPairKey;
+
+	// Contact states from the last restored snapshot, for the pairs that the
+	// broadphase hasn't created again yet. Cleared on the next update.
+	HashMap<BodyPairKey, GodotBodyPair3D::State, BodyPairKey> restored_pair_states;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -154,6 +162,9 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	void body_pair_add(SelfList<GodotBodyPair3D> *p_pair);
+	void body_pair_remove(SelfList<GodotBodyPair3D> *p_pair);
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
@@ -211,6 +222,11 @@ public:
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
+	// Full simulation state of the rigid bodies in the space and their contacts.
+	// Bodies are identified by RID, so a state can only be restored in the space it was saved from.
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+
 	GodotSpace3D();
 	~GodotSpace3D();
 };
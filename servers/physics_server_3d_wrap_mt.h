@@ -118,6 +118,9 @@ public:
 		return physics_server_3d->space_get_direct_state(p_space);
 	}
 
+	FUNC1RC(PackedByteArray, space_save_state, RID);
+	FUNC2R(Error, space_restore_state, RID, const PackedByteArray &);
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<Vector3>());
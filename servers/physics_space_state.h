@@ -0,0 +1,186 @@
+/*************************************************************************/
+/*  physics_space_state.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PHYSICS_SPACE_STATE_H
+#define PHYSICS_SPACE_STATE_H
+
+#include "core/io/marshalls.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+#include "core/templates/hashfuncs.h"
+
+// Encoding of the snapshots taken by space_save_state() in the 2D and 3D Godot physics servers.
+// Snapshots are written field by field in little endian order, so the same state
+// always gives the same bytes and they can be compared to detect desyncs.
+
+class PhysicsSpaceState {
+public:
+	enum {
+		VERSION = 1,
+		HEADER_SIZE = 4 * sizeof(uint32_t),
+	};
+
+	// Identifies a body pair across a save and restore, as the pairs themselves are recreated by the broadphase.
+	struct BodyPairKey {
+		uint64_t body_A = 0;
+		uint64_t body_B = 0;
+		int shape_A = 0;
+		int shape_B = 0;
+
+		static uint32_t hash(const BodyPairKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.body_A);
+			h = hash_murmur3_one_64(p_key.body_B, h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const BodyPairKey &p_key) const {
+			return body_A == p_key.body_A && body_B == p_key.body_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+		}
+
+		BodyPairKey() {}
+
+		template <typename T>
+		BodyPairKey(const T *p_pair) {
+			body_A = p_pair->get_body_a()->get_self().get_id();
+			body_B = p_pair->get_body_b()->get_self().get_id();
+			shape_A = p_pair->get_shape_a();
+			shape_B = p_pair->get_shape_b();
+		}
+	};
+
+	static _FORCE_INLINE_ void put_u32(uint8_t *&w, uint32_t p_value) {
+		w += encode_uint32(p_value, w);
+	}
+
+	static _FORCE_INLINE_ void put_u64(uint8_t *&w, uint64_t p_value) {
+		w += encode_uint64(p_value, w);
+	}
+
+	static _FORCE_INLINE_ void put_real(uint8_t *&w, real_t p_value) {
+		w += encode_real(p_value, w);
+	}
+
+	static _FORCE_INLINE_ void put_vector2(uint8_t *&w, const Vector2 &p_value) {
+		put_real(w, p_value.x);
+		put_real(w, p_value.y);
+	}
+
+	static _FORCE_INLINE_ void put_vector3(uint8_t *&w, const Vector3 &p_value) {
+		put_real(w, p_value.x);
+		put_real(w, p_value.y);
+		put_real(w, p_value.z);
+	}
+
+	static _FORCE_INLINE_ void put_transform(uint8_t *&w, const Transform2D &p_value) {
+		for (int i = 0; i < 3; i++) {
+			put_vector2(w, p_value.columns[i]);
+		}
+	}
+
+	static _FORCE_INLINE_ void put_transform(uint8_t *&w, const Transform3D &p_value) {
+		for (int i = 0; i < 3; i++) {
+			put_vector3(w, p_value.basis.rows[i]);
+		}
+		put_vector3(w, p_value.origin);
+	}
+
+	static _FORCE_INLINE_ void put_header(uint8_t *&w, uint32_t p_magic, uint32_t p_body_count, uint32_t p_pair_count) {
+		put_u32(w, p_magic);
+		put_u32(w, (VERSION << 8) | sizeof(real_t));
+		put_u32(w, p_body_count);
+		put_u32(w, p_pair_count);
+	}
+
+	static _FORCE_INLINE_ uint32_t get_u32(const uint8_t *&r) {
+		uint32_t value = decode_uint32(r);
+		r += sizeof(uint32_t);
+		return value;
+	}
+
+	static _FORCE_INLINE_ uint64_t get_u64(const uint8_t *&r) {
+		uint64_t value = decode_uint64(r);
+		r += sizeof(uint64_t);
+		return value;
+	}
+
+	static _FORCE_INLINE_ real_t get_real(const uint8_t *&r) {
+#ifdef REAL_T_IS_DOUBLE
+		real_t value = decode_double(r);
+#else
+		real_t value = decode_float(r);
+#endif
+		r += sizeof(real_t);
+		return value;
+	}
+
+	static _FORCE_INLINE_ Vector2 get_vector2(const uint8_t *&r) {
+		real_t x = get_real(r);
+		real_t y = get_real(r);
+		return Vector2(x, y);
+	}
+
+	static _FORCE_INLINE_ Vector3 get_vector3(const uint8_t *&r) {
+		real_t x = get_real(r);
+		real_t y = get_real(r);
+		real_t z = get_real(r);
+		return Vector3(x, y, z);
+	}
+
+	static _FORCE_INLINE_ Transform2D get_transform_2d(const uint8_t *&r) {
+		Transform2D value;
+		for (int i = 0; i < 3; i++) {
+			value.columns[i] = get_vector2(r);
+		}
+		return value;
+	}
+
+	static _FORCE_INLINE_ Transform3D get_transform_3d(const uint8_t *&r) {
+		Transform3D value;
+		for (int i = 0; i < 3; i++) {
+			value.basis.rows[i] = get_vector3(r);
+		}
+		value.origin = get_vector3(r);
+		return value;
+	}
+
+	// Checks the header of a snapshot of p_size bytes and reads its body and pair counts.
+	static Error get_header(const uint8_t *&r, int p_size, uint32_t p_magic, uint32_t &r_body_count, uint32_t &r_pair_count) {
+		ERR_FAIL_COND_V(p_size < (int)HEADER_SIZE, ERR_INVALID_DATA);
+		ERR_FAIL_COND_V_MSG(get_u32(r) != p_magic, ERR_FILE_UNRECOGNIZED, "Invalid physics space state.");
+		ERR_FAIL_COND_V_MSG(get_u32(r) != ((VERSION << 8) | sizeof(real_t)), ERR_FILE_UNRECOGNIZED, "Physics space state was saved by an incompatible version or build.");
+		r_body_count = get_u32(r);
+		r_pair_count = get_u32(r);
+		return OK;
+	}
+};
+
+#endif // PHYSICS_SPACE_STATE_H
@@ -84,6 +84,7 @@ public:
 
 	virtual void material_set_param(RID p_material, const StringName &p_param, const Variant &p_value) override {}
 	virtual Variant material_get_param(RID p_material, const StringName &p_param) const override { return Variant(); }
+	virtual void material_get_textures(RID p_material, LocalVector<RID> &r_textures) const override {}
 
 	virtual void material_set_next_pass(RID p_material, RID p_next_material) override {}
 
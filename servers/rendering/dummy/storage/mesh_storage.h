@@ -85,6 +85,9 @@ public:
 	virtual void mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
 	virtual void mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
 
+	virtual void mesh_surface_remove_finest_lods(RID p_mesh, int p_surface, int p_count) override {}
+	virtual void mesh_surface_add_finer_lods(RID p_mesh, int p_surface, const Vector<uint8_t> &p_index_data, const Vector<RS::SurfaceData::LOD> &p_lods, float p_edge_length) override {}
+
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) override {}
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const override { return RID(); }
 
@@ -497,6 +497,81 @@ void MeshStorage::mesh_surface_update_skin_region(RID p_mesh, int p_surface, int
 	RD::get_singleton()->buffer_update(mesh->surfaces[p_surface]->skin_buffer, p_offset, data_size, r);
 }
 
+void MeshStorage::mesh_surface_remove_finest_lods(RID p_mesh, int p_surface, int p_count) {
+	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_surface, mesh->surface_count);
+	Mesh::Surface *s = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(p_count < 0 || (uint32_t)p_count > s->lod_count);
+	if (p_count == 0) {
+		return;
+	}
+
+	// Freeing the buffers frees their index arrays too.
+	RD::get_singleton()->free(s->index_buffer);
+	for (int i = 0; i < p_count - 1; i++) {
+		RD::get_singleton()->free(s->lods[i].index_buffer);
+	}
+	s->index_buffer = s->lods[p_count - 1].index_buffer;
+	s->index_array = s->lods[p_count - 1].index_array;
+	s->index_count = s->lods[p_count - 1].index_count;
+
+	Mesh::Surface::LOD *lods = nullptr;
+	uint32_t lod_count = s->lod_count - p_count;
+	if (lod_count) {
+		lods = memnew_arr(Mesh::Surface::LOD, lod_count);
+		for (uint32_t i = 0; i < lod_count; i++) {
+			lods[i] = s->lods[p_count + i];
+		}
+	}
+	memdelete_arr(s->lods);
+	s->lods = lods;
+	s->lod_count = lod_count;
+}
+
+void MeshStorage::mesh_surface_add_finer_lods(RID p_mesh, int p_surface, const Vector<uint8_t> &p_index_data, const Vector<RS::SurfaceData::LOD> &p_lods, float p_edge_length) {
+	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_UNSIGNED_INDEX((uint32_t)p_surface, mesh->surface_count);
+	Mesh::Surface *s = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(s->index_buffer.is_null());
+	ERR_FAIL_COND(p_index_data.is_empty());
+
+	bool is_index_16 = s->vertex_count <= 65536;
+	RD::IndexBufferFormat index_format = is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32;
+
+	uint32_t lod_count = p_lods.size() + 1 + s->lod_count;
+	Mesh::Surface::LOD *lods = memnew_arr(Mesh::Surface::LOD, lod_count);
+	for (int i = 0; i < p_lods.size(); i++) {
+		uint32_t indices = p_lods[i].index_data.size() / (is_index_16 ? 2 : 4);
+		lods[i].index_buffer = RD::get_singleton()->index_buffer_create(indices, index_format, p_lods[i].index_data);
+		lods[i].index_array = RD::get_singleton()->index_array_create(lods[i].index_buffer, 0, indices);
+		lods[i].edge_length = p_lods[i].edge_length;
+		lods[i].index_count = indices;
+	}
+
+	// The current index buffer is kept as the next LOD.
+	Mesh::Surface::LOD &previous = lods[p_lods.size()];
+	previous.index_buffer = s->index_buffer;
+	previous.index_array = s->index_array;
+	previous.index_count = s->index_count;
+	previous.edge_length = p_edge_length;
+
+	for (uint32_t i = 0; i < s->lod_count; i++) {
+		lods[p_lods.size() + 1 + i] = s->lods[i];
+	}
+	if (s->lods) {
+		memdelete_arr(s->lods);
+	}
+	s->lods = lods;
+	s->lod_count = lod_count;
+
+	uint32_t indices = p_index_data.size() / (is_index_16 ? 2 : 4);
+	s->index_buffer = RD::get_singleton()->index_buffer_create(indices, index_format, p_index_data, false);
+	s->index_count = indices;
+	s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, indices);
+}
+
 void MeshStorage::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -329,6 +329,10 @@ public:
 	virtual void render_probes() = 0;
 	virtual void update_visibility_notifiers() = 0;
 
+	virtual void streaming_feedback_set_enabled(RID p_resource, bool p_enabled) = 0;
+	virtual float streaming_feedback_get_screen_size(RID p_resource) const = 0;
+	virtual void update_streaming_feedback() = 0;
+
 	virtual void decals_set_filter(RS::DecalFilter p_filter) = 0;
 	virtual void light_projectors_set_filter(RS::LightProjectorFilter p_filter) = 0;
 
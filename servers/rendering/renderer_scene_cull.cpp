@@ -2520,7 +2520,10 @@ void RendererSceneCull::render_camera(RID p_render_buffers, RID p_camera, RID p_
 	// For now just cull on the first camera
 	RendererSceneOcclusionCull::get_singleton()->buffer_update(p_viewport, camera_data.main_transform, camera_data.main_projection, camera_data.is_orthogonal);
 
+	// Only cameras report streaming feedback, reflection probes would ask for detail nobody sees.
+	streaming_viewport_height = p_viewport_size.height;
 	_render_scene(&camera_data, p_render_buffers, environment, camera->effects, camera->visible_layers, p_scenario, p_viewport, p_shadow_atlas, RID(), -1, p_screen_mesh_lod_threshold, true, r_render_info);
+	streaming_viewport_height = 0.0f;
 #endif
 }
 
@@ -2720,6 +2723,21 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (base_type == RS::INSTANCE_MESH) {
 						mesh_visible = true;
+
+						if (cull_data.streaming_pixel_scale > 0.0f) {
+							Instance *instance = idata.instance;
+							const AABB &aabb = instance->transformed_aabb;
+							float screen_size = aabb.get_longest_axis_size() * cull_data.streaming_pixel_scale;
+							if (!cull_data.streaming_orthogonal) {
+								screen_size /= MAX(cull_data.cam_transform.origin.distance_to(aabb.get_center()), z_near);
+							}
+							instance->streaming_screen_size = MAX(instance->streaming_screen_size, screen_size);
+							if (!instance->streaming_item.in_list()) {
+								streaming_instance_list_lock.lock();
+								streaming_instance_list.add(&instance->streaming_item);
+								streaming_instance_list_lock.unlock();
+							}
+						}
 					} else if (base_type == RS::INSTANCE_PARTICLES) {
 						//particles visible? process them
 						if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
@@ -3015,6 +3033,14 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		if (streaming_viewport_height > 0.0f) {
+			MutexLock lock(streaming_feedback_mutex);
+			if (!streaming_feedback.is_empty()) {
+				// Pixels covered per unit of size, before the perspective divide.
+				cull_data.streaming_pixel_scale = 0.5f * streaming_viewport_height * p_camera_data->main_projection.matrix[1][1];
+				cull_data.streaming_orthogonal = p_camera_data->is_orthogonal;
+			}
+		}
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3993,6 +4019,86 @@ void RendererSceneCull::update_visibility_notifiers() {
 	}
 }
 
+void RendererSceneCull::streaming_feedback_set_enabled(RID p_resource, bool p_enabled) {
+	MutexLock lock(streaming_feedback_mutex);
+	if (!p_enabled) {
+		streaming_feedback.erase(p_resource);
+	} else if (!streaming_feedback.has(p_resource)) {
+		streaming_feedback.insert(p_resource, 0.0f);
+	}
+}
+
+float RendererSceneCull::streaming_feedback_get_screen_size(RID p_resource) const {
+	MutexLock lock(streaming_feedback_mutex);
+	const float *screen_size = streaming_feedback.getptr(p_resource);
+	return screen_size ? *screen_size : 0.0f;
+}
+
+void RendererSceneCull::_streaming_feedback_add(RID p_resource, float p_screen_size) {
+	float *screen_size = streaming_feedback.getptr(p_resource);
+	if (screen_size) {
+		*screen_size = MAX(*screen_size, p_screen_size);
+	}
+}
+
+void RendererSceneCull::update_streaming_feedback() {
+	MutexLock lock(streaming_feedback_mutex);
+
+	for (KeyValue<RID, float> &E : streaming_feedback) {
+		E.value = 0.0f;
+	}
+
+	// Most materials are shared, only look up their textures once.
+	HashMap<RID, LocalVector<RID>> material_textures;
+	LocalVector<RID> materials;
+
+	SelfList<Instance> *E = streaming_instance_list.first();
+	while (E) {
+		SelfList<Instance> *N = E->next();
+		Instance *instance = E->self();
+		float screen_size = instance->streaming_screen_size;
+
+		instance->streaming_screen_size = 0.0f;
+		streaming_instance_list.remove(E);
+
+		if (instance->base_type == RS::INSTANCE_MESH && !streaming_feedback.is_empty()) {
+			_streaming_feedback_add(instance->base, screen_size);
+
+			materials.clear();
+			if (instance->material_override.is_valid()) {
+				materials.push_back(instance->material_override);
+			} else {
+				int surface_count = RSG::mesh_storage->mesh_get_surface_count(instance->base);
+				for (int i = 0; i < surface_count; i++) {
+					RID material = i < instance->materials.size() ? instance->materials[i] : RID();
+					if (!material.is_valid()) {
+						material = RSG::mesh_storage->mesh_surface_get_material(instance->base, i);
+					}
+					if (material.is_valid()) {
+						materials.push_back(material);
+					}
+				}
+			}
+			if (instance->material_overlay.is_valid()) {
+				materials.push_back(instance->material_overlay);
+			}
+
+			for (uint32_t i = 0; i < materials.size(); i++) {
+				LocalVector<RID> *textures = material_textures.getptr(materials[i]);
+				if (!textures) {
+					textures = &material_textures.insert(materials[i], LocalVector<RID>())->value;
+					RSG::material_storage->material_get_textures(materials[i], *textures);
+				}
+				for (uint32_t j = 0; j < textures->size(); j++) {
+					_streaming_feedback_add((*textures)[j], screen_size);
+				}
+			}
+		}
+
+		E = N;
+	}
+}
+
 /*******************************/
 /* Passthrough to Scene Render */
 /*******************************/
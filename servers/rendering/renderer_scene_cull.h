@@ -455,6 +455,9 @@ public:
 
 		SelfList<Instance> update_item;
 
+		float streaming_screen_size = 0.0f; // Largest size on screen this frame, in pixels.
+		SelfList<Instance> streaming_item;
+
 		AABB *custom_aabb = nullptr; // <Zylann> would using aabb directly with a bool be better?
 		float extra_margin;
 		ObjectID object_id;
@@ -520,7 +523,8 @@ public:
 
 		Instance() :
 				scenario_item(this),
-				update_item(this) {
+				update_item(this),
+				streaming_item(this) {
 			base_type = RS::INSTANCE_NONE;
 			cast_shadows = RS::SHADOW_CASTING_SETTING_ON;
 			receive_shadows = true;
@@ -645,6 +649,14 @@ public:
 	SpinLock visible_notifier_list_lock;
 	SelfList<InstanceVisibilityNotifierData>::List visible_notifier_list;
 
+	// Size on screen of the meshes and textures that stream their detail in,
+	// gathered from the visible mesh instances of the last frame.
+	mutable Mutex streaming_feedback_mutex;
+	HashMap<RID, float> streaming_feedback;
+	SpinLock streaming_instance_list_lock;
+	SelfList<Instance>::List streaming_instance_list;
+	float streaming_viewport_height = 0.0f;
+
 	struct InstanceLightData : public InstanceBaseData {
 		RID instance;
 		uint64_t last_version;
@@ -1047,8 +1059,12 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		float streaming_pixel_scale = 0.0f;
+		bool streaming_orthogonal = false;
 	};
 
+	void _streaming_feedback_add(RID p_resource, float p_screen_size);
+
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
@@ -1290,6 +1306,10 @@ public:
 
 	virtual void update_visibility_notifiers();
 
+	virtual void streaming_feedback_set_enabled(RID p_resource, bool p_enabled);
+	virtual float streaming_feedback_get_screen_size(RID p_resource) const;
+	virtual void update_streaming_feedback();
+
 	RendererSceneCull();
 	virtual ~RendererSceneCull();
 };
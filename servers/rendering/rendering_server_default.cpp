@@ -69,6 +69,8 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_RENDERING);
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
@@ -101,6 +103,7 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 
 	RSG::canvas->update_visibility_notifiers();
 	RSG::scene->update_visibility_notifiers();
+	RSG::scene->update_streaming_feedback();
 
 	while (frame_drawn_callbacks.front()) {
 		Callable c = frame_drawn_callbacks.front()->get();
@@ -348,6 +351,9 @@ void RenderingServerDefault::_thread_callback(void *_instance) {
 void RenderingServerDefault::_thread_loop() {
 	server_thread = Thread::get_caller_id();
 
+	// Everything the rendering thread allocates belongs to rendering.
+	Memory::set_current_tag(Memory::TAG_RENDERING);
+
 	DisplayServer::get_singleton()->make_rendering_thread();
 
 	_init();
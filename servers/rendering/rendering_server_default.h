@@ -296,6 +296,9 @@ public:
 	FUNC4(mesh_surface_update_attribute_region, RID, int, int, const Vector<uint8_t> &)
 	FUNC4(mesh_surface_update_skin_region, RID, int, int, const Vector<uint8_t> &)
 
+	FUNC3(mesh_surface_remove_finest_lods, RID, int, int)
+	FUNC5(mesh_surface_add_finer_lods, RID, int, const Vector<uint8_t> &, const Vector<SurfaceData::LOD> &, float)
+
 	FUNC3(mesh_surface_set_material, RID, int, RID)
 	FUNC2RC(RID, mesh_surface_get_material, RID, int)
 
@@ -780,6 +783,14 @@ public:
 
 	FUNC3R(TypedArray<Image>, bake_render_uv2, RID, const Vector<RID> &, const Size2i &)
 
+	//these go pass-through, the feedback is guarded by its own lock
+	virtual void streaming_feedback_set_enabled(RID p_resource, bool p_enabled) override {
+		RSG::scene->streaming_feedback_set_enabled(p_resource, p_enabled);
+	}
+	virtual float streaming_feedback_get_screen_size(RID p_resource) const override {
+		return RSG::scene->streaming_feedback_get_screen_size(p_resource);
+	}
+
 	FUNC1(gi_set_use_half_resolution, bool)
 
 #undef server_name
@@ -31,6 +31,7 @@
 #ifndef MATERIAL_STORAGE_H
 #define MATERIAL_STORAGE_H
 
+#include "core/templates/local_vector.h"
 #include "servers/rendering_server.h"
 #include "utilities.h"
 
@@ -82,6 +83,7 @@ public:
 
 	virtual void material_set_param(RID p_material, const StringName &p_param, const Variant &p_value) = 0;
 	virtual Variant material_get_param(RID p_material, const StringName &p_param) const = 0;
+	virtual void material_get_textures(RID p_material, LocalVector<RID> &r_textures) const = 0;
 
 	virtual void material_set_next_pass(RID p_material, RID p_next_material) = 0;
 
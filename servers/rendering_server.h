@@ -343,6 +343,12 @@ public:
 	virtual void mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) = 0;
 	virtual void mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) = 0;
 
+	// Only change the index buffers of a surface, e.g. to stream its finer LODs in and out.
+	// Removing makes the p_count-th LOD the index buffer. Adding makes p_index_data the index buffer, followed by
+	// p_lods and the current index buffer as a LOD with p_edge_length.
+	virtual void mesh_surface_remove_finest_lods(RID p_mesh, int p_surface, int p_count) = 0;
+	virtual void mesh_surface_add_finer_lods(RID p_mesh, int p_surface, const Vector<uint8_t> &p_index_data, const Vector<SurfaceData::LOD> &p_lods, float p_edge_length) = 0;
+
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) = 0;
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const = 0;
 
@@ -1258,6 +1264,13 @@ public:
 
 	virtual TypedArray<Image> bake_render_uv2(RID p_base, const Vector<RID> &p_material_overrides, const Size2i &p_image_size) = 0;
 
+	/* Streaming feedback */
+
+	// Reports how large on screen the instances using a mesh or texture were during the last frame,
+	// so its detail can be streamed in or out accordingly.
+	virtual void streaming_feedback_set_enabled(RID p_resource, bool p_enabled) = 0;
+	virtual float streaming_feedback_get_screen_size(RID p_resource) const = 0;
+
 	/* CANVAS (2D) */
 
 	virtual RID canvas_create() = 0;
@@ -101,6 +101,26 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Buffer views") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	f->seek(6);
+	const uint8_t *view = f->get_buffer_view(8);
+	if (!view) {
+		MESSAGE("Buffer views are not available on this platform.");
+		CHECK(f->get_position() == 6);
+		return;
+	}
+
+	CHECK(memcmp(view, "darkness", 8) == 0);
+	CHECK(f->get_position() == 14);
+	CHECK(f->get_8() == '\n');
+
+	// Views past the end are refused, the file is still read normally.
+	CHECK(f->get_buffer_view(f->get_length()) == nullptr);
+	CHECK(f->get_position() == 15);
+	CHECK(f->get_8() == 'M');
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
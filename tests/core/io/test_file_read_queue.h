@@ -0,0 +1,152 @@
+/*************************************************************************/
+/*  test_file_read_queue.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_FILE_READ_QUEUE_H
+#define TEST_FILE_READ_QUEUE_H
+
+#include "core/io/file_access.h"
+#include "core/io/file_read_queue.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestFileReadQueue {
+
+struct CompletionLog {
+	Mutex mutex;
+	Vector<FileReadQueue::RequestID> ids;
+	Vector<Error> errors;
+
+	static void completed(void *p_userdata, FileReadQueue::RequestID p_id, Error p_error) {
+		CompletionLog *log = (CompletionLog *)p_userdata;
+		MutexLock lock(log->mutex);
+		log->ids.push_back(p_id);
+		log->errors.push_back(p_error);
+	}
+};
+
+TEST_CASE("[FileReadQueue] Requests are served by priority, then in order") {
+	const String path = TestUtils::get_data_path("translations.csv");
+	CompletionLog log;
+
+	FileReadQueue queue;
+	queue.init(1);
+	queue.set_paused(true);
+
+	FileReadQueue::RequestID low = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_LOW, &CompletionLog::completed, &log);
+	FileReadQueue::RequestID normal_first = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_NORMAL, &CompletionLog::completed, &log);
+	FileReadQueue::RequestID high = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_HIGH, &CompletionLog::completed, &log);
+	FileReadQueue::RequestID normal_second = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_NORMAL, &CompletionLog::completed, &log);
+	FileReadQueue::RequestID raised = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_LOW, &CompletionLog::completed, &log);
+	queue.set_priority(raised, FileReadQueue::PRIORITY_HIGH);
+
+	Vector<FileReadQueue::RequestID> expected;
+	expected.push_back(high);
+	expected.push_back(raised);
+	expected.push_back(normal_first);
+	expected.push_back(normal_second);
+	expected.push_back(low);
+
+	bool all_pending = true;
+	for (int i = 0; i < expected.size(); i++) {
+		all_pending = all_pending && queue.get_status(expected[i]) == FileReadQueue::STATUS_PENDING;
+	}
+	CHECK_MESSAGE(all_pending, "Requests should stay pending while the queue is paused.");
+	CHECK(log.ids.is_empty());
+
+	queue.set_paused(false);
+	// Waiting raises a pending request to the front, so wait in the expected order to leave it unchanged.
+	for (int i = 0; i < expected.size(); i++) {
+		CHECK(queue.wait(expected[i]) == OK);
+	}
+
+	CHECK_MESSAGE(log.ids == expected, "Requests should be read by priority, then in the order they were made.");
+	queue.finish();
+}
+
+TEST_CASE("[FileReadQueue] Canceling a request before it's read") {
+	const String path = TestUtils::get_data_path("translations.csv");
+	CompletionLog log;
+
+	FileReadQueue queue;
+	queue.init(1);
+	queue.set_paused(true);
+
+	FileReadQueue::RequestID canceled = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_HIGH, &CompletionLog::completed, &log);
+	FileReadQueue::RequestID kept = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_LOW, &CompletionLog::completed, &log);
+	queue.cancel(canceled);
+	CHECK(queue.get_status(canceled) == FileReadQueue::STATUS_INVALID);
+	CHECK(queue.get_status(kept) == FileReadQueue::STATUS_PENDING);
+
+	queue.set_paused(false);
+	CHECK(queue.wait(kept) == OK);
+
+	REQUIRE(log.ids.size() == 1);
+	CHECK_MESSAGE(log.ids[0] == kept, "A canceled request should never be read nor reported as completed.");
+	queue.finish();
+}
+
+TEST_CASE("[FileReadQueue] Completion callbacks and results") {
+	const String path = TestUtils::get_data_path("translations.csv");
+	const Vector<uint8_t> contents = FileAccess::get_file_as_array(path);
+	REQUIRE(contents.size() > 16);
+	CompletionLog log;
+
+	FileReadQueue queue;
+	queue.init(2);
+
+	Vector<uint8_t> data;
+	FileReadQueue::RequestID whole = queue.request_read(path, 0, -1, FileReadQueue::PRIORITY_NORMAL, &CompletionLog::completed, &log);
+	CHECK(queue.wait(whole, &data) == OK);
+	CHECK_MESSAGE(data == contents, "Reading the whole file should return its contents.");
+
+	FileReadQueue::RequestID part = queue.request_read(path, 4, 8, FileReadQueue::PRIORITY_NORMAL, &CompletionLog::completed, &log);
+	CHECK(queue.wait(part, &data) == OK);
+	CHECK_MESSAGE(data == contents.slice(4, 12), "Reading part of the file should return only that part.");
+
+	FileReadQueue::RequestID missing = queue.request_read(path + ".missing", 0, -1, FileReadQueue::PRIORITY_NORMAL, &CompletionLog::completed, &log);
+	Error missing_error = queue.wait(missing);
+	CHECK(missing_error != OK);
+
+	// Callbacks run before the request is released, so they're all in by now.
+	REQUIRE(log.ids.size() == 3);
+	CHECK(log.ids[0] == whole);
+	CHECK(log.errors[0] == OK);
+	CHECK(log.ids[1] == part);
+	CHECK(log.errors[1] == OK);
+	CHECK(log.ids[2] == missing);
+	CHECK_MESSAGE(log.errors[2] == missing_error, "The callback should get the same error as wait().");
+
+	queue.finish();
+	CHECK_MESSAGE(queue.request_read(path) == FileReadQueue::INVALID_REQUEST_ID, "Requests should be refused once the threads are gone.");
+}
+
+} // namespace TestFileReadQueue
+
+#endif // TEST_FILE_READ_QUEUE_H
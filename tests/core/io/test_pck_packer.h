@@ -32,6 +32,7 @@
 #define TEST_PCK_PACKER_H
 
 #include "core/io/file_access_pack.h"
+#include "core/config/project_settings.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 
@@ -117,6 +118,67 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Read files from a loaded PCK") {
+	const String source_path = OS::get_singleton()->get_cache_path().plus_file("mapped_pack_source.bin");
+	Vector<uint8_t> contents;
+	contents.resize(1000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = (i * 7) % 256;
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents.ptr(), contents.size());
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().plus_file("output_mapped.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped_pack_test/data.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	REQUIRE_MESSAGE(
+			PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK,
+			"The generated PCK file should be loaded successfully.");
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://mapped_pack_test/data.bin");
+	REQUIRE_MESSAGE(f.is_valid(), "The packed file should be found after loading the PCK.");
+	CHECK(f->get_length() == (uint64_t)contents.size());
+
+	// Where the platform can map files, the pack is read from memory instead of through FileAccess.
+	const uint8_t *pack_data = nullptr;
+	uint64_t pack_size = 0;
+	if (OS::get_singleton()->map_file(ProjectSettings::get_singleton()->globalize_path(output_pck_path), pack_data, pack_size) == OK) {
+		OS::get_singleton()->unmap_file(pack_data, pack_size);
+		const uint8_t *view = f->get_buffer_view(16);
+		REQUIRE_MESSAGE(view != nullptr, "The packed file should be read from the memory mapped pack.");
+		CHECK(memcmp(view, contents.ptr(), 16) == 0);
+		CHECK(f->get_position() == 16);
+	}
+
+	uint8_t buffer[100];
+	f->seek(500);
+	CHECK(f->get_position() == 500);
+	CHECK(f->get_buffer(buffer, 100) == 100);
+	CHECK(memcmp(buffer, contents.ptr() + 500, 100) == 0);
+	CHECK(f->get_8() == contents[600]);
+	CHECK_FALSE(f->eof_reached());
+
+	// Reading past the end returns only what is left.
+	f->seek(950);
+	CHECK(f->get_buffer(buffer, 100) == 50);
+	CHECK(memcmp(buffer, contents.ptr() + 950, 50) == 0);
+	CHECK(f->eof_reached());
+
+	// Seeking back clears the end of file flag.
+	f->seek(0);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_8() == contents[0]);
+
+	f->seek(contents.size() + 1);
+	CHECK(f->eof_reached());
+	CHECK(f->get_buffer(buffer, 1) == 0);
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
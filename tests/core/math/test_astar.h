@@ -32,6 +32,8 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_compact.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
 
@@ -213,6 +215,128 @@ TEST_CASE("[AStar3D] Add/Remove") {
 	// It's been great work, cheers. \(^ ^)/
 }
 
+TEST_CASE("[AStarCompact3D] Same paths as AStar3D") {
+	Ref<ABCX> abcx;
+	abcx.instantiate();
+	abcx->set_point_weight_scale(ABCX::B, 3);
+
+	Ref<AStarCompact3D> compact;
+	compact.instantiate();
+	compact->create_from(abcx);
+	CHECK(compact->get_point_count() == 4);
+
+	for (int from = ABCX::A; from <= ABCX::X; from++) {
+		for (int to = ABCX::A; to <= ABCX::X; to++) {
+			CHECK(compact->get_id_path(from, to) == abcx->get_id_path(from, to));
+		}
+	}
+
+	compact->set_point_disabled(ABCX::A);
+	CHECK(compact->get_id_path(ABCX::X, ABCX::C).is_empty());
+	CHECK(compact->get_closest_point(Vector3()) == ABCX::B);
+}
+
+static real_t get_grid_path_length(const TypedArray<Vector2i> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		Vector2i step = Vector2i(p_path[i]) - Vector2i(p_path[i - 1]);
+		CHECK(Math::abs(step.x) <= 1);
+		CHECK(Math::abs(step.y) <= 1);
+		length += Vector2(step).length();
+	}
+	return length;
+}
+
+TEST_CASE("[AStarGrid2D] Jump point search finds the shortest paths") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_size(Vector2i(16, 16));
+
+	// Walls with gaps, so the paths have to turn around them.
+	for (int i = 0; i < 14; i++) {
+		grid->set_point_solid(Vector2i(4, i));
+		grid->set_point_solid(Vector2i(9, 15 - i));
+		grid->set_point_solid(Vector2i(i + 1, 7));
+	}
+	grid->set_point_solid(Vector2i(4, 7), false);
+
+	for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+		grid->set_diagonal_mode(AStarGrid2D::DiagonalMode(mode));
+		grid->set_default_heuristic(mode == AStarGrid2D::DIAGONAL_MODE_NEVER ? AStarGrid2D::HEURISTIC_MANHATTAN : AStarGrid2D::HEURISTIC_OCTILE);
+
+		for (int to = 0; to < 16; to++) {
+			const Vector2i from = Vector2i(0, 0);
+			const Vector2i target = Vector2i(15, to);
+			if (grid->is_point_solid(target)) {
+				continue;
+			}
+
+			grid->set_jumping_enabled(false);
+			TypedArray<Vector2i> path = grid->get_id_path(from, target);
+			grid->set_jumping_enabled(true);
+			TypedArray<Vector2i> jump_path = grid->get_id_path(from, target);
+
+			REQUIRE(!path.is_empty());
+			REQUIRE(!jump_path.is_empty());
+			CHECK(Vector2i(jump_path[0]) == from);
+			CHECK(Vector2i(jump_path[jump_path.size() - 1]) == target);
+			for (int i = 0; i < jump_path.size(); i++) {
+				CHECK_FALSE(grid->is_point_solid(jump_path[i]));
+			}
+			CHECK(get_grid_path_length(jump_path) == doctest::Approx(get_grid_path_length(path)));
+		}
+	}
+}
+
+struct GridPathQueries {
+	Ref<AStarGrid2D> grid;
+	LocalVector<Vector2i> targets;
+	LocalVector<Vector<Vector2>> point_paths;
+	LocalVector<TypedArray<Vector2i>> id_paths;
+
+	void query(uint32_t p_index, const Vector2i *p_targets) {
+		const Vector2i target = p_targets[p_index % targets.size()];
+		point_paths[p_index] = grid->get_point_path(Vector2i(), target);
+		id_paths[p_index] = grid->get_id_path(Vector2i(), target);
+	}
+};
+
+TEST_CASE("[AStarGrid2D] Concurrent queries from worker threads") {
+	GridPathQueries queries;
+	queries.grid.instantiate();
+	queries.grid->set_size(Vector2i(32, 32));
+	queries.grid->set_offset(Vector2(-8, 4));
+	queries.grid->set_cell_size(Vector2(2, 3));
+	queries.grid->set_jumping_enabled(true);
+	for (int i = 0; i < 28; i++) {
+		queries.grid->set_point_solid(Vector2i(8, i));
+		queries.grid->set_point_solid(Vector2i(20, 31 - i));
+	}
+
+	for (int i = 0; i < 32; i++) {
+		queries.targets.push_back(Vector2i(31, i));
+	}
+	LocalVector<Vector<Vector2>> expected_point_paths;
+	LocalVector<TypedArray<Vector2i>> expected_id_paths;
+	for (uint32_t i = 0; i < queries.targets.size(); i++) {
+		expected_point_paths.push_back(queries.grid->get_point_path(Vector2i(), queries.targets[i]));
+		expected_id_paths.push_back(queries.grid->get_id_path(Vector2i(), queries.targets[i]));
+	}
+
+	const uint32_t query_count = queries.targets.size() * 8;
+	queries.point_paths.resize(query_count);
+	queries.id_paths.resize(query_count);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&queries, &GridPathQueries::query, queries.targets.ptr(), query_count);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		const uint32_t target = i % queries.targets.size();
+		REQUIRE(!expected_id_paths[target].is_empty());
+		CHECK(queries.point_paths[i] == expected_point_paths[target]);
+		CHECK(queries.id_paths[i] == expected_id_paths[target]);
+	}
+}
+
 TEST_CASE("[Stress][AStar3D] Find paths") {
 	// Random stress tests with Floyd-Warshall.
 	const int N = 30;
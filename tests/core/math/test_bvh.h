@@ -0,0 +1,191 @@
+/*************************************************************************/
+/*  test_bvh.h                                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+class PairTest {
+public:
+	static bool user_pair_check(const int *p_a, const int *p_b) {
+		return true;
+	}
+};
+
+class CullTest {
+public:
+	static bool user_cull_check(const int *p_a, const int *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<int, 1, false, 32, PairTest, CullTest> CullBVH;
+typedef BVH_Manager<int, 1, true, 32, PairTest, CullTest> PairBVH;
+
+static AABB random_aabb(RandomPCG &p_rng, real_t p_range, real_t p_max_size) {
+	Vector3 position(p_rng.random(-p_range, p_range), p_rng.random(-p_range, p_range), p_rng.random(-p_range, p_range));
+	Vector3 size(p_rng.random(0.1f, p_max_size), p_rng.random(0.1f, p_max_size), p_rng.random(0.1f, p_max_size));
+	return AABB(position, size);
+}
+
+TEST_CASE("[BVH] Culling matches a brute force search after items move") {
+	const int count = 1000;
+
+	CullBVH bvh;
+	RandomPCG rng(42);
+
+	int ids[count];
+	BVHHandle handles[count];
+	AABB aabbs[count];
+	for (int i = 0; i < count; i++) {
+		ids[i] = i;
+		aabbs[i] = random_aabb(rng, 100.0, 10.0);
+		handles[i] = bvh.create(&ids[i], true, 0, 1, aabbs[i]);
+	}
+	bvh.update();
+
+	int *results[count];
+	for (int round = 0; round < 10; round++) {
+		// Shrinking and moving items leaves oversized bounds behind, which the update refits.
+		for (int i = 0; i < count / 3; i++) {
+			int index = rng.random(0, count - 1);
+			if (i % 10 == 0) {
+				bvh.erase(handles[index]);
+				aabbs[index] = random_aabb(rng, 100.0, 10.0);
+				handles[index] = bvh.create(&ids[index], true, 0, 1, aabbs[index]);
+			} else {
+				aabbs[index] = random_aabb(rng, 100.0, round % 2 ? 1.0 : 10.0);
+				bvh.move(handles[index], aabbs[index]);
+			}
+		}
+		bvh.update();
+
+		for (int query = 0; query < 20; query++) {
+			AABB query_aabb = random_aabb(rng, 100.0, 40.0);
+			int result_count = bvh.cull_aabb(query_aabb, results, count, nullptr);
+
+			HashSet<int> found;
+			for (int i = 0; i < result_count; i++) {
+				found.insert(*results[i]);
+			}
+			HashSet<int> expected;
+			for (int i = 0; i < count; i++) {
+				if (query_aabb.intersects(aabbs[i])) {
+					expected.insert(i);
+				}
+			}
+
+			CHECK_MESSAGE(found.size() == expected.size(), "Round ", round, ", query ", query, ".");
+			bool all_found = true;
+			for (const int &E : expected) {
+				all_found = all_found && found.has(E);
+			}
+			CHECK_MESSAGE(all_found, "Round ", round, ", query ", query, ".");
+		}
+	}
+}
+
+struct PairLog {
+	// (1, a, b) when a pair is added, (0, a, b) when it is removed.
+	Vector<Vector3i> events;
+
+	static void *pair(void *p_self, uint32_t p_a, int *p_object_a, int p_subindex_a, uint32_t p_b, int *p_object_b, int p_subindex_b) {
+		static_cast<PairLog *>(p_self)->events.push_back(Vector3i(1, p_a, p_b));
+		return nullptr;
+	}
+
+	static void unpair(void *p_self, uint32_t p_a, int *p_object_a, int p_subindex_a, uint32_t p_b, int *p_object_b, int p_subindex_b, void *p_pair_data) {
+		static_cast<PairLog *>(p_self)->events.push_back(Vector3i(0, p_a, p_b));
+	}
+};
+
+TEST_CASE("[BVH] Threaded pairing sends the same callbacks as serial pairing") {
+	// Enough items move every round for the pairing to be spread over threads.
+	const int count = 600;
+
+	PairBVH serial;
+	PairBVH threaded;
+	threaded.params_set_threaded_pairing(true);
+
+	PairLog serial_log;
+	PairLog threaded_log;
+	serial.set_pair_callback(&PairLog::pair, &serial_log);
+	serial.set_unpair_callback(&PairLog::unpair, &serial_log);
+	threaded.set_pair_callback(&PairLog::pair, &threaded_log);
+	threaded.set_unpair_callback(&PairLog::unpair, &threaded_log);
+
+	RandomPCG rng(7);
+
+	int ids[count];
+	BVHHandle serial_handles[count];
+	BVHHandle threaded_handles[count];
+	for (int i = 0; i < count; i++) {
+		ids[i] = i;
+		AABB aabb = random_aabb(rng, 50.0, 5.0);
+		serial_handles[i] = serial.create(&ids[i], true, 0, 1, aabb);
+		threaded_handles[i] = threaded.create(&ids[i], true, 0, 1, aabb);
+	}
+	serial.update();
+	threaded.update();
+
+	REQUIRE(serial_log.events.size() > 0);
+	CHECK(threaded_log.events == serial_log.events);
+
+	for (int round = 0; round < 5; round++) {
+		serial_log.events.clear();
+		threaded_log.events.clear();
+
+		for (int i = 0; i < count; i++) {
+			AABB aabb = random_aabb(rng, 50.0, 5.0);
+			serial.move(serial_handles[i], aabb);
+			threaded.move(threaded_handles[i], aabb);
+		}
+		serial.update();
+		threaded.update();
+
+		CHECK_MESSAGE(serial_log.events.size() > 0, "Round ", round, ".");
+		CHECK_MESSAGE(threaded_log.events == serial_log.events, "Round ", round, ".");
+	}
+
+	for (int i = 0; i < count; i++) {
+		serial.erase(serial_handles[i]);
+		threaded.erase(threaded_handles[i]);
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
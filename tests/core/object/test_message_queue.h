@@ -0,0 +1,117 @@
+/*************************************************************************/
+/*  test_message_queue.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class CallLog : public Object {
+public:
+	LocalVector<int> tickets;
+
+	void add(int p_ticket) {
+		tickets.push_back(p_ticket);
+	}
+};
+
+struct PushThread {
+	static const int PUSH_COUNT = 500;
+
+	CallLog *log = nullptr;
+	Mutex *mutex = nullptr;
+	int *next_ticket = nullptr;
+	Thread::ID thread_id = 0;
+	Thread thread;
+
+	static void push_calls(void *p_data) {
+		PushThread *self = (PushThread *)p_data;
+		self->thread_id = Thread::get_caller_id();
+		for (int i = 0; i < PUSH_COUNT; i++) {
+			// The tickets are handed out in the order the calls are pushed.
+			MutexLock lock(*self->mutex);
+			MessageQueue::get_singleton()->push_callable(callable_mp(self->log, &CallLog::add), (*self->next_ticket)++);
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls pushed from several threads are flushed in push order") {
+	const int thread_count = 4;
+
+	CallLog log;
+	Mutex mutex;
+	int next_ticket = 0;
+
+	PushThread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].log = &log;
+		threads[i].mutex = &mutex;
+		threads[i].next_ticket = &next_ticket;
+		threads[i].thread.start(PushThread::push_calls, &threads[i]);
+	}
+
+	// Some calls from the main thread in between.
+	for (int i = 0; i < 100; i++) {
+		MutexLock lock(mutex);
+		MessageQueue::get_singleton()->push_callable(callable_mp(&log, &CallLog::add), next_ticket++);
+	}
+
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].thread.wait_to_finish();
+	}
+
+	// The threads have exited, and their last calls have to be flushed all the same.
+	MessageQueue::get_singleton()->flush();
+
+	REQUIRE(log.tickets.size() == uint32_t(next_ticket));
+	bool in_order = true;
+	for (uint32_t i = 0; i < log.tickets.size(); i++) {
+		in_order = in_order && log.tickets[i] == int(i);
+	}
+	CHECK(in_order);
+
+	// The buffers of the exited threads are freed once flushed.
+	List<MessageQueue::ThreadStatistics> statistics;
+	MessageQueue::get_singleton()->get_thread_statistics(&statistics);
+	for (const MessageQueue::ThreadStatistics &E : statistics) {
+		for (int i = 0; i < thread_count; i++) {
+			CHECK(E.thread_id != threads[i].thread_id);
+		}
+	}
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
@@ -1275,6 +1275,49 @@ TEST_CASE("[String] Path functions") {
 	}
 }
 
+TEST_CASE("[String] Simplify path") {
+	CHECK(String("res://a/./b//c/../d").simplify_path() == "res://a/b/d");
+	CHECK(String("res://../a").simplify_path() == "res://a");
+	CHECK(String("C:\\Godot\\..\\project\\").simplify_path() == "C:/project");
+	CHECK(String("//server/share/../dir").simplify_path() == "//server/dir");
+	CHECK(String("a/b/../../..").simplify_path() == "");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[String] Path functions allocate only their result") {
+	const String path = "res://assets/characters/../characters/knight/./textures/knight_albedo.png";
+	const String dir = "res://assets/characters/knight";
+
+	uint64_t allocations = Memory::get_mem_allocation_count();
+	String simplified = path.simplify_path();
+	CHECK_MESSAGE(Memory::get_mem_allocation_count() - allocations == 1, "simplify_path() should only allocate the result.");
+
+	allocations = Memory::get_mem_allocation_count();
+	String base_dir = path.get_base_dir();
+	CHECK_MESSAGE(Memory::get_mem_allocation_count() - allocations == 1, "get_base_dir() should only allocate the result.");
+
+	allocations = Memory::get_mem_allocation_count();
+	String joined = dir.plus_file("knight.tscn");
+	CHECK_MESSAGE(Memory::get_mem_allocation_count() - allocations <= 2, "plus_file() should only allocate the argument and the result.");
+
+	allocations = Memory::get_mem_allocation_count();
+	String replaced = path.replace("characters", "npcs");
+	CHECK_MESSAGE(Memory::get_mem_allocation_count() - allocations == 1, "replace() should only allocate the result.");
+
+	allocations = Memory::get_mem_allocation_count();
+	String extension = path.get_extension();
+	String file = path.get_file();
+	CHECK_MESSAGE(Memory::get_mem_allocation_count() - allocations == 2, "get_extension() and get_file() should only allocate their results.");
+
+	CHECK(simplified == "res://assets/characters/knight/textures/knight_albedo.png");
+	CHECK(base_dir == "res://assets/characters/../characters/knight/./textures");
+	CHECK(joined == "res://assets/characters/knight/knight.tscn");
+	CHECK(replaced == "res://assets/npcs/../npcs/knight/./textures/knight_albedo.png");
+	CHECK(extension == "png");
+	CHECK(file == "knight_albedo.png");
+}
+#endif
+
 TEST_CASE("[String] hash") {
 	String a = "Test";
 	String b = "Test";
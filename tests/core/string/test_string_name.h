@@ -0,0 +1,217 @@
+/*************************************************************************/
+/*  test_string_name.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Same name from multiple threads") {
+	const int thread_count = 8;
+	const int name_count = 2000;
+
+	struct Job {
+		const Vector<String> *names = nullptr;
+		Vector<const void *> pointers;
+		// Hold the references until every thread is done, so entries are shared instead of recreated.
+		Vector<StringName> held;
+
+		static void run(void *p_userdata) {
+			Job *job = (Job *)p_userdata;
+			for (int i = 0; i < job->names->size(); i++) {
+				StringName name = job->names->get(i);
+				job->pointers.push_back(name.data_unique_pointer());
+				job->held.push_back(name);
+			}
+		}
+	};
+
+	Vector<String> names;
+	for (int i = 0; i < name_count; i++) {
+		names.push_back("test_string_name_shared_" + itos(i));
+	}
+
+	Job jobs[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		jobs[i].names = &names;
+		threads[i].start(Job::run, &jobs[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	bool all_equal = true;
+	for (int i = 1; i < thread_count; i++) {
+		for (int j = 0; j < name_count; j++) {
+			all_equal = all_equal && jobs[i].pointers[j] == jobs[0].pointers[j];
+		}
+	}
+	CHECK_MESSAGE(all_equal, "Every thread should get the same entry for the same name.");
+	CHECK_MESSAGE(StringName(names[0]) == jobs[0].held[0], "A name interned on a thread should be found from the main thread.");
+	CHECK_MESSAGE(jobs[0].held[0] != jobs[0].held[1], "Different names should get different entries.");
+}
+
+TEST_CASE("[StringName] Table grows beyond the initial bucket count") {
+	const int name_count = 200000;
+
+	Vector<StringName> names;
+	names.resize(name_count);
+	for (int i = 0; i < name_count; i++) {
+		names.write[i] = StringName("test_string_name_growth_" + itos(i));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < name_count; i++) {
+		all_found = all_found && StringName::search("test_string_name_growth_" + itos(i)) == names[i];
+	}
+	CHECK_MESSAGE(all_found, "All the names should still be found after the table has grown.");
+
+	names.clear();
+	CHECK_MESSAGE(StringName::search(String("test_string_name_growth_0")) == StringName(), "Names should be removed once they are no longer referenced.");
+}
+
+TEST_CASE("[StringName] Shared names stay equal while other threads grow the table") {
+	const int thread_count = 8;
+	const int shared_count = 1024;
+	const int operations = 20000;
+
+	struct Job {
+		const Vector<String> *names = nullptr;
+		int index = 0;
+		int operations = 0;
+		Vector<StringName> results;
+
+		static void run(void *p_userdata) {
+			Job *job = (Job *)p_userdata;
+			const String prefix = "test_string_name_temporary_" + itos(job->index) + "_";
+			job->results.resize(job->names->size());
+			for (int i = 0; i < job->operations; i++) {
+				// Temporary names grow the table and are released right away, while shared names are interned in between.
+				if (i % 8 == 0) {
+					StringName temporary = prefix + itos(i);
+				} else {
+					int name = i % job->names->size();
+					job->results.write[name] = job->names->get(name);
+				}
+			}
+		}
+	};
+
+	Vector<String> names;
+	for (int i = 0; i < shared_count; i++) {
+		names.push_back("test_string_name_contended_" + itos(i));
+	}
+
+	Job jobs[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		jobs[i].names = &names;
+		jobs[i].index = i;
+		jobs[i].operations = operations;
+		threads[i].start(Job::run, &jobs[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	bool all_equal = true;
+	for (int i = 0; i < shared_count; i++) {
+		const StringName expected = names[i];
+		for (int j = 0; j < thread_count; j++) {
+			all_equal = all_equal && jobs[j].results[i] == expected;
+		}
+	}
+	CHECK_MESSAGE(all_equal, "Names interned on different threads should compare equal to the same name interned on the main thread.");
+	CHECK_MESSAGE(StringName::search(String("test_string_name_temporary_0_0")) == StringName(), "Temporary names should be removed once every thread has released them.");
+}
+
+// Skipped by default, run it with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[StringName][Benchmark] Multi-threaded intern throughput" * doctest::skip()) {
+	const int operations = 100000;
+	const int shared_names = 1024;
+
+	struct Job {
+		const Vector<String> *names = nullptr;
+		int index = 0;
+		int operations = 0;
+
+		static void run(void *p_userdata) {
+			Job *job = (Job *)p_userdata;
+			const String prefix = "test_string_name_bench_" + itos(job->index) + "_";
+			for (int i = 0; i < job->operations; i++) {
+				// Mostly lookups of existing names, like ClassDB and script calls, plus some new temporary names.
+				if (i % 8 == 0) {
+					StringName name = prefix + itos(i);
+				} else {
+					StringName name = job->names->get(i % job->names->size());
+				}
+			}
+		}
+	};
+
+	Vector<String> names;
+	Vector<StringName> held;
+	for (int i = 0; i < shared_names; i++) {
+		names.push_back("test_string_name_bench_shared_" + itos(i));
+		held.push_back(names[i]);
+	}
+
+	for (int thread_count = 1; thread_count <= 8; thread_count *= 2) {
+		Job jobs[8];
+		Thread threads[8];
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			jobs[i].names = &names;
+			jobs[i].index = i;
+			jobs[i].operations = operations;
+			threads[i].start(Job::run, &jobs[i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		MESSAGE(vformat("%d threads: %d names interned in %d usec (%.1f names/ms).", thread_count, thread_count * operations, elapsed, thread_count * operations * 1000.0 / elapsed));
+	}
+
+	CHECK_MESSAGE(StringName::search(names[0]) == held[0], "Shared names should still be interned after the benchmark.");
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
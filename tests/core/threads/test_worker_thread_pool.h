@@ -153,6 +153,59 @@ TEST_CASE("[WorkerThreadPool] Process 256 elements on native task group low prio
 	CHECK(callable_group_counter.get() == count - 1);
 }
 
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	SafeNumeric<uint32_t> *counter = (SafeNumeric<uint32_t> *)p_arg;
+	counter->increment();
+}
+
+static void static_nested_test(void *p_arg) {
+	// Adding and waiting from inside a pool thread uses its own queue, which other threads steal from.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, p_arg, 64, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+}
+
+TEST_CASE("[WorkerThreadPool] Process nested task groups added from pool threads") {
+	const int count = 32;
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, &counter, true);
+	}
+	for (int i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+
+	CHECK(counter.get() == count * 64);
+}
+
+TEST_CASE("[WorkerThreadPool] Thread statistics") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	uint64_t processed_before = 0;
+	for (int i = 0; i < pool->get_thread_count(); i++) {
+		processed_before += pool->get_thread_stats(i).tasks_processed;
+	}
+
+	const int count = 64;
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = pool->add_native_task(static_test, &counter, true);
+	}
+	for (int i = 0; i < count; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+
+	uint64_t processed_after = 0;
+	for (int i = 0; i < pool->get_thread_count(); i++) {
+		processed_after += pool->get_thread_stats(i).tasks_processed;
+	}
+
+	// Leftover tasks from groups completed by helping threads may be counted too.
+	CHECK_MESSAGE(processed_after - processed_before >= count, "Tasks added from outside the pool should all be processed by pool threads.");
+	CHECK(counter.get() == count);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
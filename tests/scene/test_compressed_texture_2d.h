@@ -0,0 +1,122 @@
+/*************************************************************************/
+/*  test_compressed_texture_2d.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_2D_H
+#define TEST_COMPRESSED_TEXTURE_2D_H
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "scene/resources/texture.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCompressedTexture2D {
+
+Ref<Image> make_mipmapped_image(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size * p_size * 4);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < p_size * p_size; i++) {
+		w[i * 4 + 0] = (i % p_size) * 255 / p_size;
+		w[i * 4 + 1] = (i / p_size) * 255 / p_size;
+		w[i * 4 + 2] = (i * 7) % 256;
+		w[i * 4 + 3] = 255;
+	}
+
+	Ref<Image> image = memnew(Image(p_size, p_size, false, Image::FORMAT_RGBA8, data));
+	image->generate_mipmaps();
+	return image;
+}
+
+// Same layout as ResourceImporterTexture writes, without the .ctex file header.
+Ref<FileAccess> store_image_data(const Ref<Image> &p_image, CompressedTexture2D::DataFormat p_data_format) {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("compressed_texture_2d_data.bin");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_32(p_data_format);
+	f->store_16(p_image->get_width());
+	f->store_16(p_image->get_height());
+	f->store_32(p_image->get_mipmap_count());
+	f->store_32(p_image->get_format());
+
+	if (p_data_format == CompressedTexture2D::DATA_FORMAT_PNG) {
+		for (int i = 0; i < p_image->get_mipmap_count() + 1; i++) {
+			Vector<uint8_t> png = p_image->get_image_from_mipmap(i)->save_png_to_buffer();
+			f->store_32(png.size());
+			f->store_buffer(png.ptr(), png.size());
+		}
+	} else {
+		Vector<uint8_t> data = p_image->get_data();
+		f->store_buffer(data.ptr(), data.size());
+	}
+	f = Ref<FileAccess>();
+
+	return FileAccess::open(path, FileAccess::READ);
+}
+
+void check_size_limit(CompressedTexture2D::DataFormat p_data_format) {
+	const Ref<Image> source = make_mipmapped_image(16);
+	REQUIRE(source->get_mipmap_count() == 4);
+
+	// Size limit, expected size, first mipmap of the source that should be loaded.
+	const int cases[][3] = {
+		{ 0, 16, 0 },
+		{ 32, 16, 0 },
+		{ 16, 16, 0 },
+		{ 5, 4, 2 },
+		{ 4, 4, 2 },
+		{ 1, 1, 4 },
+	};
+
+	for (const int(&c)[3] : cases) {
+		Ref<FileAccess> f = store_image_data(source, p_data_format);
+		REQUIRE(f.is_valid());
+
+		Ref<Image> image = CompressedTexture2D::load_image_from_file(f, c[0]);
+		REQUIRE(image.is_valid());
+
+		const String limit = "With a size limit of " + itos(c[0]) + ", ";
+		CHECK_MESSAGE(image->get_width() == c[1], String(limit + "the image should be as large as the largest mipmap that fits."));
+		CHECK_MESSAGE(image->get_height() == c[1], String(limit + "the image should be as large as the largest mipmap that fits."));
+		CHECK_MESSAGE(image->has_mipmaps() == (c[2] < source->get_mipmap_count()), String(limit + "the smaller mipmaps should be kept."));
+		CHECK_MESSAGE(image->get_data() == source->get_data().slice(source->get_mipmap_offset(c[2])), String(limit + "the data should start at the largest mipmap that fits."));
+	}
+}
+
+TEST_CASE("[CompressedTexture2D] Size limit when loading raw image data") {
+	check_size_limit(CompressedTexture2D::DATA_FORMAT_IMAGE);
+}
+
+TEST_CASE("[CompressedTexture2D] Size limit when loading PNG mipmaps") {
+	check_size_limit(CompressedTexture2D::DATA_FORMAT_PNG);
+}
+
+} // namespace TestCompressedTexture2D
+
+#endif // TEST_COMPRESSED_TEXTURE_2D_H
@@ -0,0 +1,192 @@
+/*************************************************************************/
+/*  test_process_thread_group.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PROCESS_THREAD_GROUP_H
+#define TEST_PROCESS_THREAD_GROUP_H
+
+#include "core/os/mutex.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestProcessNode : public Node {
+	GDCLASS(_TestProcessNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			MutexLock lock(*mutex);
+			log->push_back(get_name());
+		}
+	}
+
+public:
+	Mutex *mutex = nullptr;
+	Vector<String> *log = nullptr;
+};
+
+namespace TestProcessThreadGroup {
+
+class ProcessLog {
+	Mutex mutex;
+	Vector<String> log;
+
+public:
+	_TestProcessNode *add(Node *p_parent, const String &p_name, Node::ProcessThreadGroup p_group = Node::PROCESS_THREAD_GROUP_INHERIT, int p_order = 0) {
+		_TestProcessNode *node = memnew(_TestProcessNode);
+		node->set_name(p_name);
+		node->mutex = &mutex;
+		node->log = &log;
+		node->set_process_thread_group(p_group);
+		node->set_process_thread_group_order(p_order);
+		p_parent->add_child(node);
+		node->set_process(true);
+		return node;
+	}
+
+	Vector<String> process() {
+		log.clear();
+		SceneTree::get_singleton()->process(0.0);
+		return log;
+	}
+};
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Groups are processed by order") {
+	ProcessLog log;
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node *late = log.add(root, "Late", Node::PROCESS_THREAD_GROUP_SUB_THREAD, 2);
+	log.add(late, "LateChild");
+	Node *early = log.add(root, "Early", Node::PROCESS_THREAD_GROUP_SUB_THREAD, -1);
+	log.add(early, "EarlyChild");
+	Node *main = log.add(root, "Main", Node::PROCESS_THREAD_GROUP_MAIN_THREAD, 1);
+	log.add(main, "MainChild");
+
+	Vector<String> processed = log.process();
+	Vector<String> expected = { "Early", "EarlyChild", "Main", "MainChild", "Late", "LateChild" };
+	CHECK(processed == expected);
+
+	SUBCASE("Changing the order moves the whole group") {
+		late->set_process_thread_group_order(0);
+		processed = log.process();
+		expected = { "Early", "EarlyChild", "Late", "LateChild", "Main", "MainChild" };
+		CHECK(processed == expected);
+	}
+
+	memdelete(late);
+	memdelete(early);
+	memdelete(main);
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Main thread groups run before sub-thread groups of the same order") {
+	ProcessLog log;
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node *sub_threads[2];
+	for (int i = 0; i < 2; i++) {
+		sub_threads[i] = log.add(root, "Sub" + itos(i), Node::PROCESS_THREAD_GROUP_SUB_THREAD, 0);
+	}
+	Node *main = log.add(root, "Main", Node::PROCESS_THREAD_GROUP_MAIN_THREAD, 0);
+	log.add(main, "MainChild");
+
+	Vector<String> processed = log.process();
+	REQUIRE(processed.size() == 4);
+	CHECK(processed[0] == "Main");
+	CHECK(processed[1] == "MainChild");
+
+	memdelete(sub_threads[0]);
+	memdelete(sub_threads[1]);
+	memdelete(main);
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Group membership") {
+	ProcessLog log;
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node *first = log.add(root, "First", Node::PROCESS_THREAD_GROUP_SUB_THREAD, 0);
+	Node *second = log.add(root, "Second", Node::PROCESS_THREAD_GROUP_SUB_THREAD, 1);
+	Node *child = log.add(first, "Child");
+	log.add(child, "GrandChild");
+
+	Vector<String> processed = log.process();
+	Vector<String> expected = { "First", "Child", "GrandChild", "Second" };
+	CHECK(processed == expected);
+
+	SUBCASE("Reparented nodes join the group of their new parent") {
+		first->remove_child(child);
+		second->add_child(child);
+		processed = log.process();
+		expected = { "First", "Second", "Child", "GrandChild" };
+		CHECK(processed == expected);
+	}
+
+	SUBCASE("Nodes starting their own group take their children along") {
+		child->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+		child->set_process_thread_group_order(2);
+		processed = log.process();
+		expected = { "First", "Second", "Child", "GrandChild" };
+		CHECK(processed == expected);
+
+		child->set_process_thread_group(Node::PROCESS_THREAD_GROUP_INHERIT);
+		processed = log.process();
+		expected = { "First", "Child", "GrandChild", "Second" };
+		CHECK(processed == expected);
+	}
+
+	SUBCASE("Groups of the same order follow the tree after nodes move") {
+		second->set_process_thread_group_order(0);
+		second->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+		first->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+		Node *sub_thread = log.add(root, "SubThread", Node::PROCESS_THREAD_GROUP_SUB_THREAD, 1);
+
+		processed = log.process();
+		expected = { "First", "Child", "GrandChild", "Second", "SubThread" };
+		CHECK(processed == expected);
+
+		root->move_child(second, first->get_index());
+		processed = log.process();
+		expected = { "Second", "First", "Child", "GrandChild", "SubThread" };
+		CHECK(processed == expected);
+
+		memdelete(sub_thread);
+	}
+
+	memdelete(first);
+	memdelete(second);
+}
+
+} // namespace TestProcessThreadGroup
+
+#endif // TEST_PROCESS_THREAD_GROUP_H
@@ -0,0 +1,124 @@
+/*************************************************************************/
+/*  test_residency_manager.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RESIDENCY_MANAGER_H
+#define TEST_RESIDENCY_MANAGER_H
+
+#include "scene/resources/residency_manager.h"
+
+#include "tests/test_macros.h"
+
+namespace TestResidencyManager {
+
+// Sizes of a 16x16 texture with mipmaps, one byte per pixel.
+ResidencyManager::LevelRequest make_request(int p_level, int p_wanted_level, float p_screen_size = 0.0f, uint64_t p_last_visible_frame = 0) {
+	ResidencyManager::LevelRequest request;
+	request.level = p_level;
+	request.wanted_level = p_wanted_level;
+	request.screen_size = p_screen_size;
+	request.last_visible_frame = p_last_visible_frame;
+	request.level_sizes.push_back(341);
+	request.level_sizes.push_back(85);
+	request.level_sizes.push_back(21);
+	request.level_sizes.push_back(5);
+	request.level_sizes.push_back(1);
+	return request;
+}
+
+TEST_CASE("[ResidencyManager] Stream-ins stay within the memory budget") {
+	LocalVector<ResidencyManager::LevelRequest> requests;
+	requests.push_back(make_request(4, 0, 100.0f));
+	requests.push_back(make_request(4, 0, 200.0f));
+	requests.push_back(make_request(4, 1, 50.0f));
+
+	LocalVector<ResidencyManager::LevelSelection> selections;
+	uint64_t memory = ResidencyManager::select_levels(requests, 3, 720, 8, selections);
+	REQUIRE(selections.size() == 3);
+	CHECK_MESSAGE(selections[0].request == 1, "The largest resource on screen should get more detail first.");
+	CHECK(selections[0].level == 0);
+	CHECK(selections[1].request == 0);
+	CHECK(selections[1].level == 0);
+	CHECK(selections[2].request == 2);
+	CHECK_MESSAGE(selections[2].level == 2, "A resource should settle for the most detail that still fits in the budget.");
+	CHECK(memory == 341 + 341 + 21);
+	CHECK(!selections[0].eviction);
+
+	selections.clear();
+	memory = ResidencyManager::select_levels(requests, 3, 720, 1, selections);
+	REQUIRE_MESSAGE(selections.size() == 1, "No more stream-ins than allowed per frame should be made.");
+	CHECK(selections[0].request == 1);
+	CHECK(memory == 341 + 1 + 1);
+
+	selections.clear();
+	memory = ResidencyManager::select_levels(requests, 3, 4, 8, selections);
+	CHECK_MESSAGE(selections.is_empty(), "Nothing should be streamed in when no level fits in the budget.");
+	CHECK(memory == 3);
+}
+
+TEST_CASE("[ResidencyManager] Resources seen least recently are evicted first") {
+	LocalVector<ResidencyManager::LevelRequest> requests;
+	requests.push_back(make_request(0, 4, 0.0f, 10));
+	requests.push_back(make_request(0, 4, 0.0f, 5));
+	requests.push_back(make_request(0, 4, 0.0f, 20));
+	requests.push_back(make_request(4, 0, 100.0f, 30));
+	const uint64_t memory = 341 * 3 + 1;
+
+	LocalVector<ResidencyManager::LevelSelection> selections;
+	uint64_t new_memory = ResidencyManager::select_levels(requests, memory, 10000, 8, selections);
+	REQUIRE(selections.size() == 1);
+	CHECK_MESSAGE(selections[0].request == 3, "Nothing should be evicted while the budget isn't exceeded.");
+
+	selections.clear();
+	new_memory = ResidencyManager::select_levels(requests, memory, 800, 8, selections);
+	REQUIRE(selections.size() == 3);
+	CHECK_MESSAGE(selections[0].request == 1, "The resource seen least recently should be evicted first.");
+	CHECK(selections[0].level == 4);
+	CHECK(selections[0].eviction);
+	CHECK(selections[1].request == 0);
+	CHECK(selections[1].eviction);
+	CHECK_MESSAGE(selections[2].request == 3, "The stream-in should be made once enough memory was freed.");
+	CHECK(selections[2].level == 0);
+	CHECK(!selections[2].eviction);
+	CHECK(new_memory == 341 * 2 + 1 * 2);
+	CHECK(new_memory <= 800);
+
+	// Without anything to stream in, evictions only bring the memory back under the budget.
+	requests.remove_at(3);
+	selections.clear();
+	new_memory = ResidencyManager::select_levels(requests, 341 * 3, 400, 8, selections);
+	REQUIRE_MESSAGE(selections.size() == 2, "Only as many resources as needed to fit in a lowered budget should be evicted.");
+	CHECK(selections[0].request == 1);
+	CHECK(selections[1].request == 0);
+	CHECK(new_memory == 341 + 1 * 2);
+}
+
+} // namespace TestResidencyManager
+
+#endif // TEST_RESIDENCY_MANAGER_H
@@ -0,0 +1,223 @@
+/*************************************************************************/
+/*  test_physics_2d.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_2D_H
+#define TEST_PHYSICS_2D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_2d/godot_step_2d.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics2D {
+
+// Three piles of boxes and circles falling on a shared static ground,
+// so they make three islands that only meet through a static body.
+struct PhysicsScene2D {
+	static const int PILE_COUNT = 3;
+	static const int PILE_SIZE = 8;
+
+	RID space;
+	RID ground_shape;
+	RID box_shape;
+	RID circle_shape;
+	Vector<RID> bodies; // In the order they joined the space, the ground first.
+
+	static Transform2D get_initial_transform(int p_index) {
+		if (p_index == 0) {
+			return Transform2D(0.0, Vector2(0, 10));
+		}
+		int pile = (p_index - 1) / PILE_SIZE;
+		int level = (p_index - 1) % PILE_SIZE;
+		// Slightly off center, so the piles topple.
+		return Transform2D(0.05 * level, Vector2(-200 + pile * 200 + (level % 3) * 3.5, -15 - level * 22));
+	}
+
+	// Bodies always join the space in the same order. With p_shuffled, they are created and
+	// positioned in a different order, which changes their RIDs and how the broadphase is built.
+	void create(bool p_shuffled = false) {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+		space = ps->space_create();
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+		ground_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(ground_shape, Vector2(400, 10));
+		box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(10, 10));
+		circle_shape = ps->circle_shape_create();
+		ps->shape_set_data(circle_shape, 10.0);
+
+		const int body_count = 1 + PILE_COUNT * PILE_SIZE;
+		bodies.resize(body_count);
+		for (int i = 0; i < body_count; i++) {
+			int index = p_shuffled ? body_count - 1 - i : i;
+			RID body = ps->body_create();
+			if (index == 0) {
+				ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+				ps->body_add_shape(body, ground_shape);
+			} else {
+				ps->body_add_shape(body, index % 2 ? box_shape : circle_shape);
+			}
+			if (!p_shuffled) {
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, get_initial_transform(index));
+				ps->body_set_space(body, space);
+			}
+			bodies.write[index] = body;
+		}
+
+		if (p_shuffled) {
+			for (int i = 0; i < body_count; i++) {
+				ps->body_set_space(bodies[i], space);
+			}
+			for (int i = body_count - 1; i >= 0; i--) {
+				ps->body_set_state(bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM, get_initial_transform(i));
+			}
+		}
+
+		ps->space_set_active(space, true);
+	}
+
+	void step(int p_steps) {
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+		}
+	}
+
+	Vector<Transform2D> get_transforms() const {
+		Vector<Transform2D> transforms;
+		for (int i = 0; i < bodies.size(); i++) {
+			transforms.push_back(PhysicsServer2D::get_singleton()->body_get_state(bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM));
+		}
+		return transforms;
+	}
+
+	void clear() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		ps->space_set_active(space, false);
+		for (int i = 0; i < bodies.size(); i++) {
+			ps->free(bodies[i]);
+		}
+		bodies.clear();
+		ps->free(ground_shape);
+		ps->free(box_shape);
+		ps->free(circle_shape);
+		ps->free(space);
+	}
+};
+
+static bool is_bit_identical(const Vector<Transform2D> &p_a, const Vector<Transform2D> &p_b) {
+	return p_a.size() == p_b.size() && memcmp(p_a.ptr(), p_b.ptr(), p_a.size() * sizeof(Transform2D)) == 0;
+}
+
+static Vector<Transform2D> simulate(int p_steps, bool p_shuffled = false) {
+	PhysicsScene2D scene;
+	scene.create(p_shuffled);
+	scene.step(p_steps);
+	Vector<Transform2D> transforms = scene.get_transforms();
+	scene.clear();
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][Physics2D] Parallel and serial steps give the same result") {
+	Vector<Transform2D> parallel = simulate(120);
+
+	GodotStep2D::set_single_threaded(true);
+	Vector<Transform2D> serial = simulate(120);
+	GodotStep2D::set_single_threaded(false);
+
+	// Make sure something happened at all.
+	CHECK_FALSE(parallel[1].is_equal_approx(PhysicsScene2D::get_initial_transform(1)));
+	CHECK(is_bit_identical(parallel, serial));
+}
+
+TEST_CASE("[SceneTree][Physics2D] Deterministic spaces give bit-identical results") {
+	ProjectSettings *ps = ProjectSettings::get_singleton();
+	ps->set_setting("physics/2d/determinism/enabled", true);
+
+	SUBCASE("Without fixed-point rounding") {
+		ps->set_setting("physics/2d/determinism/fixed_point_fraction_bits", 0);
+	}
+	SUBCASE("With fixed-point rounding") {
+		ps->set_setting("physics/2d/determinism/fixed_point_fraction_bits", 8);
+	}
+
+	Vector<Transform2D> first = simulate(120);
+	Vector<Transform2D> second = simulate(120);
+	CHECK(is_bit_identical(first, second));
+
+	// Bodies are woken up, paired and inserted in the broadphase in another order,
+	// but they are processed in the order they joined the space all the same.
+	Vector<Transform2D> shuffled = simulate(120, true);
+	CHECK(is_bit_identical(first, shuffled));
+
+	ps->set_setting("physics/2d/determinism/enabled", false);
+	ps->set_setting("physics/2d/determinism/fixed_point_fraction_bits", 0);
+}
+
+TEST_CASE("[SceneTree][Physics2D] Restoring a saved space state replays the same steps") {
+	ProjectSettings *ps = ProjectSettings::get_singleton();
+	ps->set_setting("physics/2d/determinism/enabled", true);
+
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+	PhysicsScene2D scene;
+	scene.create();
+
+	// Save while the piles are falling and colliding, so the contact caches are part of the state.
+	scene.step(40);
+	PackedByteArray saved = physics_server->space_save_state(scene.space);
+	REQUIRE_FALSE(saved.is_empty());
+
+	scene.step(60);
+	Vector<Transform2D> first = scene.get_transforms();
+	PackedByteArray first_state = physics_server->space_save_state(scene.space);
+
+	CHECK(physics_server->space_restore_state(scene.space, saved) == OK);
+
+	scene.step(60);
+	Vector<Transform2D> second = scene.get_transforms();
+	PackedByteArray second_state = physics_server->space_save_state(scene.space);
+
+	CHECK(is_bit_identical(first, second));
+	CHECK(first_state == second_state);
+
+	ERR_PRINT_OFF;
+	CHECK(physics_server->space_restore_state(scene.space, PackedByteArray()) != OK);
+	ERR_PRINT_ON;
+
+	scene.clear();
+	ps->set_setting("physics/2d/determinism/enabled", false);
+}
+
+} // namespace TestPhysics2D
+
+#endif // TEST_PHYSICS_2D_H
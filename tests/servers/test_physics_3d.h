@@ -0,0 +1,113 @@
+/*************************************************************************/
+/*  test_physics_3d.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_H
+#define TEST_PHYSICS_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3D {
+
+TEST_CASE("[SceneTree][Physics3D] Restoring a saved space state puts the bodies back") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	ps->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID ground_shape = ps->box_shape_create();
+	ps->shape_set_data(ground_shape, Vector3(20, 1, 20));
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(ground, space);
+
+	Vector<RID> boxes;
+	for (int i = 0; i < 6; i++) {
+		RID box = ps->body_create();
+		ps->body_add_shape(box, box_shape);
+		ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), 0.1 * i), Vector3(0.2 * (i % 2), 0.5 + i * 1.1, 0)));
+		ps->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+	ps->space_set_active(space, true);
+
+	// Save while the boxes are landing on each other, so the contact caches are part of the state.
+	for (int i = 0; i < 30; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	PackedByteArray saved = ps->space_save_state(space);
+	REQUIRE_FALSE(saved.is_empty());
+
+	Vector<Transform3D> saved_transforms;
+	Vector<Vector3> saved_velocities;
+	for (int i = 0; i < boxes.size(); i++) {
+		saved_transforms.push_back(ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM));
+		saved_velocities.push_back(ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY));
+	}
+
+	for (int i = 0; i < 30; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	CHECK(ps->space_restore_state(space, saved) == OK);
+
+	for (int i = 0; i < boxes.size(); i++) {
+		Transform3D transform = ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		Vector3 velocity = ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK(memcmp(&transform, &saved_transforms[i], sizeof(Transform3D)) == 0);
+		CHECK(memcmp(&velocity, &saved_velocities[i], sizeof(Vector3)) == 0);
+	}
+
+	// Snapshots from another kind of space are rejected.
+	PackedByteArray wrong_magic = saved;
+	wrong_magic.write[0] ^= 0xFF;
+	ERR_PRINT_OFF;
+	CHECK(ps->space_restore_state(space, wrong_magic) == ERR_FILE_UNRECOGNIZED);
+	ERR_PRINT_ON;
+
+	ps->space_set_active(space, false);
+	for (int i = 0; i < boxes.size(); i++) {
+		ps->free(boxes[i]);
+	}
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+}
+
+} // namespace TestPhysics3D
+
+#endif // TEST_PHYSICS_3D_H
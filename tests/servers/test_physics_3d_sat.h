@@ -0,0 +1,214 @@
+/*************************************************************************/
+/*  test_physics_3d_sat.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_SAT_H
+#define TEST_PHYSICS_3D_SAT_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d_sat_batch.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DSAT {
+
+static Transform3D random_transform(RandomPCG &p_rng, real_t p_spread) {
+	Vector3 axis = Vector3(p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f)).normalized();
+	if (axis.is_equal_approx(Vector3())) {
+		axis = Vector3(0, 1, 0);
+	}
+	Vector3 origin = Vector3(p_rng.random(-p_spread, p_spread), p_rng.random(-p_spread, p_spread), p_rng.random(-p_spread, p_spread));
+	return Transform3D(Basis(axis, p_rng.random(0.0f, (float)Math_TAU)), origin);
+}
+
+TEST_CASE("[Physics3D][SAT] Batched projections match the shape projections") {
+	GodotSATBatch3D::Implementation initial_implementation = GodotSATBatch3D::get_implementation();
+
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 1.0, 2.0));
+
+	PackedVector3Array points;
+	RandomPCG rng(1234);
+	for (int i = 0; i < 40; i++) {
+		points.push_back(Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)));
+	}
+	GodotConvexPolygonShape3D convex;
+	convex.set_data(points);
+	const Vector<Vector3> &vertices = convex.get_mesh().vertices;
+
+	for (int impl = 0; impl < GodotSATBatch3D::IMPLEMENTATION_MAX; impl++) {
+		GodotSATBatch3D::Implementation implementation = GodotSATBatch3D::Implementation(impl);
+		if (!GodotSATBatch3D::is_implementation_supported(implementation)) {
+			continue;
+		}
+		GodotSATBatch3D::set_implementation(implementation);
+
+		for (int test = 0; test < 32; test++) {
+			Transform3D transform = random_transform(rng, 10.0);
+
+			GodotSATBatch3D::Axes axes;
+			int axis_count = 1 + test % GodotSATBatch3D::MAX_AXES;
+			for (int i = 0; i < axis_count; i++) {
+				axes.add(Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)).normalized());
+			}
+
+			LocalVector<Vector3> world_vertices;
+			for (int i = 0; i < vertices.size(); i++) {
+				world_vertices.push_back(transform.xform(vertices[i]));
+			}
+
+			GodotSATBatch3D::Ranges box_ranges;
+			GodotSATBatch3D::Ranges convex_ranges;
+			GodotSATBatch3D::project_box(axes, transform, box.get_half_extents(), box_ranges);
+			GodotSATBatch3D::project_points(axes, world_vertices.ptr(), world_vertices.size(), convex_ranges);
+
+			for (int i = 0; i < axis_count; i++) {
+				real_t min, max;
+				box.project_range(axes.get(i), transform, min, max);
+				CHECK_MESSAGE(
+						(Math::is_equal_approx(box_ranges.min[i], min) && Math::is_equal_approx(box_ranges.max[i], max)),
+						vformat("Box projection with the %s implementation should match GodotBoxShape3D::project_range().", GodotSATBatch3D::get_implementation_name(implementation)));
+
+				convex.project_range(axes.get(i), transform, min, max);
+				CHECK_MESSAGE(
+						(Math::is_equal_approx(convex_ranges.min[i], min) && Math::is_equal_approx(convex_ranges.max[i], max)),
+						vformat("Convex projection with the %s implementation should match GodotConvexPolygonShape3D::project_range().", GodotSATBatch3D::get_implementation_name(implementation)));
+			}
+		}
+	}
+
+	GodotSATBatch3D::set_implementation(initial_implementation);
+}
+
+struct ContactCounter {
+	int contacts = 0;
+
+	static void callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata) {
+		static_cast<ContactCounter *>(p_userdata)->contacts++;
+	}
+};
+
+// Solves the same shape pairs with every supported implementation, checking they agree.
+// Benchmarks also report the throughput of each implementation.
+static void check_pairs(const char *p_name, const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, int p_pair_count, bool p_benchmark = false) {
+	GodotSATBatch3D::Implementation initial_implementation = GodotSATBatch3D::get_implementation();
+
+	RandomPCG rng(4321);
+	LocalVector<Transform3D> transforms_A;
+	LocalVector<Transform3D> transforms_B;
+	for (int i = 0; i < p_pair_count; i++) {
+		transforms_A.push_back(random_transform(rng, 1.0));
+		transforms_B.push_back(random_transform(rng, 1.0));
+	}
+
+	int reference_collisions = -1;
+	int reference_contacts = -1;
+
+	for (int impl = 0; impl < GodotSATBatch3D::IMPLEMENTATION_MAX; impl++) {
+		GodotSATBatch3D::Implementation implementation = GodotSATBatch3D::Implementation(impl);
+		if (!GodotSATBatch3D::is_implementation_supported(implementation)) {
+			continue;
+		}
+		GodotSATBatch3D::set_implementation(implementation);
+
+		ContactCounter counter;
+		int collisions = 0;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_pair_count; i++) {
+			if (GodotCollisionSolver3D::solve_static(p_shape_A, transforms_A[i], p_shape_B, transforms_B[i], ContactCounter::callback, &counter)) {
+				collisions++;
+			}
+		}
+		if (p_benchmark) {
+			uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+			MESSAGE(vformat("%s, %s: %d pairs in %d usec (%.1f pairs/ms).", p_name, GodotSATBatch3D::get_implementation_name(implementation), p_pair_count, elapsed, p_pair_count * 1000.0 / elapsed));
+		}
+
+		if (reference_collisions == -1) {
+			reference_collisions = collisions;
+			reference_contacts = counter.contacts;
+		} else {
+			CHECK_MESSAGE(
+					collisions == reference_collisions,
+					vformat("%s with the %s implementation should find the same collisions as the scalar one.", p_name, GodotSATBatch3D::get_implementation_name(implementation)));
+			CHECK_MESSAGE(
+					counter.contacts == reference_contacts,
+					vformat("%s with the %s implementation should generate the same contacts as the scalar one.", p_name, GodotSATBatch3D::get_implementation_name(implementation)));
+		}
+	}
+
+	GodotSATBatch3D::set_implementation(initial_implementation);
+}
+
+TEST_CASE("[Physics3D][SAT] Box-box pairs agree between implementations") {
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+
+	check_pairs("Box-box", &box, &box, 1000);
+}
+
+static void make_random_convex(GodotConvexPolygonShape3D &r_convex) {
+	PackedVector3Array points;
+	RandomPCG rng(5678);
+	for (int i = 0; i < 64; i++) {
+		points.push_back(Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)).normalized() * 0.6);
+	}
+	r_convex.set_data(points);
+}
+
+TEST_CASE("[Physics3D][SAT] Convex-convex pairs agree between implementations") {
+	GodotConvexPolygonShape3D convex;
+	make_random_convex(convex);
+
+	check_pairs("Convex-convex", &convex, &convex, 200);
+}
+
+// Benchmarks are skipped by default, run them with `--test --no-skip --test-case="*[Benchmark]*"`.
+
+TEST_CASE("[Physics3D][SAT][Benchmark] Box-box throughput" * doctest::skip()) {
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+
+	check_pairs("Box-box", &box, &box, 20000, true);
+}
+
+TEST_CASE("[Physics3D][SAT][Benchmark] Convex-convex throughput" * doctest::skip()) {
+	GodotConvexPolygonShape3D convex;
+	make_random_convex(convex);
+
+	check_pairs("Convex-convex", &convex, &convex, 2000, true);
+}
+
+} // namespace TestPhysics3DSAT
+
+#endif // TEST_PHYSICS_3D_SAT_H
@@ -32,6 +32,7 @@
 
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
+#include "tests/core/io/test_file_read_queue.h"
 #include "tests/core/io/test_image.h"
 #include "tests/core/io/test_json.h"
 #include "tests/core/io/test_marshalls.h"
@@ -41,6 +42,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -54,11 +56,13 @@
 #include "tests/core/math/test_vector3.h"
 #include "tests/core/math/test_vector3i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/templates/test_command_queue.h"
 #include "tests/core/templates/test_hash_map.h"
@@ -77,11 +81,17 @@
 #include "tests/core/variant/test_variant.h"
 #include "tests/scene/test_animation.h"
 #include "tests/scene/test_code_edit.h"
+#include "tests/scene/test_compressed_texture_2d.h"
 #include "tests/scene/test_curve.h"
 #include "tests/scene/test_gradient.h"
 #include "tests/scene/test_path_3d.h"
+#include "tests/scene/test_process_thread_group.h"
+#include "tests/scene/test_residency_manager.h"
 #include "tests/scene/test_text_edit.h"
 #include "tests/scene/test_theme.h"
+#include "tests/servers/test_physics_2d.h"
+#include "tests/servers/test_physics_3d.h"
+#include "tests/servers/test_physics_3d_sat.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 